@@ -0,0 +1,103 @@
+#include <algorithm>
+
+#include "screen_graph/Mutator.h"
+#include "screen_graph/Node.h"
+
+#include "bwAnimator.h"
+
+namespace bWidgets {
+
+using namespace bwScreenGraph;
+
+static auto is_node_in_subtree(const Node& node, const Node& subtree_root) -> bool
+{
+  for (const Node* iter = &node; iter; iter = iter->Parent()) {
+    if (iter == &subtree_root) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto bwAnimator::ensureAnimation(const Node& node, const void* key) -> Animation&
+{
+  for (Animation& animation : animations) {
+    if ((animation.node == &node) && (animation.key == key)) {
+      return animation;
+    }
+  }
+
+  animations.push_back({&node, key});
+  return animations.back();
+}
+
+auto bwAnimator::isAnimating(const Node& node, const void* key) const -> bool
+{
+  return std::any_of(animations.begin(), animations.end(), [&](const Animation& animation) {
+    return (animation.node == &node) && (animation.key == key);
+  });
+}
+
+void bwAnimator::cancel(const Node& node, const void* key)
+{
+  animations.erase(std::remove_if(animations.begin(),
+                                  animations.end(),
+                                  [&](const Animation& animation) {
+                                    return (animation.node == &node) && (animation.key == key);
+                                  }),
+                   animations.end());
+}
+
+void bwAnimator::handleSubtreeRemoval(const Node& subtree_root)
+{
+  animations.erase(std::remove_if(animations.begin(),
+                                  animations.end(),
+                                  [&](const Animation& animation) {
+                                    return is_node_in_subtree(*animation.node, subtree_root);
+                                  }),
+                   animations.end());
+}
+
+/**
+ * \note The setters of the animations must not start or cancel animations.
+ */
+void bwAnimator::advanceTo(Clock::time_point frame_time)
+{
+  current_time = std::max(current_time, frame_time);
+
+  for (Animation& animation : animations) {
+    const Clock::duration elapsed = current_time - animation.start_time;
+    const float fac = (animation.duration.count() > 0) ?
+                          std::min(1.0f, float(elapsed.count()) / animation.duration.count()) :
+                          1.0f;
+
+    animation.apply(bwEase(animation.easing, fac));
+    /* Only the animated node needs to be redrawn, not the whole screen-graph. */
+    Mutator::requestRedraw(*animation.node);
+  }
+
+  animations.erase(std::remove_if(animations.begin(),
+                                  animations.end(),
+                                  [this](const Animation& animation) {
+                                    return (current_time - animation.start_time) >=
+                                           animation.duration;
+                                  }),
+                   animations.end());
+}
+
+auto bwAnimator::getTime() const -> Clock::time_point
+{
+  return current_time;
+}
+
+auto bwAnimator::isActive() const -> bool
+{
+  return !animations.empty();
+}
+
+auto bwAnimator::getAnimationCount() const -> unsigned int
+{
+  return animations.size();
+}
+
+}  // namespace bWidgets
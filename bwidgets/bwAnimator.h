@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "bwInlineFunction.h"
+#include "bwInterpolation.h"
+
+namespace bWidgets {
+
+namespace bwScreenGraph {
+class Node;
+}
+
+/**
+ * \brief Runs the animations of a screen-graph, all driven by a single clock.
+ *
+ * An animation interpolates a value (anything \ref bwInterpolate() supports, e.g. colors,
+ * rectangles or a scroll offset) over time and passes it to a setter. Animations belong to a
+ * node, only the nodes of running animations are redrawn on each step (see
+ * \ref bwScreenGraph::Mutator::requestRedraw()). They are cancelled when their node is removed.
+ *
+ * The application advances the clock once per frame with #advanceTo(), before handling events.
+ * While animations are running (#isActive()), it should keep producing frames. Once they finish,
+ * nothing needs to wake up the application anymore.
+ */
+class bwAnimator {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Animate from \a from to \a to in \a duration, calling \a setter with the interpolated value on
+   * each step. The setter is called with \a to on the last step.
+   *
+   * Replaces a running animation of \a node with the same \a key, which identifies the animated
+   * value (e.g. its address). Pass the current value as \a from to continue smoothly.
+   */
+  template<typename _Type, typename _Setter>
+  void animate(const bwScreenGraph::Node& node,
+               const void* key,
+               const _Type& from,
+               const _Type& to,
+               Clock::duration duration,
+               bwEasing easing,
+               _Setter&& setter)
+  {
+    Animation& animation = ensureAnimation(node, key);
+
+    animation.start_time = current_time;
+    animation.duration = duration;
+    animation.easing = easing;
+    animation.apply = [from, to, setter = std::forward<_Setter>(setter)](float fac) {
+      setter((fac >= 1.0f) ? to : bwInterpolate(from, to, fac));
+    };
+  }
+
+  auto isAnimating(const bwScreenGraph::Node& node, const void* key) const -> bool;
+  void cancel(const bwScreenGraph::Node& node, const void* key);
+  /** Cancel the animations of all nodes in the subtree of \a subtree_root. */
+  void handleSubtreeRemoval(const bwScreenGraph::Node& subtree_root);
+
+  /**
+   * Set the time of the current frame and apply the animated values at that time. Finished
+   * animations are removed. Animations started afterwards start at \a frame_time.
+   */
+  void advanceTo(Clock::time_point frame_time);
+  auto getTime() const -> Clock::time_point;
+
+  /** Animations are running, so the application should keep producing frames. */
+  auto isActive() const -> bool;
+  auto getAnimationCount() const -> unsigned int;
+
+ private:
+  struct Animation {
+    const bwScreenGraph::Node* node;
+    const void* key;
+    Clock::time_point start_time;
+    Clock::duration duration;
+    bwEasing easing;
+    /** Big enough for a setter capturing a pointer, plus two rectangles or colors. */
+    bwInlineFunction<void(float), 8 * sizeof(void*)> apply;
+  };
+
+  auto ensureAnimation(const bwScreenGraph::Node& node, const void* key) -> Animation&;
+
+  std::vector<Animation> animations;
+  Clock::time_point current_time{Clock::now()};
+};
+
+}  // namespace bWidgets
@@ -14,8 +14,12 @@ class bwEvent {
   void unswallow();
   auto isSwallowed() const -> bool;
 
-  /** Where did the event happen? */
-  const bwPoint location;
+  /**
+   * Where did the event happen? Event handlers receive this in the coordinate space of their
+   * node, which differs from the screen-graph root coordinates for children of scrolled
+   * containers (see \ref bwScreenGraph::Node::ContentOffset()).
+   */
+  bwPoint location;
 
  private:
   bool is_swallowed{false};
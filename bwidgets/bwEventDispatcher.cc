@@ -18,27 +18,71 @@ bwEventDispatcher::bwEventDispatcher(ScreenGraph& _screen_graph)
 
 template<typename... _Args> using HandlerFunc = void (bwScreenGraph::EventHandler::*)(_Args&&...);
 
-template<typename... _Args>
+/**
+ * Sum of the content offsets of all ancestors of \a node. Subtract it from a location in
+ * screen-graph root coordinates to get the location in the coordinate space of \a node.
+ */
+static auto accumulatedContentOffset(const Node& node) -> bwPoint
+{
+  bwPoint offset;
+
+  for (const Node* parent = node.Parent(); parent; parent = parent->Parent()) {
+    offset = offset + parent->ContentOffset();
+  }
+
+  return offset;
+}
+
+/**
+ * Send \a handler_event to the handlers of \a from_node and its ancestors, until \a event is
+ * swallowed. Each handler receives the event location in the coordinate space of its node.
+ * Listeners for \a event_type are called after the \a handler_func of the same handler.
+ *
+ * \param handler_func: May be null to only call the listeners.
+ */
+template<typename _EventType>
 static void bubbleEvent(const bwEvent& event,
-                        const Node& from_node,
-                        HandlerFunc<_Args&&...> handler_func,
-                        _Args&&... __args)
+                        Node& from_node,
+                        EventHandler::EventType event_type,
+                        HandlerFunc<_EventType> handler_func,
+                        _EventType handler_event)
 {
-  for (const Node* node = &from_node; node && !event.isSwallowed(); node = node->Parent()) {
+  const bwPoint root_location = handler_event.location;
+
+  handler_event.location = root_location - accumulatedContentOffset(from_node);
+
+  for (Node* node = &from_node; node && !event.isSwallowed(); node = node->Parent()) {
     if (EventHandler* handler = node->eventHandler()) {
-      (handler->*handler_func)(std::forward<_Args>(__args)...);
+      if (handler_func) {
+        (handler->*handler_func)(handler_event);
+      }
+      if (handler->hasEventListeners() && !event.isSwallowed()) {
+        handler->callEventListeners(event_type, *node, handler_event);
+      }
+    }
+    if (const Node* parent = node->Parent()) {
+      handler_event.location = handler_event.location + parent->ContentOffset();
     }
   }
+
+  handler_event.location = root_location;
 }
 
-static auto findHoveredNode(const bwEvent& event, Node& node) -> Node*
+/**
+ * \param location: The location in the coordinate space of \a node.
+ */
+static auto findHoveredNode(const bwPoint& location, Node& node) -> Node*
 {
-  const bool is_hovered = node.isVisible() &&
-                          node.Rectangle().isCoordinateInside(event.location.x, event.location.y);
+  /* Like for drawing, nodes with an empty rectangle aren't placed (e.g. unused list view rows).
+   * The inclusive check would still find the coordinate they are collapsed to inside. */
+  const bool is_hovered = node.isVisible() && !node.Rectangle().isEmpty() &&
+                          node.Rectangle().isCoordinateInside(location.x, location.y);
 
   if (is_hovered && node.Children() && node.childrenVisible()) {
+    const bwPoint children_location = location - node.ContentOffset();
+
     for (auto& iter_child : *node.Children()) {
-      if (Node* found_child = findHoveredNode(event, *iter_child)) {
+      if (Node* found_child = findHoveredNode(children_location, *iter_child)) {
         return found_child;
       }
     }
@@ -55,15 +99,19 @@ void bwEventDispatcher::dispatchMouseMovement(bwEvent event)
 
   if (Node* active = context.active) {
     if (isDragging()) {
-      bubbleEvent<bwMouseButtonDragEvent&>(
-          event, *active, &EventHandler::onMouseDrag, drag_event.value());
+      bubbleEvent<bwMouseButtonDragEvent&>(event,
+                                           *active,
+                                           EventHandler::MOUSE_DRAG,
+                                           &EventHandler::onMouseDrag,
+                                           drag_event.value());
     }
   }
   else {
-    Node* new_hovered = findHoveredNode(event, screen_graph.Root());
+    Node* new_hovered = findHoveredNode(event.location, screen_graph.Root());
 
     if (new_hovered && (new_hovered == context.hovered)) {
-      bubbleEvent<bwEvent&>(event, *new_hovered, &EventHandler::onMouseMove, event);
+      bubbleEvent<bwEvent&>(
+          event, *new_hovered, EventHandler::MOUSE_MOVE, &EventHandler::onMouseMove, event);
     }
     changeContextHovered(new_hovered, event);
   }
@@ -71,10 +119,12 @@ void bwEventDispatcher::dispatchMouseMovement(bwEvent event)
 
 void bwEventDispatcher::dispatchMouseButtonPress(bwMouseButtonEvent& event)
 {
-  Node* node = context.active ? context.active : findHoveredNode(event, screen_graph.Root());
+  Node* node = context.active ? context.active :
+                                findHoveredNode(event.location, screen_graph.Root());
 
   if (node) {
-    bubbleEvent<bwMouseButtonEvent&>(event, *node, &EventHandler::onMousePress, event);
+    bubbleEvent<bwMouseButtonEvent&>(
+        event, *node, EventHandler::MOUSE_PRESS, &EventHandler::onMousePress, event);
   }
   drag_event.emplace(event.button, event.location);
 
@@ -86,14 +136,22 @@ void bwEventDispatcher::dispatchMouseButtonPress(bwMouseButtonEvent& event)
 void bwEventDispatcher::dispatchMouseButtonRelease(bwMouseButtonEvent& event)
 {
   if (context.active) {
-    bubbleEvent<bwMouseButtonEvent&>(event, *context.active, &EventHandler::onMouseRelease, event);
+    bubbleEvent<bwMouseButtonEvent&>(event,
+                                     *context.active,
+                                     EventHandler::MOUSE_RELEASE,
+                                     &EventHandler::onMouseRelease,
+                                     event);
 
     if (!isDragging()) {
       /* Even if the drag event was already sent, we may also need to send the click event, so
        * unswallow it for that purpose. */
       event.unswallow();
 
-      bubbleEvent<bwMouseButtonEvent&>(event, *context.active, &EventHandler::onMouseClick, event);
+      bubbleEvent<bwMouseButtonEvent&>(event,
+                                       *context.active,
+                                       EventHandler::MOUSE_CLICK,
+                                       &EventHandler::onMouseClick,
+                                       event);
     }
   }
 
@@ -104,7 +162,42 @@ void bwEventDispatcher::dispatchMouseButtonRelease(bwMouseButtonEvent& event)
 void bwEventDispatcher::dispatchMouseWheelScroll(bwMouseWheelEvent& event)
 {
   if (context.hovered) {
-    bubbleEvent<bwMouseWheelEvent&>(event, *context.hovered, &EventHandler::onMouseWheel, event);
+    bubbleEvent<bwMouseWheelEvent&>(
+        event, *context.hovered, EventHandler::MOUSE_WHEEL, &EventHandler::onMouseWheel, event);
+  }
+}
+
+void bwEventDispatcher::emitEvent(EventHandler::EventType event_type,
+                                  Node& from_node,
+                                  bwEvent& event)
+{
+  bubbleEvent<bwEvent&>(event, from_node, event_type, nullptr, event);
+}
+
+static auto is_node_in_subtree(const Node* node, const Node& subtree_root) -> bool
+{
+  for (; node; node = node->Parent()) {
+    if (node == &subtree_root) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Ensure the context doesn't reference \a subtree_root or any of its descendants anymore. Must be
+ * called before the subtree is unlinked from the screen-graph.
+ */
+void bwEventDispatcher::handleSubtreeRemoval(const Node& subtree_root)
+{
+  if (is_node_in_subtree(context.hovered, subtree_root)) {
+    /* The parent is still under the cursor, keep it hovered so that it receives the
+     * onMouseLeave() once the cursor leaves it. */
+    context.hovered = subtree_root.Parent();
+  }
+  if (is_node_in_subtree(context.active, subtree_root)) {
+    context.active = nullptr;
+    drag_event = std::nullopt;
   }
 }
 
@@ -126,11 +219,13 @@ void bwEventDispatcher::changeContextHovered(Node* new_hovered, bwEvent& event)
   }
 
   if (old_hovered) {
-    bubbleEvent<bwEvent&>(event, *old_hovered, &EventHandler::onMouseLeave, event);
+    bubbleEvent<bwEvent&>(
+        event, *old_hovered, EventHandler::MOUSE_LEAVE, &EventHandler::onMouseLeave, event);
   }
 
   if (new_hovered) {
-    bubbleEvent<bwEvent&>(event, *new_hovered, &EventHandler::onMouseEnter, event);
+    bubbleEvent<bwEvent&>(
+        event, *new_hovered, EventHandler::MOUSE_ENTER, &EventHandler::onMouseEnter, event);
   }
 
   context.hovered = new_hovered;
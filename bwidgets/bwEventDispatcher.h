@@ -5,6 +5,8 @@
 #include "bwEvent.h"
 #include "bwPoint.h"
 
+#include "screen_graph/EventHandler.h"
+
 namespace bWidgets {
 
 struct bwContext;
@@ -29,6 +31,16 @@ class bwEventDispatcher {
   void dispatchMouseButtonPress(bwMouseButtonEvent&);
   void dispatchMouseButtonRelease(bwMouseButtonEvent&);
   void dispatchMouseWheelScroll(bwMouseWheelEvent&);
+  /**
+   * Send an event of a custom type (see \ref bwScreenGraph::EventHandler::registerEventType())
+   * to the listeners of \a from_node and its ancestors. \a event's location is expected in
+   * screen-graph root coordinates.
+   */
+  void emitEvent(bwScreenGraph::EventHandler::EventType event_type,
+                 bwScreenGraph::Node& from_node,
+                 bwEvent& event);
+
+  void handleSubtreeRemoval(const bwScreenGraph::Node& subtree_root);
 
  private:
   auto isDragging() -> bool;
@@ -0,0 +1,170 @@
+#include <iterator>
+#include <numeric>
+
+#include "bwEventDispatcher.h"
+#include "bwEventRecording.h"
+
+#include "bwEventQueue.h"
+
+namespace bWidgets {
+
+auto bwEventQueue::Statistics::totalRawCount() const -> unsigned int
+{
+  return std::accumulate(std::begin(raw_count), std::end(raw_count), 0u);
+}
+
+auto bwEventQueue::Statistics::totalDispatchedCount() const -> unsigned int
+{
+  return std::accumulate(std::begin(dispatched_count), std::end(dispatched_count), 0u);
+}
+
+bwEventQueue::bwEventQueue(bwEventDispatcher& dispatcher) : dispatcher(dispatcher)
+{
+}
+
+void bwEventQueue::pushMouseMovement(const bwPoint& location)
+{
+  QueuedEvent event{EventType::MOUSE_MOVE};
+  event.location = location;
+  push(event);
+}
+
+void bwEventQueue::pushMouseButtonPress(bwMouseButtonEvent::Button button,
+                                        const bwPoint& location)
+{
+  QueuedEvent event{EventType::MOUSE_BUTTON_PRESS};
+  event.location = location;
+  event.button = button;
+  push(event);
+}
+
+void bwEventQueue::pushMouseButtonRelease(bwMouseButtonEvent::Button button,
+                                          const bwPoint& location)
+{
+  QueuedEvent event{EventType::MOUSE_BUTTON_RELEASE};
+  event.location = location;
+  event.button = button;
+  push(event);
+}
+
+void bwEventQueue::pushMouseWheel(bwMouseWheelEvent::Direction direction, const bwPoint& location)
+{
+  QueuedEvent event{EventType::MOUSE_WHEEL};
+  event.location = location;
+  event.button = bwMouseButtonEvent::Button::WHEEL;
+  event.direction = direction;
+  push(event);
+}
+
+void bwEventQueue::pushResize(int width, int height)
+{
+  QueuedEvent event{EventType::RESIZE};
+  event.width = width;
+  event.height = height;
+  push(event);
+}
+
+/**
+ * Events that only matter in their latest state, as long as no other events come in between.
+ */
+auto bwEventQueue::isCoalescable(EventType type) -> bool
+{
+  return (type == EventType::MOUSE_MOVE) || (type == EventType::RESIZE);
+}
+
+void bwEventQueue::push(const QueuedEvent& event)
+{
+  statistics.raw_count[int(event.type)]++;
+  if (recorder) {
+    recorder->recordEvent(event);
+  }
+
+  if (isCoalescable(event.type)) {
+    /* Replace an earlier event of the same type, unless a non-coalescable event comes after it
+     * (e.g. a movement before a button press is kept, so the press happens at the right
+     * location). There can only be one coalescable event of each type at the end of the queue,
+     * so this doesn't search far. */
+    for (auto iter = events.rbegin(); (iter != events.rend()) && isCoalescable(iter->type);
+         ++iter) {
+      if (iter->type == event.type) {
+        events.erase(std::next(iter).base());
+        break;
+      }
+    }
+  }
+
+  events.push_back(event);
+}
+
+/**
+ * Send all queued events to the dispatcher, in the order they were pushed.
+ */
+void bwEventQueue::flush()
+{
+  if (recorder) {
+    recorder->recordFlush();
+  }
+
+  /* Handlers may push new events (e.g. through a nested event loop), these are dispatched with
+   * the next flush. */
+  std::vector<QueuedEvent> flushed_events;
+  std::swap(flushed_events, events);
+
+  for (const QueuedEvent& event : flushed_events) {
+    dispatch(event);
+    statistics.dispatched_count[int(event.type)]++;
+  }
+}
+
+void bwEventQueue::dispatch(const QueuedEvent& event)
+{
+  switch (event.type) {
+    case EventType::MOUSE_MOVE:
+      dispatcher.dispatchMouseMovement(bwEvent(event.location));
+      break;
+    case EventType::MOUSE_BUTTON_PRESS: {
+      bwMouseButtonEvent button_event(event.button, event.location);
+      dispatcher.dispatchMouseButtonPress(button_event);
+      break;
+    }
+    case EventType::MOUSE_BUTTON_RELEASE: {
+      bwMouseButtonEvent button_event(event.button, event.location);
+      dispatcher.dispatchMouseButtonRelease(button_event);
+      break;
+    }
+    case EventType::MOUSE_WHEEL: {
+      bwMouseWheelEvent wheel_event(event.direction, event.location);
+      dispatcher.dispatchMouseWheelScroll(wheel_event);
+      break;
+    }
+    case EventType::RESIZE:
+      if (resize_handler) {
+        resize_handler(event.width, event.height);
+      }
+      break;
+    case EventType::EVENT_TYPE_TOT:
+      break;
+  }
+}
+
+auto bwEventQueue::isEmpty() const -> bool
+{
+  return events.empty();
+}
+
+auto bwEventQueue::getStatistics() const -> const Statistics&
+{
+  return statistics;
+}
+
+void bwEventQueue::resetStatistics()
+{
+  statistics = {};
+}
+
+void bwEventQueue::setRecorder(bwEventRecorder* _recorder)
+{
+  recorder = _recorder;
+}
+
+}  // namespace bWidgets
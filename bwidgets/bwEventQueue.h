@@ -0,0 +1,92 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "bwEvent.h"
+#include "bwPoint.h"
+
+namespace bWidgets {
+
+class bwEventDispatcher;
+class bwEventRecorder;
+
+/**
+ * \brief Buffers input events between the platform and the \ref bwEventDispatcher, to send them
+ * once per frame.
+ *
+ * Input devices may report mouse movements much more often than the application redraws (e.g.
+ * 1000 Hz mice). Each movement means a hit-test and possibly hover changes, which are wasted if
+ * nobody sees the intermediate state. So consecutive movements are collapsed into the last one,
+ * same for resizes. Button and wheel events are never collapsed or reordered: a movement queued
+ * before a button press is still dispatched before it, so the press happens with the correct node
+ * hovered.
+ *
+ * Platform callbacks push events, the application calls #flush() once per frame before drawing.
+ * A \ref bwEventRecorder can be attached to record all pushed events, for replaying them later.
+ */
+class bwEventQueue {
+ public:
+  enum class EventType {
+    MOUSE_MOVE,
+    MOUSE_BUTTON_PRESS,
+    MOUSE_BUTTON_RELEASE,
+    MOUSE_WHEEL,
+    RESIZE,
+
+    EVENT_TYPE_TOT
+  };
+
+  /** Counts of events pushed to the queue, and of events actually dispatched. */
+  struct Statistics {
+    unsigned int raw_count[int(EventType::EVENT_TYPE_TOT)]{};
+    unsigned int dispatched_count[int(EventType::EVENT_TYPE_TOT)]{};
+
+    auto totalRawCount() const -> unsigned int;
+    auto totalDispatchedCount() const -> unsigned int;
+  };
+
+  struct QueuedEvent {
+    EventType type;
+    bwPoint location{};
+    bwMouseButtonEvent::Button button{bwMouseButtonEvent::Button::UNKNOWN};
+    bwMouseWheelEvent::Direction direction{bwMouseWheelEvent::Direction::UP};
+    int width{0}, height{0};
+  };
+
+  explicit bwEventQueue(bwEventDispatcher& dispatcher);
+
+  void push(const QueuedEvent& event);
+  void pushMouseMovement(const bwPoint& location);
+  void pushMouseButtonPress(bwMouseButtonEvent::Button button, const bwPoint& location);
+  void pushMouseButtonRelease(bwMouseButtonEvent::Button button, const bwPoint& location);
+  void pushMouseWheel(bwMouseWheelEvent::Direction direction, const bwPoint& location);
+  void pushResize(int width, int height);
+
+  void flush();
+
+  auto isEmpty() const -> bool;
+  auto getStatistics() const -> const Statistics&;
+  void resetStatistics();
+
+  /** Pass all pushed events and flushes to \a recorder, until called again with null. */
+  void setRecorder(bwEventRecorder* recorder);
+
+  /**
+   * Called for resizes of the region the screen-graph is displayed in. bWidgets itself doesn't
+   * know about this region, so it's up to the application to handle it.
+   */
+  std::function<void(int width, int height)> resize_handler;
+
+ private:
+  static auto isCoalescable(EventType type) -> bool;
+
+  void dispatch(const QueuedEvent& event);
+
+  bwEventDispatcher& dispatcher;
+  std::vector<QueuedEvent> events;
+  Statistics statistics;
+  bwEventRecorder* recorder{nullptr};
+};
+
+}  // namespace bWidgets
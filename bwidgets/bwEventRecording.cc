@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+#include "bwEventRecording.h"
+
+namespace bWidgets {
+
+namespace {
+
+constexpr char MAGIC[4] = {'b', 'W', 'R', 'C'};
+constexpr std::uint8_t VERSION = 1;
+/** Record type of flushes, event records use their \ref bwEventQueue::EventType. */
+constexpr std::uint8_t FLUSH_RECORD = 0xFF;
+
+using EventType = bwEventQueue::EventType;
+
+/* All values are written byte-wise in little endian order, so recordings are portable. */
+
+void writeByte(std::ostream& stream, std::uint8_t value)
+{
+  stream.put(char(value));
+}
+
+/** Unsigned LEB128: 7 bits per byte, small values (like most time deltas) take a single byte. */
+void writeVarint(std::ostream& stream, std::uint64_t value)
+{
+  while (value >= 0x80) {
+    writeByte(stream, std::uint8_t(value | 0x80));
+    value >>= 7;
+  }
+  writeByte(stream, std::uint8_t(value));
+}
+
+void writeFloat(std::ostream& stream, float value)
+{
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 4; i++) {
+    writeByte(stream, std::uint8_t(bits >> (i * 8)));
+  }
+}
+
+auto readByte(std::istream& stream) -> std::optional<std::uint8_t>
+{
+  const int value = stream.get();
+  if (value == std::istream::traits_type::eof()) {
+    return std::nullopt;
+  }
+  return std::uint8_t(value);
+}
+
+auto readVarint(std::istream& stream) -> std::optional<std::uint64_t>
+{
+  std::uint64_t value = 0;
+
+  for (int shift = 0; shift < 64; shift += 7) {
+    const std::optional<std::uint8_t> byte = readByte(stream);
+    if (!byte) {
+      return std::nullopt;
+    }
+    value |= std::uint64_t(*byte & 0x7F) << shift;
+    if (!(*byte & 0x80)) {
+      return value;
+    }
+  }
+
+  return std::nullopt;
+}
+
+auto readFloat(std::istream& stream) -> std::optional<float>
+{
+  std::uint32_t bits = 0;
+
+  for (int i = 0; i < 4; i++) {
+    const std::optional<std::uint8_t> byte = readByte(stream);
+    if (!byte) {
+      return std::nullopt;
+    }
+    bits |= std::uint32_t(*byte) << (i * 8);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+auto readLocation(std::istream& stream) -> std::optional<bwPoint>
+{
+  const std::optional<float> x = readFloat(stream);
+  const std::optional<float> y = readFloat(stream);
+  if (!x || !y) {
+    return std::nullopt;
+  }
+  return bwPoint{*x, *y};
+}
+
+/**
+ * Read the data following the record start of an event record of type \a type.
+ */
+auto readEvent(std::istream& stream, EventType type) -> std::optional<bwEventQueue::QueuedEvent>
+{
+  bwEventQueue::QueuedEvent event{type};
+
+  switch (type) {
+    case EventType::MOUSE_BUTTON_PRESS:
+    case EventType::MOUSE_BUTTON_RELEASE: {
+      const std::optional<std::uint8_t> button = readByte(stream);
+      if (!button || (*button > std::uint8_t(bwMouseButtonEvent::Button::UNKNOWN))) {
+        return std::nullopt;
+      }
+      event.button = bwMouseButtonEvent::Button(*button);
+      break;
+    }
+    case EventType::MOUSE_WHEEL: {
+      const std::optional<std::uint8_t> direction = readByte(stream);
+      if (!direction || (*direction > std::uint8_t(bwMouseWheelEvent::Direction::DOWN))) {
+        return std::nullopt;
+      }
+      event.button = bwMouseButtonEvent::Button::WHEEL;
+      event.direction = bwMouseWheelEvent::Direction(*direction);
+      break;
+    }
+    case EventType::RESIZE: {
+      const std::optional<std::uint64_t> width = readVarint(stream);
+      const std::optional<std::uint64_t> height = readVarint(stream);
+      if (!width || !height) {
+        return std::nullopt;
+      }
+      event.width = int(*width);
+      event.height = int(*height);
+      /* No location. */
+      return event;
+    }
+    case EventType::MOUSE_MOVE:
+      break;
+    case EventType::EVENT_TYPE_TOT:
+      return std::nullopt;
+  }
+
+  const std::optional<bwPoint> location = readLocation(stream);
+  if (!location) {
+    return std::nullopt;
+  }
+  event.location = *location;
+
+  return event;
+}
+
+}  // namespace
+
+auto bwEventRecording::read(std::istream& stream) -> std::optional<bwEventRecording>
+{
+  char magic[sizeof(MAGIC)];
+  if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+    return std::nullopt;
+  }
+  if (readByte(stream) != VERSION) {
+    return std::nullopt;
+  }
+
+  bwEventRecording recording;
+  Frame frame;
+  std::chrono::microseconds time{0};
+
+  while (const std::optional<std::uint8_t> record_type = readByte(stream)) {
+    const std::optional<std::uint64_t> time_delta = readVarint(stream);
+    if (!time_delta) {
+      return std::nullopt;
+    }
+    time += std::chrono::microseconds(*time_delta);
+
+    if (*record_type == FLUSH_RECORD) {
+      frame.flush_time = time;
+      recording.frames.push_back(std::move(frame));
+      frame = {};
+      continue;
+    }
+
+    if (*record_type >= std::uint8_t(EventType::EVENT_TYPE_TOT)) {
+      return std::nullopt;
+    }
+    const std::optional<bwEventQueue::QueuedEvent> event = readEvent(stream,
+                                                                     EventType(*record_type));
+    if (!event) {
+      return std::nullopt;
+    }
+    frame.events.push_back({time, *event});
+  }
+
+  return recording;
+}
+
+void bwEventRecording::replayFrame(const Frame& frame, bwEventQueue& queue)
+{
+  for (const RecordedEvent& recorded : frame.events) {
+    queue.push(recorded.event);
+  }
+  queue.flush();
+}
+
+bwEventRecorder::bwEventRecorder(std::ostream& stream)
+    : stream(stream), start_time(std::chrono::steady_clock::now())
+{
+  stream.write(MAGIC, sizeof(MAGIC));
+  writeByte(stream, VERSION);
+}
+
+void bwEventRecorder::writeRecordStart(std::uint8_t record_type)
+{
+  const auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  writeByte(stream, record_type);
+  writeVarint(stream, std::uint64_t((time - last_record_time).count()));
+  last_record_time = time;
+}
+
+void bwEventRecorder::recordEvent(const bwEventQueue::QueuedEvent& event)
+{
+  writeRecordStart(std::uint8_t(event.type));
+
+  switch (event.type) {
+    case EventType::MOUSE_BUTTON_PRESS:
+    case EventType::MOUSE_BUTTON_RELEASE:
+      writeByte(stream, std::uint8_t(event.button));
+      break;
+    case EventType::MOUSE_WHEEL:
+      writeByte(stream, std::uint8_t(event.direction));
+      break;
+    case EventType::RESIZE:
+      writeVarint(stream, std::uint64_t(std::max(event.width, 0)));
+      writeVarint(stream, std::uint64_t(std::max(event.height, 0)));
+      /* No location. */
+      return;
+    case EventType::MOUSE_MOVE:
+    case EventType::EVENT_TYPE_TOT:
+      break;
+  }
+
+  writeFloat(stream, event.location.x);
+  writeFloat(stream, event.location.y);
+}
+
+void bwEventRecorder::recordFlush()
+{
+  writeRecordStart(FLUSH_RECORD);
+}
+
+}  // namespace bWidgets
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+#include "bwEventQueue.h"
+
+namespace bWidgets {
+
+/**
+ * \brief Input events as pushed to a \ref bwEventQueue, grouped into the frames they were
+ * flushed in.
+ *
+ * Replaying a recording pushes the same events into a queue and flushes it at the same points,
+ * so event handling happens exactly like during recording (including coalescing). Useful to
+ * reproduce problems that only happen during real interaction, e.g. for benchmarking.
+ *
+ * Stored in a compact binary format: a header, followed by one record per event or flush. Each
+ * record starts with its type and the time since the previous record, then the event data.
+ */
+class bwEventRecording {
+ public:
+  struct RecordedEvent {
+    /** Time since the start of the recording. */
+    std::chrono::microseconds time;
+    bwEventQueue::QueuedEvent event;
+  };
+
+  struct Frame {
+    std::vector<RecordedEvent> events;
+    /** Time since the start of the recording at which the events were flushed. */
+    std::chrono::microseconds flush_time;
+  };
+
+  /**
+   * \return The recording, or nothing if \a stream doesn't contain a valid recording. Events
+   *         after the last flush are ignored.
+   */
+  static auto read(std::istream& stream) -> std::optional<bwEventRecording>;
+
+  /** Push the events of \a frame into \a queue and flush it. */
+  static void replayFrame(const Frame& frame, bwEventQueue& queue);
+
+  std::vector<Frame> frames;
+};
+
+/**
+ * \brief Writes the events pushed to a \ref bwEventQueue to a stream, see \ref bwEventRecording.
+ *
+ * Attach with \ref bwEventQueue::setRecorder().
+ */
+class bwEventRecorder {
+ public:
+  /** Writes the header to \a stream right away. */
+  explicit bwEventRecorder(std::ostream& stream);
+
+  void recordEvent(const bwEventQueue::QueuedEvent& event);
+  void recordFlush();
+
+ private:
+  void writeRecordStart(std::uint8_t record_type);
+
+  std::ostream& stream;
+  std::chrono::steady_clock::time_point start_time;
+  std::chrono::microseconds last_record_time{0};
+};
+
+}  // namespace bWidgets
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cassert>
+
+#include "bwFrameScheduler.h"
+
+namespace bWidgets {
+
+bwFrameScheduler::bwFrameScheduler(float target_frame_rate)
+{
+  setTargetFrameRate(target_frame_rate);
+}
+
+void bwFrameScheduler::requestFrame()
+{
+  /* The frame interval still applies, see #getNextFrameTime(). */
+  requestFrameAt(Clock::time_point::min());
+}
+
+void bwFrameScheduler::requestFrameAt(Clock::time_point time)
+{
+  requested_time = requested_time ? std::min(*requested_time, time) : time;
+}
+
+auto bwFrameScheduler::isIdle() const -> bool
+{
+  return !requested_time;
+}
+
+auto bwFrameScheduler::getNextFrameTime() const -> std::optional<Clock::time_point>
+{
+  if (!requested_time) {
+    return std::nullopt;
+  }
+  if (!last_frame_time) {
+    return requested_time;
+  }
+  return std::max(*requested_time, *last_frame_time + frame_interval);
+}
+
+auto bwFrameScheduler::beginFrame(Clock::time_point now) -> bool
+{
+  const std::optional<Clock::time_point> next_frame_time = getNextFrameTime();
+  if (!next_frame_time || (now < *next_frame_time)) {
+    return false;
+  }
+
+  requested_time = std::nullopt;
+  last_frame_time = now;
+  frame_count++;
+
+  return true;
+}
+
+void bwFrameScheduler::endFrame(bool needs_next_frame)
+{
+  if (needs_next_frame) {
+    /* Paced to the frame rate, so due one interval after the frame just produced. */
+    requestFrame();
+  }
+}
+
+void bwFrameScheduler::setTargetFrameRate(float frame_rate)
+{
+  assert(frame_rate > 0.0f);
+  frame_interval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<float>(1.0f / frame_rate));
+}
+
+auto bwFrameScheduler::getFrameInterval() const -> Clock::duration
+{
+  return frame_interval;
+}
+
+auto bwFrameScheduler::getFrameCount() const -> unsigned long
+{
+  return frame_count;
+}
+
+}  // namespace bWidgets
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace bWidgets {
+
+/**
+ * \brief Decides when the application should produce a frame (handle queued events, layout and
+ * draw).
+ *
+ * Frames are only produced on request, e.g. because input events were queued, a widget requested
+ * a redraw (see \ref bwScreenGraph::ScreenGraph::needsRedraw()) or an animation needs its next
+ * step. Requests are paced to the target frame rate: multiple requests within one frame interval
+ * result in a single frame. Without any request the scheduler is idle, so the application can
+ * sleep until the next platform event, rather than drawing in a loop.
+ *
+ * The scheduler doesn't wait itself, the application's event loop waits until
+ * #getNextFrameTime(), calls #beginFrame() and after producing the frame #endFrame(). Not
+ * thread-safe, use it from the thread producing the frames only.
+ */
+class bwFrameScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit bwFrameScheduler(float target_frame_rate = 60.0f);
+
+  /** Request a frame as soon as the frame rate allows. */
+  void requestFrame();
+  /** Request a frame at \a time, or as soon after it as the frame rate allows. E.g. for timers
+   * or the next step of an animation. */
+  void requestFrameAt(Clock::time_point time);
+
+  /** Nothing requested, the application can wait for platform events indefinitely. */
+  auto isIdle() const -> bool;
+  /** \return The time the next frame is due, or nothing if idle. */
+  auto getNextFrameTime() const -> std::optional<Clock::time_point>;
+  /**
+   * Check if a frame is due at \a now. If so, the pending request is consumed (further changes
+   * need a new request) and the frame is counted.
+   * \return True if the application should produce a frame now.
+   */
+  auto beginFrame(Clock::time_point now = Clock::now()) -> bool;
+  /**
+   * Call after producing a frame. #beginFrame() consumed the pending request, so if something
+   * still needs frames (e.g. an animation is running), the next one is requested here, one frame
+   * interval after this one. Otherwise the application would sleep until the next platform event.
+   */
+  void endFrame(bool needs_next_frame);
+
+  void setTargetFrameRate(float frame_rate);
+  auto getFrameInterval() const -> Clock::duration;
+  /** Number of frames produced so far (i.e. successful #beginFrame() calls). */
+  auto getFrameCount() const -> unsigned long;
+
+ private:
+  Clock::duration frame_interval;
+  /** The earliest time a frame was requested for. */
+  std::optional<Clock::time_point> requested_time;
+  std::optional<Clock::time_point> last_frame_time;
+  unsigned long frame_count{0};
+};
+
+}  // namespace bWidgets
@@ -9,6 +9,28 @@ class bwLayoutInterface {
   virtual ~bwLayoutInterface() = default;
 
   virtual auto getRectangle() -> bwRectanglePixel = 0;
+
+  /**
+   * Tag the layout as needing to be recalculated. bWidgets itself only sets this flag (e.g. when
+   * children are added or removed), it's up to the layout implementation to check it and to clear
+   * it once the layout was recalculated.
+   */
+  void markDirty()
+  {
+    is_dirty = true;
+  }
+  void clearDirty()
+  {
+    is_dirty = false;
+  }
+  auto isDirty() const -> bool
+  {
+    return is_dirty;
+  }
+
+ private:
+  /** Layouts are created dirty, they were never calculated. */
+  bool is_dirty{true};
 };
 
 }  // namespace bWidgets
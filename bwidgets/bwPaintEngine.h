@@ -2,6 +2,7 @@
 
 #include <string>
 
+#include "bwPoint.h"
 #include "bwRectangle.h"
 
 namespace bWidgets {
@@ -44,8 +45,33 @@ class bwPaintEngine {
    */
   virtual void setupViewport(const bwRectanglePixel& rect, const class bwColor& clear_color) = 0;
 
+  /**
+   * Mask all following drawing to \a rect. Other than the drawing functions, this is not affected
+   * by #translate(), \a rect is always in untranslated coordinates.
+   */
   virtual void enableMask(const bwRectanglePixel& rect) = 0;
 
+  /**
+   * Move all following drawing by \a offset, in addition to previous translations. Call again
+   * with the negated \a offset to undo.
+   *
+   * Used for scrolling: contents are drawn with an offset, so the layout doesn't have to be
+   * recalculated to move them.
+   *
+   * By default, this only accumulates the offsets. The drawing functions are expected to apply
+   * #getTranslation() to what they draw. Engines can also override this to apply the offset
+   * differently, e.g. to a transformation matrix.
+   */
+  virtual void translate(const bwPoint& offset)
+  {
+    translation = translation + offset;
+  }
+  /** Sum of the offsets passed to #translate() so far. */
+  auto getTranslation() const -> const bwPoint&
+  {
+    return translation;
+  }
+
   /**
    * The main polygon draw function which is used to draw all geometry of
    * widgets.
@@ -72,6 +98,9 @@ class bwPaintEngine {
   virtual void drawIcon(const class bwPainter& painter,
                         const class bwIconInterface& icon_interface,
                         const bwRectanglePixel& rect) = 0;
+
+ private:
+  bwPoint translation;
 };
 
 }  // namespace bWidgets
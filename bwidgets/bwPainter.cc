@@ -3,6 +3,7 @@
 #include <cmath>
 #include <iostream>
 
+#include "bwColorBatch.h"
 #include "bwPaintEngine.h"
 #include "bwPoint.h"
 #include "bwPolygon.h"
@@ -433,19 +434,38 @@ void bwPainter::fillVertexColorsWithGradient(const bwPolygon& polygon,
                                              const bwRectanglePixel& bounding_box)
 {
   const bwPointVec& vertices = polygon.getVertices();
-  const bool is_single_color = active_gradient->begin == active_gradient->end;
 
   assert(isGradientEnabled());
 
-  vert_colors.reserve(vertices.size());
-  for (const bwPoint& vertex : vertices) {
-    const bwColor& col = is_single_color ? active_gradient->begin :
-                                           active_gradient->calcPointColor(vertex, bounding_box);
+  if (active_gradient->isSingleColor()) {
+    vert_colors.assign(vertices.size(), active_gradient->calcColorAt(0.0f));
+    return;
+  }
 
-    vert_colors.push_back(col);
+  /* Positions along the gradient first, then the colors there from the lookup table, so the
+   * cost per vertex doesn't depend on the number of stops. */
+  vert_gradient_positions.resize(vertices.size());
+  active_gradient->calcPointPositions(
+      vertices.data(), vertices.size(), bounding_box, vert_gradient_positions.data());
+  vert_colors.resize(vertices.size());
+
+  /* What the widgets use: a single interpolation, exact and not worth building the table for. */
+  if ((active_gradient->getStopCount() == 2) && (active_gradient->getStop(0).position == 0.0f) &&
+      (active_gradient->getStop(1).position == 1.0f)) {
+    bwColorsInterpolate(active_gradient->getStop(0).color,
+                        active_gradient->getStop(1).color,
+                        vert_gradient_positions.data(),
+                        vertices.size(),
+                        vert_colors.data());
+    return;
   }
 
-  assert(vert_colors.size() == vertices.size());
+  const bwGradient::LUT& lut = active_gradient->getLUT();
+  bwColorsSampleLUT(lut.data(),
+                    lut.size(),
+                    vert_gradient_positions.data(),
+                    vertices.size(),
+                    vert_colors.data());
 }
 
 void bwPainter::drawRoundboxWidgetBase(const bwWidgetBaseStyle& base_style,
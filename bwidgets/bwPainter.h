@@ -92,6 +92,8 @@ class bwPainter {
 
   bwColor active_color;
   std::vector<bwColor> vert_colors;
+  /** Position of each vertex along the active gradient, kept to reuse the memory. */
+  std::vector<float> vert_gradient_positions;
   std::unique_ptr<bwGradient> active_gradient;
   bwRectanglePixel content_mask;
 };
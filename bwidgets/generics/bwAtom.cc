@@ -0,0 +1,73 @@
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "bwAtom.h"
+
+namespace bWidgets {
+
+/**
+ * Global table of interned strings. Entries are allocated individually and never freed, so atoms
+ * (and the string views they return) stay valid while the table grows. The empty string has no
+ * entry, but index 0.
+ */
+class bwAtomTable {
+ public:
+  using Entry = bwAtom::Entry;
+
+  static auto get() -> bwAtomTable&
+  {
+    static bwAtomTable table;
+    return table;
+  }
+
+  auto intern(std::string_view string) -> const Entry*
+  {
+    if (string.empty()) {
+      return nullptr;
+    }
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex);
+      if (const auto iter = entries_by_string.find(string); iter != entries_by_string.end()) {
+        return iter->second;
+      }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    /* Might have been added while not locked. */
+    if (const auto iter = entries_by_string.find(string); iter != entries_by_string.end()) {
+      return iter->second;
+    }
+    entries.push_back(
+        std::make_unique<Entry>(Entry{std::string(string), unsigned(entries.size()) + 1}));
+    const Entry* entry = entries.back().get();
+    /* Key references the string of the entry, which doesn't move. */
+    entries_by_string.insert({entry->string, entry});
+
+    return entry;
+  }
+
+  auto count() -> unsigned int
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return entries.size() + 1;
+  }
+
+ private:
+  std::shared_mutex mutex;
+  std::vector<std::unique_ptr<Entry>> entries;
+  std::unordered_map<std::string_view, const Entry*> entries_by_string;
+};
+
+bwAtom::bwAtom(std::string_view string) : entry(bwAtomTable::get().intern(string))
+{
+}
+
+auto bwAtom::count() -> unsigned int
+{
+  return bwAtomTable::get().count();
+}
+
+}  // namespace bWidgets
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace bWidgets {
+
+/**
+ * \brief Interned string: each distinct string is stored once, atoms only reference it.
+ *
+ * Use it for identifiers that are compared or looked up often, like widget type identifiers and
+ * style property names. Comparing and hashing atoms compares and hashes a pointer, not the
+ * characters. Each atom also gets a dense index (#getIndex()), to index tables with.
+ *
+ * Constructing an atom from a string looks it up in a global table (adding it if needed), so
+ * that's what costs. Do it once and keep the atom, e.g. in a function-local static:
+ * \code
+ * static const bwAtom identifier("bwPushButton");
+ * \endcode
+ * Interned strings are never freed. Atoms can be created and used from any thread.
+ */
+class bwAtom {
+ public:
+  /** The atom of the empty string. */
+  constexpr bwAtom() = default;
+  explicit bwAtom(std::string_view string);
+
+  auto str() const -> std::string_view
+  {
+    return entry ? std::string_view(entry->string) : std::string_view();
+  }
+  /** Dense index of the atom, in the order the strings were interned. The empty string is 0. */
+  auto getIndex() const -> unsigned int
+  {
+    return entry ? entry->index : 0;
+  }
+  /** Number of atoms interned so far. Indices are always smaller than this. */
+  static auto count() -> unsigned int;
+
+  auto operator==(const bwAtom& other) const -> bool
+  {
+    return entry == other.entry;
+  }
+  auto operator!=(const bwAtom& other) const -> bool
+  {
+    return entry != other.entry;
+  }
+
+ private:
+  friend struct std::hash<bwAtom>;
+  friend class bwAtomTable;
+
+  struct Entry {
+    const std::string string;
+    const unsigned int index;
+  };
+
+  /** Null for the empty string, so default constructing and comparing with it is free. */
+  const Entry* entry{nullptr};
+};
+
+}  // namespace bWidgets
+
+template<> struct std::hash<bWidgets::bwAtom> {
+  auto operator()(const bWidgets::bwAtom& atom) const noexcept -> std::size_t
+  {
+    return std::hash<const void*>()(atom.entry);
+  }
+};
@@ -32,7 +32,16 @@ bwColor::bwColor(unsigned int rgb, unsigned int alpha)
   setColor(rgb / 255.0f, alpha / 255.0f);
 }
 
-bwColor::bwColor(const bwColor& other)
+bwColor::bwColor(const bwColorRGBA8& color)
+{
+  const std::uint8_t* components = color.getComponents();
+  setColor(components[0] / 255.0f,
+           components[1] / 255.0f,
+           components[2] / 255.0f,
+           components[3] / 255.0f);
+}
+
+bwColor::bwColor(const bwColor& other) noexcept
 {
   setColor(other.rgba);
 }
@@ -121,4 +130,29 @@ bwColor::operator const float*() const
   return getColor();
 }
 
+bwColorRGBA8::bwColorRGBA8(const bwColor& color)
+    : rgba{componentFromFloat(color[0]),
+           componentFromFloat(color[1]),
+           componentFromFloat(color[2]),
+           componentFromFloat(color[3])}
+{
+}
+
+auto bwColorRGBA8::componentFromFloat(float value) -> std::uint8_t
+{
+  bwRange<float>::clampValue(value, 0.0f, 1.0f);
+  /* Round half up. A byte converted to float (`byte / 255.0f`) converts back to the same byte. */
+  return std::uint8_t(value * 255.0f + 0.5f);
+}
+
+auto bwColorRGBA8::operator==(const bwColorRGBA8& other) const -> bool
+{
+  return getPacked() == other.getPacked();
+}
+
+auto bwColorRGBA8::operator!=(const bwColorRGBA8& other) const -> bool
+{
+  return !(*this == other);
+}
+
 }  // namespace bWidgets
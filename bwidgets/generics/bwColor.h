@@ -1,16 +1,22 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
 namespace bWidgets {
 
+class bwColorRGBA8;
+
 class bwColor {
  public:
   bwColor(float red, float green, float blue, float alpha = 1.0f);
   bwColor(float rgb, float alpha = 1.0f);
   bwColor(unsigned int red, unsigned int green, unsigned int blue, unsigned int alpha = 255);
   bwColor(unsigned int rgb, unsigned int alpha = 255);
+  explicit bwColor(const bwColorRGBA8& color);
   bwColor() = default;
   ~bwColor() = default;
-  bwColor(const bwColor&);
+  bwColor(const bwColor&) noexcept;
 
   auto shade(float rgb_shade, float alpha_shade = 0.0f) -> bwColor&;
   auto shade(unsigned int rgb_shade, unsigned int alpha_shade = 0.0f) -> bwColor&;
@@ -45,4 +51,55 @@ class bwColor {
   float rgba[4]{0, 0, 0, 1};
 };
 
+/**
+ * \brief A color packed into 32 bits, one byte per component (red, green, blue, alpha in memory).
+ *
+ * A quarter of the size of a \ref bwColor, for storing and copying many colors. Converting it to
+ * a \ref bwColor and back gives exactly the same color. Converting a \ref bwColor clamps the
+ * components to [0, 1] and rounds them to the nearest byte value. For many colors at once, see
+ * bwColorBatch.h.
+ */
+class bwColorRGBA8 {
+ public:
+  constexpr bwColorRGBA8() = default;
+  constexpr bwColorRGBA8(std::uint8_t red,
+                         std::uint8_t green,
+                         std::uint8_t blue,
+                         std::uint8_t alpha = 255)
+      : rgba{red, green, blue, alpha}
+  {
+  }
+  explicit bwColorRGBA8(const bwColor& color);
+
+  auto getComponents() const -> const std::uint8_t*
+  {
+    return rgba;
+  }
+  /** All components in one integer, in the byte order of the platform. */
+  auto getPacked() const -> std::uint32_t
+  {
+    std::uint32_t packed;
+    std::memcpy(&packed, rgba, sizeof(packed));
+    return packed;
+  }
+  /** The color of \a packed, as returned by #getPacked(). */
+  static auto fromPacked(std::uint32_t packed) -> bwColorRGBA8
+  {
+    bwColorRGBA8 color;
+    std::memcpy(color.rgba, &packed, sizeof(packed));
+    return color;
+  }
+
+  auto operator==(const bwColorRGBA8& other) const -> bool;
+  auto operator!=(const bwColorRGBA8& other) const -> bool;
+
+  /** The component for a float component in [0, 1], rounded to the nearest value. */
+  static auto componentFromFloat(float value) -> std::uint8_t;
+
+ private:
+  std::uint8_t rgba[4]{0, 0, 0, 255};
+};
+
+static_assert(sizeof(bwColorRGBA8) == sizeof(std::uint32_t), "Should be packed");
+
 }  // namespace bWidgets
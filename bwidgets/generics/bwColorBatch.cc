@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  define BW_COLOR_BATCH_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#  define BW_COLOR_BATCH_NEON
+#  include <arm_neon.h>
+#endif
+
+#include "bwColorBatch.h"
+
+namespace bWidgets {
+
+/* The kernels treat arrays of colors as arrays of floats, four per color. */
+static_assert(sizeof(bwColor) == (4 * sizeof(float)), "Colors should be four packed floats");
+
+/**
+ * \name Vector of the four components of a color
+ *
+ * The few operations the kernels need, so they are only written once.
+ * \{ */
+
+#if defined(BW_COLOR_BATCH_SSE2)
+
+using ColorVec = __m128;
+
+static inline auto vec_load(const float* rgba) -> ColorVec
+{
+  return _mm_loadu_ps(rgba);
+}
+static inline void vec_store(float* r_rgba, ColorVec vec)
+{
+  _mm_storeu_ps(r_rgba, vec);
+}
+static inline auto vec_set(float r, float g, float b, float a) -> ColorVec
+{
+  return _mm_setr_ps(r, g, b, a);
+}
+static inline auto vec_add(ColorVec a, ColorVec b) -> ColorVec
+{
+  return _mm_add_ps(a, b);
+}
+static inline auto vec_sub(ColorVec a, ColorVec b) -> ColorVec
+{
+  return _mm_sub_ps(a, b);
+}
+static inline auto vec_mul(ColorVec a, ColorVec b) -> ColorVec
+{
+  return _mm_mul_ps(a, b);
+}
+static inline auto vec_min(ColorVec a, ColorVec b) -> ColorVec
+{
+  return _mm_min_ps(a, b);
+}
+static inline auto vec_max(ColorVec a, ColorVec b) -> ColorVec
+{
+  return _mm_max_ps(a, b);
+}
+static inline auto vec_alpha(ColorVec vec) -> ColorVec
+{
+  return _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+#elif defined(BW_COLOR_BATCH_NEON)
+
+using ColorVec = float32x4_t;
+
+static inline auto vec_load(const float* rgba) -> ColorVec
+{
+  return vld1q_f32(rgba);
+}
+static inline void vec_store(float* r_rgba, ColorVec vec)
+{
+  vst1q_f32(r_rgba, vec);
+}
+static inline auto vec_set(float r, float g, float b, float a) -> ColorVec
+{
+  const float rgba[4] = {r, g, b, a};
+  return vld1q_f32(rgba);
+}
+static inline auto vec_add(ColorVec a, ColorVec b) -> ColorVec
+{
+  return vaddq_f32(a, b);
+}
+static inline auto vec_sub(ColorVec a, ColorVec b) -> ColorVec
+{
+  return vsubq_f32(a, b);
+}
+static inline auto vec_mul(ColorVec a, ColorVec b) -> ColorVec
+{
+  return vmulq_f32(a, b);
+}
+static inline auto vec_min(ColorVec a, ColorVec b) -> ColorVec
+{
+  return vminq_f32(a, b);
+}
+static inline auto vec_max(ColorVec a, ColorVec b) -> ColorVec
+{
+  return vmaxq_f32(a, b);
+}
+static inline auto vec_alpha(ColorVec vec) -> ColorVec
+{
+  return vdupq_laneq_f32(vec, 3);
+}
+
+#else
+
+struct ColorVec {
+  float v[4];
+};
+
+static inline auto vec_load(const float* rgba) -> ColorVec
+{
+  return {{rgba[0], rgba[1], rgba[2], rgba[3]}};
+}
+static inline void vec_store(float* r_rgba, const ColorVec& vec)
+{
+  std::memcpy(r_rgba, vec.v, sizeof(vec.v));
+}
+static inline auto vec_set(float r, float g, float b, float a) -> ColorVec
+{
+  return {{r, g, b, a}};
+}
+template<typename _Func>
+static inline auto vec_apply(const ColorVec& a, const ColorVec& b, const _Func& func) -> ColorVec
+{
+  return {{func(a.v[0], b.v[0]),
+           func(a.v[1], b.v[1]),
+           func(a.v[2], b.v[2]),
+           func(a.v[3], b.v[3])}};
+}
+static inline auto vec_add(const ColorVec& a, const ColorVec& b) -> ColorVec
+{
+  return vec_apply(a, b, [](float x, float y) { return x + y; });
+}
+static inline auto vec_sub(const ColorVec& a, const ColorVec& b) -> ColorVec
+{
+  return vec_apply(a, b, [](float x, float y) { return x - y; });
+}
+static inline auto vec_mul(const ColorVec& a, const ColorVec& b) -> ColorVec
+{
+  return vec_apply(a, b, [](float x, float y) { return x * y; });
+}
+static inline auto vec_min(const ColorVec& a, const ColorVec& b) -> ColorVec
+{
+  return vec_apply(a, b, [](float x, float y) { return (x < y) ? x : y; });
+}
+static inline auto vec_max(const ColorVec& a, const ColorVec& b) -> ColorVec
+{
+  return vec_apply(a, b, [](float x, float y) { return (x > y) ? x : y; });
+}
+static inline auto vec_alpha(const ColorVec& vec) -> ColorVec
+{
+  return {{vec.v[3], vec.v[3], vec.v[3], vec.v[3]}};
+}
+
+#endif
+
+static inline auto color_data(bwColor* colors) -> float*
+{
+  return &colors[0][0];
+}
+static inline auto color_data(const bwColor* colors) -> const float*
+{
+  return colors[0].getColor();
+}
+
+/** \} */
+
+void bwColorsShade(bwColor* colors,
+                   const std::size_t count,
+                   const float rgb_shade,
+                   const float alpha_shade)
+{
+  if (!count) {
+    return;
+  }
+  float* data = color_data(colors);
+  const ColorVec shade = vec_set(rgb_shade, rgb_shade, rgb_shade, alpha_shade);
+  /* Like bwColor::shade(), alpha isn't clamped. */
+  const float infinity = std::numeric_limits<float>::infinity();
+  const ColorVec min = vec_set(0.0f, 0.0f, 0.0f, -infinity);
+  const ColorVec max = vec_set(1.0f, 1.0f, 1.0f, infinity);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const ColorVec shaded = vec_add(vec_load(&data[i * 4]), shade);
+    vec_store(&data[i * 4], vec_max(vec_min(shaded, max), min));
+  }
+}
+
+void bwColorsPremultiply(bwColor* colors, const std::size_t count)
+{
+  if (!count) {
+    return;
+  }
+  float* data = color_data(colors);
+  /* Keeps alpha, multiplies it by 1. */
+  const ColorVec rgb_mask = vec_set(1.0f, 1.0f, 1.0f, 0.0f);
+  const ColorVec alpha_mask = vec_set(0.0f, 0.0f, 0.0f, 1.0f);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const ColorVec color = vec_load(&data[i * 4]);
+    const ColorVec fac = vec_add(vec_mul(vec_alpha(color), rgb_mask), alpha_mask);
+    vec_store(&data[i * 4], vec_mul(color, fac));
+  }
+}
+
+void bwColorsInterpolate(const bwColor& from,
+                         const bwColor& to,
+                         const float* facs,
+                         const std::size_t count,
+                         bwColor* r_colors)
+{
+  if (!count) {
+    return;
+  }
+  float* data = color_data(r_colors);
+  const ColorVec from_vec = vec_load(from.getColor());
+  const ColorVec delta = vec_sub(vec_load(to.getColor()), from_vec);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const ColorVec fac = vec_set(facs[i], facs[i], facs[i], facs[i]);
+    vec_store(&data[i * 4], vec_add(from_vec, vec_mul(delta, fac)));
+  }
+}
+
+void bwColorsSampleLUT(const bwColor* lut,
+                       const std::size_t lut_size,
+                       const float* positions,
+                       const std::size_t count,
+                       bwColor* r_colors)
+{
+  assert(lut_size >= 2);
+  if (!count) {
+    return;
+  }
+  const float* lut_data = color_data(lut);
+  float* data = color_data(r_colors);
+  const float last_index = float(lut_size - 1);
+
+  for (std::size_t i = 0; i < count; i++) {
+    /* Written so NaN ends up at 0, converting it to an index would be undefined. */
+    const float position = (positions[i] > 0.0f) ? std::min(positions[i], 1.0f) : 0.0f;
+    const float index_fac = position * last_index;
+    const std::size_t index = std::min(std::size_t(index_fac), lut_size - 2);
+    const float fac = index_fac - float(index);
+
+    const ColorVec from = vec_load(&lut_data[index * 4]);
+    const ColorVec delta = vec_sub(vec_load(&lut_data[(index + 1) * 4]), from);
+    vec_store(&data[i * 4], vec_add(from, vec_mul(delta, vec_set(fac, fac, fac, fac))));
+  }
+}
+
+void bwColorsToRGBA8(const bwColor* colors, const std::size_t count, bwColorRGBA8* r_colors)
+{
+  if (!count) {
+    return;
+  }
+
+#if defined(BW_COLOR_BATCH_SSE2) || defined(BW_COLOR_BATCH_NEON)
+  const float* data = color_data(colors);
+  const ColorVec zero = vec_set(0.0f, 0.0f, 0.0f, 0.0f);
+  const ColorVec one = vec_set(1.0f, 1.0f, 1.0f, 1.0f);
+  const ColorVec scale = vec_set(255.0f, 255.0f, 255.0f, 255.0f);
+  const ColorVec half = vec_set(0.5f, 0.5f, 0.5f, 0.5f);
+
+  for (std::size_t i = 0; i < count; i++) {
+    /* Same as bwColorRGBA8::componentFromFloat(): clamp, scale, round half up. */
+    const ColorVec clamped = vec_max(vec_min(vec_load(&data[i * 4]), one), zero);
+    const ColorVec scaled = vec_add(vec_mul(clamped, scale), half);
+#  if defined(BW_COLOR_BATCH_SSE2)
+    const __m128i ints = _mm_cvttps_epi32(scaled);
+    const __m128i shorts = _mm_packs_epi32(ints, ints);
+    const std::int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(shorts, shorts));
+#  else
+    const uint16x4_t shorts = vmovn_u32(vcvtq_u32_f32(scaled));
+    const uint8x8_t bytes = vmovn_u16(vcombine_u16(shorts, shorts));
+    const std::uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+#  endif
+    r_colors[i] = bwColorRGBA8::fromPacked(std::uint32_t(packed));
+  }
+#else
+  for (std::size_t i = 0; i < count; i++) {
+    r_colors[i] = bwColorRGBA8(colors[i]);
+  }
+#endif
+}
+
+void bwColorsFromRGBA8(const bwColorRGBA8* colors, const std::size_t count, bwColor* r_colors)
+{
+  if (!count) {
+    return;
+  }
+
+#if defined(BW_COLOR_BATCH_SSE2) || defined(BW_COLOR_BATCH_NEON)
+  float* data = color_data(r_colors);
+  /* Divide rather than multiply by the reciprocal, to get the same as `byte / 255.0f`. */
+  const ColorVec scale = vec_set(255.0f, 255.0f, 255.0f, 255.0f);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const std::uint32_t packed = colors[i].getPacked();
+#  if defined(BW_COLOR_BATCH_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_cvtsi32_si128(std::int32_t(packed));
+    const __m128i ints = _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+    vec_store(&data[i * 4], _mm_div_ps(_mm_cvtepi32_ps(ints), scale));
+#  else
+    const uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(packed));
+    const uint32x4_t ints = vmovl_u16(vget_low_u16(vmovl_u8(bytes)));
+    vec_store(&data[i * 4], vdivq_f32(vcvtq_f32_u32(ints), scale));
+#  endif
+  }
+#else
+  for (std::size_t i = 0; i < count; i++) {
+    r_colors[i] = bwColor(colors[i]);
+  }
+#endif
+}
+
+}  // namespace bWidgets
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+#include "bwColor.h"
+
+namespace bWidgets {
+
+/**
+ * \name Batch color operations
+ *
+ * The operations of \ref bwColor, for arrays of colors at once. Vectorized with SSE2 or NEON
+ * where available, with a scalar fallback otherwise. Results are the same as doing the operation
+ * for each color separately.
+ *
+ * \{ */
+
+/** Same as \ref bwColor::shade() for each color. */
+void bwColorsShade(bwColor* colors, std::size_t count, float rgb_shade, float alpha_shade = 0.0f);
+/** Multiply the RGB components of each color by its alpha. */
+void bwColorsPremultiply(bwColor* colors, std::size_t count);
+/**
+ * Colors between \a from and \a to, one for each factor in \a facs. Same as
+ * \ref bwInterpolate() for colors.
+ */
+void bwColorsInterpolate(const bwColor& from,
+                         const bwColor& to,
+                         const float* facs,
+                         std::size_t count,
+                         bwColor* r_colors);
+/**
+ * Colors at \a positions (0 to 1, clamped) in a table of \a lut_size colors evenly spaced from 0
+ * to 1, interpolated between the two closest entries. See \ref bwGradient::getLUT().
+ */
+void bwColorsSampleLUT(const bwColor* lut,
+                       std::size_t lut_size,
+                       const float* positions,
+                       std::size_t count,
+                       bwColor* r_colors);
+void bwColorsToRGBA8(const bwColor* colors, std::size_t count, bwColorRGBA8* r_colors);
+void bwColorsFromRGBA8(const bwColorRGBA8* colors, std::size_t count, bwColor* r_colors);
+
+/** \} */
+
+}  // namespace bWidgets
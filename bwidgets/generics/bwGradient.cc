@@ -1,6 +1,9 @@
-#include <cassert>
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
+#include "bwColorBatch.h"
+#include "bwInterpolation.h"
 #include "bwPoint.h"
 
 #include "bwGradient.h"
@@ -11,28 +14,203 @@ bwGradient::bwGradient(const bwColor& base_color,
                        float shade_begin,
                        float shade_end,
                        Direction direction)
-    : direction(direction)
+    : bwGradient({}, (direction == Direction::TOP_BOTTOM) ? 180.0f : 90.0f)
 {
-  begin = base_color;
-  begin.shade(shade_begin);
-  end = base_color;
-  end.shade(shade_end);
+  bwColor begin = base_color;
+  bwColor end = base_color;
+
+  addStop(0.0f, begin.shade(shade_begin));
+  addStop(1.0f, end.shade(shade_end));
+}
+
+bwGradient::bwGradient(std::initializer_list<Stop> stops, float angle) : angle(angle)
+{
+  /* Exact for multiples of 90 degrees, e.g. the sine of 180 degrees isn't quite 0 in floats. */
+  const float quarter_turns = angle / 90.0f;
+  if (quarter_turns == std::round(quarter_turns)) {
+    const float quarter_turn_directions[4][2] = {
+        {0.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, -1.0f}, {-1.0f, 0.0f}};
+    const long index = ((std::lround(quarter_turns) % 4) + 4) % 4;
+    direction_x = quarter_turn_directions[index][0];
+    direction_y = quarter_turn_directions[index][1];
+  }
+  else {
+    const double radians = double(angle) * 3.14159265358979323846 / 180.0;
+    /* Clockwise from pointing up, with y pointing up. */
+    direction_x = float(std::sin(radians));
+    direction_y = float(std::cos(radians));
+  }
+
+  for (const Stop& stop : stops) {
+    addStop(stop.position, stop.color);
+  }
+}
+
+auto bwGradient::radial(std::initializer_list<Stop> stops) -> bwGradient
+{
+  bwGradient gradient(stops);
+  gradient.shape = Shape::RADIAL;
+  return gradient;
+}
+
+void bwGradient::addStop(const float position, const bwColor& color)
+{
+  stops.push_back({position, color});
+  /* Insertion sort, there are only a few. */
+  for (std::size_t i = stops.size() - 1;
+       (i > 0) && (stops[i].position < stops[i - 1].position);
+       i--) {
+    std::swap(stops[i], stops[i - 1]);
+  }
+  is_lut_built = false;
+}
+
+auto bwGradient::getStopCount() const -> std::size_t
+{
+  return stops.size();
+}
+
+auto bwGradient::getStop(const std::size_t index) const -> const Stop&
+{
+  return stops[index];
+}
+
+auto bwGradient::getShape() const -> Shape
+{
+  return shape;
+}
+
+auto bwGradient::getAngle() const -> float
+{
+  return angle;
+}
+
+auto bwGradient::isSingleColor() const -> bool
+{
+  for (const Stop& stop : stops) {
+    if (!(stop.color == stops[0].color)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto bwGradient::calcColorAt(const float position) const -> bwColor
+{
+  if (stops.empty()) {
+    return {};
+  }
+  if (position < stops[0].position) {
+    return stops[0].color;
+  }
+  for (std::size_t i = 1; i < stops.size(); i++) {
+    const Stop& prev = stops[i - 1];
+    const Stop& next = stops[i];
+    if (position < next.position) {
+      const float fac = (position - prev.position) / (next.position - prev.position);
+      return bwInterpolate(prev.color, next.color, fac);
+    }
+  }
+  return stops[stops.size() - 1].color;
+}
+
+void bwGradient::calcPointPositions(const bwPoint* points,
+                                    const std::size_t count,
+                                    const bwRectanglePixel& bounding_box,
+                                    float* r_positions) const
+{
+  const float width = float(bounding_box.width());
+  const float height = float(bounding_box.height());
+  const float center_x = float(bounding_box.xmin) + (width * 0.5f);
+  const float center_y = float(bounding_box.ymin) + (height * 0.5f);
+
+  /* Constants for the whole box first, so the loops over the points are simple enough for the
+   * compiler to vectorize. */
+  switch (shape) {
+    case Shape::LINEAR: {
+      /* Like CSS, the gradient line is long enough for the corners to be at 0 and 1. */
+      const float length = std::abs(width * direction_x) + std::abs(height * direction_y);
+      const float scale_x = (length > 0.0f) ? (direction_x / length) : 0.0f;
+      const float scale_y = (length > 0.0f) ? (direction_y / length) : 0.0f;
+
+      for (std::size_t i = 0; i < count; i++) {
+        r_positions[i] = ((points[i].x - center_x) * scale_x) +
+                         ((points[i].y - center_y) * scale_y) + 0.5f;
+      }
+      break;
+    }
+    case Shape::RADIAL: {
+      /* Ellipse with the aspect of the box, through its corners. */
+      const float corner_fac = std::sqrt(2.0f);
+      const float scale_x = (width > 0.0f) ? (1.0f / (width * 0.5f * corner_fac)) : 0.0f;
+      const float scale_y = (height > 0.0f) ? (1.0f / (height * 0.5f * corner_fac)) : 0.0f;
+
+      for (std::size_t i = 0; i < count; i++) {
+        const float x = (points[i].x - center_x) * scale_x;
+        const float y = (points[i].y - center_y) * scale_y;
+        r_positions[i] = std::sqrt((x * x) + (y * y));
+      }
+      break;
+    }
+  }
+
+  /* Points may be slightly outside the box, e.g. for anti-aliasing. */
+  for (std::size_t i = 0; i < count; i++) {
+    r_positions[i] = std::min(std::max(r_positions[i], 0.0f), 1.0f);
+  }
 }
 
 auto bwGradient::calcPointColor(const bwPoint& point, const bwRectanglePixel& bounding_box) const
     -> bwColor
 {
-  const float pos_fac = (direction == bwGradient::Direction::TOP_BOTTOM) ?
-                            ((point.y - bounding_box.ymin) / (float)bounding_box.height()) :
-                            ((bounding_box.xmax - point.x) / (float)bounding_box.width());
-  const float pos_fac_inv = 1.0f - pos_fac;
+  float position;
+  calcPointPositions(&point, 1, bounding_box, &position);
+  return calcColorAt(position);
+}
+
+/**
+ * Same as #calcColorAt() for each entry, but interpolating all entries between two stops at once.
+ */
+void bwGradient::buildLUT() const
+{
+  const auto entry_position = [](const std::size_t entry) {
+    return float(entry) / float(LUT_SIZE - 1);
+  };
+  std::size_t entry = 0;
+
+  if (stops.empty()) {
+    lut.fill(bwColor());
+    return;
+  }
 
-  assert((pos_fac > -1e-5f) && ((pos_fac - 1.0f) <= 1e-6f));
+  for (; (entry < LUT_SIZE) && (entry_position(entry) < stops[0].position); entry++) {
+    lut[entry] = stops[0].color;
+  }
+  for (std::size_t i = 1; i < stops.size(); i++) {
+    const Stop& prev = stops[i - 1];
+    const Stop& next = stops[i];
+    const std::size_t segment_begin = entry;
+    float facs[LUT_SIZE];
 
-  return bwColor((begin[0] * pos_fac) + (end[0] * pos_fac_inv),
-                 (begin[1] * pos_fac) + (end[1] * pos_fac_inv),
-                 (begin[2] * pos_fac) + (end[2] * pos_fac_inv),
-                 (begin[3] * pos_fac) + (end[3] * pos_fac_inv));
+    for (; (entry < LUT_SIZE) && (entry_position(entry) < next.position); entry++) {
+      facs[entry - segment_begin] = (entry_position(entry) - prev.position) /
+                                    (next.position - prev.position);
+    }
+    bwColorsInterpolate(
+        prev.color, next.color, facs, entry - segment_begin, lut.data() + segment_begin);
+  }
+  for (; entry < LUT_SIZE; entry++) {
+    lut[entry] = stops[stops.size() - 1].color;
+  }
+}
+
+auto bwGradient::getLUT() const -> const LUT&
+{
+  if (!is_lut_built) {
+    buildLUT();
+    is_lut_built = true;
+  }
+  return lut;
 }
 
 }  // namespace bWidgets
@@ -1,15 +1,23 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
 #include "bwColor.h"
 #include "bwRectangle.h"
+#include "bwSmallVector.h"
 
 namespace bWidgets {
 
 /**
- * \brief Simple class for calculating colors for gradient fills.
+ * \brief Colors for gradient fills: linear along any angle or radial, with any number of stops.
+ *
+ * Each point of the filled area has a position along the gradient, from 0 to 1 (see
+ * #calcPointPositions()). Its color is interpolated between the stops around that position.
  *
- * The implementation is currently pretty simple and limited, it's however all we need for
- * now. More features like unlimited stops at custom positions could be added if needed.
+ * Filling many vertices uses a small table of colors precomputed from the stops (#getLUT()), so
+ * the cost per vertex doesn't depend on the number of stops. #calcPointColor() is exact.
  */
 class bwGradient {
  public:
@@ -17,18 +25,72 @@ class bwGradient {
     TOP_BOTTOM,
     LEFT_RIGHT,
   };
+  enum class Shape {
+    LINEAR,
+    RADIAL,
+  };
+
+  struct Stop {
+    /** From 0 (start of the gradient) to 1 (end of it). */
+    float position;
+    bwColor color;
+  };
+
+  /** Number of colors in the lookup table, evenly spaced from position 0 to 1. */
+  static constexpr std::size_t LUT_SIZE = 32;
+  using LUT = std::array<bwColor, LUT_SIZE>;
 
   bwGradient() = default;
+  /** Two stops: \a base_color shaded by \a shade_begin, then shaded by \a shade_end. */
   explicit bwGradient(const bwColor& base_color,
                       float shade_begin,
                       float shade_end,
                       Direction direction = Direction::TOP_BOTTOM);
+  /**
+   * Linear gradient. Like in CSS, \a angle is in degrees, clockwise from pointing up: 90 goes
+   * from left to right, 180 from top to bottom.
+   */
+  bwGradient(std::initializer_list<Stop> stops, float angle = 180.0f);
+  /** Elliptical gradient, from the center of the bounding box (0) to its corners (1). */
+  static auto radial(std::initializer_list<Stop> stops) -> bwGradient;
+
+  /** Stops can be added in any order. With equal positions, the one added last comes last. */
+  void addStop(float position, const bwColor& color);
+  auto getStopCount() const -> std::size_t;
+  auto getStop(std::size_t index) const -> const Stop&;
+  auto getShape() const -> Shape;
+  auto getAngle() const -> float;
+  /** All stops have the same color (or there are none), so the position doesn't matter. */
+  auto isSingleColor() const -> bool;
 
   auto calcPointColor(const class bwPoint& point, const bwRectanglePixel& bounding_box) const
       -> bwColor;
+  /** The color at \a position along the gradient, calculated from the stops. */
+  auto calcColorAt(float position) const -> bwColor;
+  /**
+   * Where each of \a points is along the gradient filling \a bounding_box, from 0 to 1.
+   */
+  void calcPointPositions(const class bwPoint* points,
+                          std::size_t count,
+                          const bwRectanglePixel& bounding_box,
+                          float* r_positions) const;
+  /**
+   * Colors of the gradient sampled at #LUT_SIZE evenly spaced positions, to interpolate between
+   * (see \ref bwColorsSampleLUT()). Built on first use, so not thread-safe.
+   */
+  auto getLUT() const -> const LUT&;
+
+ private:
+  void buildLUT() const;
+
+  bwSmallVector<Stop, 4> stops;
+  Shape shape{Shape::LINEAR};
+  float angle{180.0f};
+  /** Unit vector along the gradient, from the angle. */
+  float direction_x{0.0f}, direction_y{-1.0f};
 
-  bwColor begin, end;
-  Direction direction{Direction::TOP_BOTTOM};
+  mutable LUT lut;
+  mutable bool is_lut_built{false};
 };
 
 }  // namespace bWidgets
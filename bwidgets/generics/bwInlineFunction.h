@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bWidgets {
+
+template<typename _Signature, std::size_t _BufferSize = 4 * sizeof(void*)>
+class bwInlineFunction;
+
+/**
+ * \brief Function object like `std::function`, but storing the callable in an inline buffer.
+ *
+ * `std::function` only stores small callables inline, what's small depends on the standard
+ * library. This never allocates: callables that don't fit into \a _BufferSize are a compile
+ * error. So keep captures small, e.g. capture a pointer to a bigger struct instead of the struct
+ * itself.
+ */
+template<typename _Return, typename... _Args, std::size_t _BufferSize>
+class bwInlineFunction<_Return(_Args...), _BufferSize> {
+ public:
+  bwInlineFunction() = default;
+
+  template<typename _Callable,
+           typename = std::enable_if_t<
+               !std::is_same_v<std::decay_t<_Callable>, bwInlineFunction> &&
+               std::is_invocable_r_v<_Return, std::decay_t<_Callable>&, _Args...>>>
+  bwInlineFunction(_Callable&& callable)
+  {
+    using StoredType = std::decay_t<_Callable>;
+    static_assert(sizeof(StoredType) <= _BufferSize,
+                  "Callable too big for the inline buffer, capture less or increase its size");
+    static_assert(alignof(StoredType) <= alignof(std::max_align_t), "Unsupported alignment");
+    static_assert(std::is_nothrow_move_constructible_v<StoredType>,
+                  "Callable needs to be nothrow move constructible");
+
+    new (buffer) StoredType(std::forward<_Callable>(callable));
+    invoke_fn = [](void* stored, _Args&&... args) -> _Return {
+      return (*static_cast<StoredType*>(stored))(std::forward<_Args>(args)...);
+    };
+    manage_fn = [](Operation operation, void* dst, void* src) {
+      switch (operation) {
+        case Operation::COPY:
+          new (dst) StoredType(*static_cast<const StoredType*>(src));
+          break;
+        case Operation::MOVE:
+          new (dst) StoredType(std::move(*static_cast<StoredType*>(src)));
+          break;
+        case Operation::DESTROY:
+          static_cast<StoredType*>(dst)->~StoredType();
+          break;
+      }
+    };
+  }
+
+  bwInlineFunction(const bwInlineFunction& other)
+  {
+    copyFrom(other);
+  }
+  bwInlineFunction(bwInlineFunction&& other) noexcept
+  {
+    moveFrom(other);
+  }
+  ~bwInlineFunction()
+  {
+    reset();
+  }
+
+  auto operator=(const bwInlineFunction& other) -> bwInlineFunction&
+  {
+    if (this != &other) {
+      reset();
+      copyFrom(other);
+    }
+    return *this;
+  }
+  auto operator=(bwInlineFunction&& other) noexcept -> bwInlineFunction&
+  {
+    if (this != &other) {
+      reset();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  explicit operator bool() const
+  {
+    return invoke_fn != nullptr;
+  }
+
+  auto operator()(_Args... args) const -> _Return
+  {
+    return invoke_fn(const_cast<unsigned char*>(buffer), std::forward<_Args>(args)...);
+  }
+
+ private:
+  enum class Operation { COPY, MOVE, DESTROY };
+
+  void reset()
+  {
+    if (manage_fn) {
+      manage_fn(Operation::DESTROY, buffer, nullptr);
+    }
+    invoke_fn = nullptr;
+    manage_fn = nullptr;
+  }
+  void copyFrom(const bwInlineFunction& other)
+  {
+    if (other.manage_fn) {
+      other.manage_fn(Operation::COPY, buffer, const_cast<unsigned char*>(other.buffer));
+    }
+    invoke_fn = other.invoke_fn;
+    manage_fn = other.manage_fn;
+  }
+  void moveFrom(bwInlineFunction& other)
+  {
+    if (other.manage_fn) {
+      other.manage_fn(Operation::MOVE, buffer, other.buffer);
+    }
+    invoke_fn = other.invoke_fn;
+    manage_fn = other.manage_fn;
+    other.reset();
+  }
+
+  alignas(std::max_align_t) unsigned char buffer[_BufferSize];
+  _Return (*invoke_fn)(void*, _Args&&...){nullptr};
+  void (*manage_fn)(Operation, void* dst, void* src){nullptr};
+};
+
+}  // namespace bWidgets
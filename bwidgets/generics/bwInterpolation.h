@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "bwColor.h"
+#include "bwPoint.h"
+#include "bwRectangle.h"
+
+namespace bWidgets {
+
+enum class bwEasing {
+  LINEAR,
+  /** Start fast, slow down towards the end. Feels most responsive for reactions to input. */
+  EASE_OUT,
+  EASE_IN_OUT,
+};
+
+/**
+ * Map the linear progress \a fac (0 to 1) to the progress of the easing curve.
+ */
+inline auto bwEase(bwEasing easing, float fac) -> float
+{
+  switch (easing) {
+    case bwEasing::LINEAR:
+      return fac;
+    case bwEasing::EASE_OUT:
+      /* Cubic. */
+      return 1.0f - std::pow(1.0f - fac, 3.0f);
+    case bwEasing::EASE_IN_OUT:
+      /* Smoothstep. */
+      return fac * fac * (3.0f - 2.0f * fac);
+  }
+  return fac;
+}
+
+/**
+ * \name Interpolation
+ *
+ * Values between \a from and \a to, at \a fac (0 to 1). Integers are rounded, so animating pixel
+ * values ends up exactly at the target.
+ * \{ */
+
+template<typename _Type, typename = std::enable_if_t<std::is_arithmetic_v<_Type>>>
+inline auto bwInterpolate(_Type from, _Type to, float fac) -> _Type
+{
+  if constexpr (std::is_integral_v<_Type>) {
+    return from + _Type(std::lround(float(to - from) * fac));
+  }
+  else {
+    return from + _Type((to - from) * fac);
+  }
+}
+
+inline auto bwInterpolate(const bwPoint& from, const bwPoint& to, float fac) -> bwPoint
+{
+  return {bwInterpolate(from.x, to.x, fac), bwInterpolate(from.y, to.y, fac)};
+}
+
+template<typename T>
+inline auto bwInterpolate(const bwRectangle<T>& from, const bwRectangle<T>& to, float fac)
+    -> bwRectangle<T>
+{
+  return {bwInterpolate(from.xmin, to.xmin, fac),
+          bwInterpolate(from.xmax, to.xmax, fac),
+          bwInterpolate(from.ymin, to.ymin, fac),
+          bwInterpolate(from.ymax, to.ymax, fac)};
+}
+
+/** Interpolates the (non-premultiplied) RGBA components separately. */
+inline auto bwInterpolate(const bwColor& from, const bwColor& to, float fac) -> bwColor
+{
+  const float* from_rgba = from;
+  const float* to_rgba = to;
+
+  return {bwInterpolate(from_rgba[0], to_rgba[0], fac),
+          bwInterpolate(from_rgba[1], to_rgba[1], fac),
+          bwInterpolate(from_rgba[2], to_rgba[2], fac),
+          bwInterpolate(from_rgba[3], to_rgba[3], fac)};
+}
+
+/** \} */
+
+}  // namespace bWidgets
@@ -38,6 +38,17 @@ template<typename T> class bwRectangle {
     ymax += pixel;
   }
 
+  /**
+   * Move the rectangle by \a x horizontally and by \a y vertically.
+   */
+  inline void translate(const T x, const T y)
+  {
+    xmin += x;
+    xmax += x;
+    ymin += y;
+    ymax += y;
+  }
+
   template<typename U> inline bool isCoordinateInside(const U x, const U y) const
   {
     return (x >= xmin) && (x <= xmax) && (y >= ymin) && (y <= ymax);
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bWidgets {
+
+/**
+ * \brief Vector storing up to \a _InlineCapacity elements without heap allocations.
+ *
+ * For many small lists of which most contain only a few elements, e.g. one list per node. Once
+ * more elements are added, they are moved to the heap like with `std::vector`. Only supports
+ * appending and removing, no insertion in the middle.
+ */
+template<typename _Type, std::size_t _InlineCapacity> class bwSmallVector {
+  static_assert(_InlineCapacity > 0, "Use std::vector if nothing should be stored inline");
+
+ public:
+  bwSmallVector() = default;
+  bwSmallVector(const bwSmallVector& other)
+  {
+    reserve(other.element_count);
+    for (const _Type& value : other) {
+      new (elements + element_count) _Type(value);
+      element_count++;
+    }
+  }
+  bwSmallVector(bwSmallVector&& other) noexcept
+  {
+    moveFrom(other);
+  }
+  ~bwSmallVector()
+  {
+    clear();
+    freeHeapBuffer();
+  }
+
+  auto operator=(const bwSmallVector& other) -> bwSmallVector&
+  {
+    if (this != &other) {
+      bwSmallVector copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+  auto operator=(bwSmallVector&& other) noexcept -> bwSmallVector&
+  {
+    if (this != &other) {
+      clear();
+      freeHeapBuffer();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  template<typename... _Args> auto emplace_back(_Args&&... args) -> _Type&
+  {
+    if (element_count == capacity) {
+      reserve(capacity * 2);
+    }
+    _Type* value = new (elements + element_count) _Type(std::forward<_Args>(args)...);
+    element_count++;
+    return *value;
+  }
+  void push_back(_Type value)
+  {
+    emplace_back(std::move(value));
+  }
+
+  /** Remove the element at \a index, by moving the last element into its place (so the order of
+   * elements is not kept). */
+  void removeUnordered(std::size_t index)
+  {
+    if (index != (element_count - 1)) {
+      elements[index] = std::move(elements[element_count - 1]);
+    }
+    elements[element_count - 1].~_Type();
+    element_count--;
+  }
+
+  void clear()
+  {
+    std::destroy(elements, elements + element_count);
+    element_count = 0;
+  }
+
+  void reserve(std::size_t new_capacity)
+  {
+    if (new_capacity <= capacity) {
+      return;
+    }
+
+    _Type* new_data = std::allocator<_Type>().allocate(new_capacity);
+    std::uninitialized_move(elements, elements + element_count, new_data);
+    std::destroy(elements, elements + element_count);
+    freeHeapBuffer();
+
+    elements = new_data;
+    capacity = new_capacity;
+  }
+
+  auto size() const -> std::size_t
+  {
+    return element_count;
+  }
+  auto empty() const -> bool
+  {
+    return element_count == 0;
+  }
+  /** Check if the elements are stored inline, so no heap allocation was made. */
+  auto isInline() const -> bool
+  {
+    return elements == inlineData();
+  }
+
+  auto operator[](std::size_t index) -> _Type&
+  {
+    return elements[index];
+  }
+  auto operator[](std::size_t index) const -> const _Type&
+  {
+    return elements[index];
+  }
+
+  auto begin() -> _Type*
+  {
+    return elements;
+  }
+  auto end() -> _Type*
+  {
+    return elements + element_count;
+  }
+  auto begin() const -> const _Type*
+  {
+    return elements;
+  }
+  auto end() const -> const _Type*
+  {
+    return elements + element_count;
+  }
+
+ private:
+  auto inlineData() const -> _Type*
+  {
+    return reinterpret_cast<_Type*>(const_cast<unsigned char*>(inline_buffer));
+  }
+
+  void freeHeapBuffer()
+  {
+    if (!isInline()) {
+      std::allocator<_Type>().deallocate(elements, capacity);
+      elements = inlineData();
+      capacity = _InlineCapacity;
+    }
+  }
+
+  /** Expects this to be empty and use the inline buffer. */
+  void moveFrom(bwSmallVector& other)
+  {
+    if (other.isInline()) {
+      std::uninitialized_move(other.elements, other.elements + other.element_count, elements);
+      element_count = other.element_count;
+      other.clear();
+    }
+    else {
+      /* Steal the heap buffer. */
+      elements = other.elements;
+      element_count = other.element_count;
+      capacity = other.capacity;
+      other.elements = other.inlineData();
+      other.element_count = 0;
+      other.capacity = _InlineCapacity;
+    }
+  }
+
+  alignas(_Type) unsigned char inline_buffer[_InlineCapacity * sizeof(_Type)];
+  _Type* elements{inlineData()};
+  std::size_t element_count{0};
+  std::size_t capacity{_InlineCapacity};
+};
+
+}  // namespace bWidgets
@@ -1,6 +1,7 @@
 #include <cassert>
 
 #include "Builder.h"
+#include "Mutator.h"
 
 namespace bWidgets {
 namespace bwScreenGraph {
@@ -21,6 +22,7 @@ void Builder::setLayout(LayoutNode& node, std::unique_ptr<bwLayoutInterface> lay
 void Builder::setWidget(WidgetNode& node, std::unique_ptr<bwWidget> widget)
 {
   node.widget = std::move(widget);
+  node.widget->screen_graph_node = &node;
   node.handler = node.widget->createHandler();
 }
 
@@ -31,6 +33,30 @@ auto Builder::addWidget(LayoutNode& node, std::unique_ptr<bwWidget> widget) -> b
   return *node_ref.widget;
 }
 
+/**
+ * \brief Build the children of a container created with \ref buildContainerLazy().
+ *
+ * Does nothing if the children are built already, or if the container doesn't show them.
+ *
+ * \return True if the children were built.
+ */
+auto Builder::buildLazyChildren(ContainerNode& node) -> bool
+{
+  if (node.are_children_built || !node.lazy_build_func || !node.childrenVisible()) {
+    return false;
+  }
+
+  node.are_children_built = true;
+  node.lazy_build_func(node);
+
+  return true;
+}
+
+void Builder::invalidateLayout(LayoutNode& node)
+{
+  Mutator::invalidateLayout(node);
+}
+
 /**
  * \brief Activate a layout node.
  *
@@ -93,8 +93,7 @@ class Builder {
     static_assert(std::is_base_of<bwWidget, _WidgetType>::value, "Should derrive from bwWidget");
 
     WidgetNode& new_node = addChildNode<WidgetNode>(_active_layout_node);
-    new_node.widget = std::make_unique<_WidgetType>(std::forward<_Args>(__args)...);
-    new_node.handler = new_node.widget->createHandler();
+    setWidget(new_node, std::make_unique<_WidgetType>(std::forward<_Args>(__args)...));
     return static_cast<_WidgetType&>(*new_node.widget);
   }
 
@@ -109,8 +108,7 @@ class Builder {
 
     setLayout(new_node, std::move(layout));
 
-    new_node.widget = std::make_unique<_WidgetType>(new_node, std::forward<_Args>(__args)...);
-    new_node.handler = new_node.widget->createHandler();
+    setWidget(new_node, std::make_unique<_WidgetType>(new_node, std::forward<_Args>(__args)...));
 
     setActiveLayout(new_node);
     return new_node;
@@ -157,13 +155,61 @@ class Builder {
 
     ContainerNode& new_node = addChildNode<ContainerNode>(_active_layout_node);
     setLayout(new_node, std::move(layout));
-    new_node.widget = std::make_unique<_WidgetType>(new_node, std::forward<_Args>(__args)...);
-    new_node.handler = new_node.widget->createHandler();
+    setWidget(new_node, std::make_unique<_WidgetType>(new_node, std::forward<_Args>(__args)...));
     buildChildren(build_func, new_node);
 
     return new_node;
   }
 
+  /**
+   * \brief Build a container node in-place, but defer building its children until they are
+   * visible.
+   *
+   * This override passes the default builder type (\ref Builder) to the \a build_func.
+   */
+  template<typename _WidgetType, typename... _Args>
+  auto buildContainerLazy(BuildFunc<> build_func,
+                          std::unique_ptr<bwLayoutInterface> layout,
+                          _Args&&... __args) -> ContainerNode&
+  {
+    return buildContainerLazy<_WidgetType, Builder>(
+        build_func, std::move(layout), std::forward<_Args>(__args)...);
+  }
+
+  /**
+   * \brief Build a container node in-place, but defer building its children until they are
+   * visible.
+   *
+   * Like \ref buildContainer(), but if the container hides its children (e.g. a collapsed panel,
+   * see \ref Node::childrenVisible()), \a build_func is only stored. It's executed by
+   * \ref buildLazyChildren() once the children are shown, using a copy of this builder. Saves
+   * time and memory for content that may never be looked at.
+   */
+  template<typename _WidgetType, typename _BuilderType, typename... _Args>
+  auto buildContainerLazy(BuildFunc<_BuilderType> build_func,
+                          std::unique_ptr<bwLayoutInterface> layout,
+                          _Args&&... __args) -> ContainerNode&
+  {
+    static_assert(std::is_base_of<bwContainerWidget, _WidgetType>::value,
+                  "Should derrive from bwContainerWidget");
+    static_assert(std::is_base_of_v<Builder, _BuilderType>, "Should inherit from Builder");
+
+    ContainerNode& new_node = addChildNode<ContainerNode>(_active_layout_node);
+    setLayout(new_node, std::move(layout));
+    setWidget(new_node, std::make_unique<_WidgetType>(new_node, std::forward<_Args>(__args)...));
+
+    new_node.lazy_build_func = [build_func, builder = static_cast<_BuilderType&>(*this)](
+                                   ContainerNode& node) mutable {
+      builder.buildChildren(build_func, node);
+    };
+    new_node.are_children_built = false;
+    buildLazyChildren(new_node);
+
+    return new_node;
+  }
+
+  static auto buildLazyChildren(ContainerNode& node) -> bool;
+
   /**
    * \brief Add child node for a widget created in-place.
    *
@@ -196,12 +242,13 @@ class Builder {
     static_assert(std::is_base_of<bwWidget, _WidgetType>::value, "Should derrive from bwWidget");
 
     WidgetNode& new_node = addChildNode<WidgetNode>(node);
-    new_node.widget = std::make_unique<_WidgetType>(std::forward<_Args>(__args)...);
-    new_node.handler = new_node.widget->createHandler();
+    setWidget(new_node, std::make_unique<_WidgetType>(std::forward<_Args>(__args)...));
     return static_cast<_WidgetType&>(*new_node.widget);
   }
 
  private:
+  static void invalidateLayout(LayoutNode& node);
+
   template<typename _NodeType> static auto addChildNode(LayoutNode& parent_node) -> _NodeType&
   {
     static_assert(std::is_base_of<Node, _NodeType>::value,
@@ -210,6 +257,8 @@ class Builder {
     parent_node.children.push_back(std::make_unique<_NodeType>());
     Node& ref = *parent_node.children.back();
     ref.parent = &parent_node;
+    ref.iter_in_parent = std::prev(parent_node.children.end());
+    invalidateLayout(parent_node);
 
     return dynamic_cast<_NodeType&>(ref);
   }
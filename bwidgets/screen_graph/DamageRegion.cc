@@ -0,0 +1,88 @@
+#include <algorithm>
+
+#include "DamageRegion.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+static auto rectangle_union(const bwRectanglePixel& a, const bwRectanglePixel& b)
+    -> bwRectanglePixel
+{
+  return {std::min(a.xmin, b.xmin),
+          std::max(a.xmax, b.xmax),
+          std::min(a.ymin, b.ymin),
+          std::max(a.ymax, b.ymax)};
+}
+
+static auto rectangle_contains(const bwRectanglePixel& outer, const bwRectanglePixel& inner)
+    -> bool
+{
+  return (inner.xmin >= outer.xmin) && (inner.xmax <= outer.xmax) &&
+         (inner.ymin >= outer.ymin) && (inner.ymax <= outer.ymax);
+}
+
+void DamageRegion::add(const bwRectanglePixel& rect)
+{
+  if (rect.isEmpty()) {
+    /* E.g. nodes that were never layed out. Nothing visible to redraw. */
+    return;
+  }
+
+  for (const bwRectanglePixel& iter_rect : rectangles) {
+    if (rectangle_contains(iter_rect, rect)) {
+      return;
+    }
+  }
+
+  /* Rectangles covered by the new one are redundant now. */
+  rectangles.erase(std::remove_if(rectangles.begin(),
+                                  rectangles.end(),
+                                  [&rect](const bwRectanglePixel& iter_rect) {
+                                    return rectangle_contains(rect, iter_rect);
+                                  }),
+                   rectangles.end());
+
+  if (rectangles.size() >= MAX_RECTANGLES) {
+    bwRectanglePixel bounds = getBounds();
+    rectangles.clear();
+    rectangles.push_back(rectangle_union(bounds, rect));
+    return;
+  }
+
+  rectangles.push_back(rect);
+}
+
+void DamageRegion::clear()
+{
+  rectangles.clear();
+}
+
+auto DamageRegion::isEmpty() const -> bool
+{
+  return rectangles.empty();
+}
+
+auto DamageRegion::getRectangles() const -> const std::vector<bwRectanglePixel>&
+{
+  return rectangles;
+}
+
+/**
+ * \return The rectangle enclosing all damaged areas. Empty if nothing is damaged.
+ */
+auto DamageRegion::getBounds() const -> bwRectanglePixel
+{
+  if (rectangles.empty()) {
+    return {};
+  }
+
+  bwRectanglePixel bounds = rectangles.front();
+  for (const bwRectanglePixel& rect : rectangles) {
+    bounds = rectangle_union(bounds, rect);
+  }
+
+  return bounds;
+}
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
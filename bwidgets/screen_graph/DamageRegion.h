@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "bwRectangle.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+/**
+ * \brief Collection of screen areas that need to be redrawn.
+ *
+ * Operations that change the screen-graph (see \ref Mutator) add the areas they affect here, so
+ * that the application can limit redrawing to those. Rectangles are kept separate up to a small
+ * maximum count, after that they are merged into a single bounding rectangle. Many small updates
+ * should not make tracking damage more expensive than simply redrawing everything.
+ */
+class DamageRegion {
+ public:
+  void add(const bwRectanglePixel& rect);
+  void clear();
+
+  auto isEmpty() const -> bool;
+  auto getRectangles() const -> const std::vector<bwRectanglePixel>&;
+  auto getBounds() const -> bwRectanglePixel;
+
+  constexpr static unsigned int MAX_RECTANGLES = 16;
+
+ private:
+  std::vector<bwRectanglePixel> rectangles;
+};
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
@@ -4,6 +4,7 @@
 
 #include "Node.h"
 #include "ScreenGraph.h"
+#include "StyleResolver.h"
 
 #include "Drawer.h"
 
@@ -16,12 +17,19 @@ Drawer::Drawer(bwStyle& _style) : style(_style)
 
 void Drawer::draw(bwScreenGraph::ScreenGraph& screen_graph, bwStyle& style)
 {
+  StyleResolver::resolve(screen_graph, style);
+
   Drawer drawer{style};
   drawer.drawSubtreeRecursive(screen_graph.Root());
+
+  /* Everything is up to date now. */
+  screen_graph.damage.clear();
 }
 
 void Drawer::drawSubtree(Node& subtree_root, bwStyle& style)
 {
+  StyleResolver::resolveSubtree(subtree_root, style);
+
   Drawer drawer{style};
   drawer.drawSubtreeRecursive(subtree_root);
 }
@@ -37,9 +45,18 @@ void Drawer::drawSubtreeRecursive(bwScreenGraph::Node& subtree_root)
   }
 
   if (subtree_root.childrenVisible() && subtree_root.Children()) {
+    const bwPoint content_offset = subtree_root.ContentOffset();
+    const bool has_offset = !(content_offset == bwPoint());
+
+    if (has_offset) {
+      pushTranslation(content_offset);
+    }
     for (auto& child_node : *subtree_root.Children()) {
       drawSubtreeRecursive(*child_node);
     }
+    if (has_offset) {
+      popTranslation(content_offset);
+    }
   }
 
   if (has_maskrect) {
@@ -54,7 +71,6 @@ void Drawer::drawNode(bwScreenGraph::Node& node)
     return;
   }
 
-  style.setWidgetStyle(*widget);
   widget->draw(style);
 }
 
@@ -62,6 +78,7 @@ void Drawer::pushMask(const Node& node)
 {
   bwRectanglePixel final_maskrect = *node.MaskRectangle();
 
+  final_maskrect.translate(int(translation.x), int(translation.y));
   if (!maskrect_stack.empty()) {
     final_maskrect.clamp(maskrect_stack.top());
   }
@@ -77,5 +94,17 @@ void Drawer::popMask()
   }
 }
 
+void Drawer::pushTranslation(const bwPoint& offset)
+{
+  translation = translation + offset;
+  bwPainter::s_paint_engine->translate(offset);
+}
+
+void Drawer::popTranslation(const bwPoint& offset)
+{
+  translation = translation - offset;
+  bwPainter::s_paint_engine->translate(bwPoint() - offset);
+}
+
 }  // namespace bwScreenGraph
 }  // namespace bWidgets
@@ -2,6 +2,7 @@
 
 #include <stack>
 
+#include "bwPoint.h"
 #include "bwRectangle.h"
 
 namespace bWidgets {
@@ -14,7 +15,10 @@ class Node;
 
 class Drawer {
  public:
+  /** Sets the styles of the widgets first, see \ref StyleResolver. */
   static void draw(ScreenGraph& screen_graph, bwStyle& style);
+  /** For subtrees drawn on their own, like the scroll bars of a scroll view. Sets their styles
+   * first too. */
   static void drawSubtree(Node& subtree_root, bwStyle& style);
 
  private:
@@ -24,9 +28,14 @@ class Drawer {
   void drawNode(Node& node);
   void pushMask(const Node& node);
   void popMask();
+  void pushTranslation(const bwPoint& offset);
+  void popTranslation(const bwPoint& offset);
 
   bwStyle& style;
   std::stack<bwRectanglePixel> maskrect_stack;
+  /** Sum of the content offsets of the ancestors of the node being drawn. Mask rectangles are
+   * not translated by the paint-engine, so they have to be moved by this. */
+  bwPoint translation;
 };
 
 }  // namespace bwScreenGraph
@@ -1,16 +1,40 @@
-#include <assert.h>
+#include <atomic>
 #include <iostream>
 
+#include "bwEvent.h"
+
 #include "EventHandler.h"
 #include "Node.h"
 
 namespace bWidgets {
 namespace bwScreenGraph {
 
+auto EventHandler::registerEventType() -> EventType
+{
+  static std::atomic<unsigned int> registered_type_count{TOT_BUILTIN_EVENT_TYPES};
+  return EventType(registered_type_count++);
+}
+
 void EventHandler::addEventListener(EventHandler::EventType event_type, EventListener listener)
 {
-  assert(event_type < TOT_EVENT_TYPES);
-  listeners[event_type].push_back(listener);
+  listeners.push_back({event_type, std::move(listener)});
+}
+
+auto EventHandler::hasEventListeners() const -> bool
+{
+  return !listeners.empty();
+}
+
+void EventHandler::callEventListeners(EventType event_type, Node& node, bwEvent& event) const
+{
+  for (const RegisteredListener& registered : listeners) {
+    if (event.isSwallowed()) {
+      break;
+    }
+    if (registered.event_type == event_type) {
+      registered.listener(node, event);
+    }
+  }
 }
 
 void EventHandler::onMouseMove(bwEvent&)
@@ -1,9 +1,7 @@
 #pragma once
 
-#include <array>
-#include <functional>
-#include <list>
-#include <unordered_map>
+#include "bwInlineFunction.h"
+#include "bwSmallVector.h"
 
 namespace bWidgets {
 
@@ -17,30 +15,55 @@ namespace bwScreenGraph {
 class Node;
 
 // TODO bwHandlingContext
-using EventListener = std::function<void(Node&)>;
+/**
+ * Called with the node the listener was added to and the event, with its location in the
+ * coordinate space of the node. Like the `onFoo()` handlers, listeners may swallow the event to
+ * stop it from bubbling up further.
+ *
+ * Captures must fit into the inline buffer of \ref bwInlineFunction, which avoids heap
+ * allocations.
+ */
+using EventListener = bwInlineFunction<void(Node&, bwEvent&)>;
 
 /**
  * \brief API for registering and calling event-listeners
  *
+ * Events are sent to the virtual `onFoo()` handlers first, then to the listeners added for the
+ * event type with #addEventListener(). Besides the built-in event types, custom ones can be
+ * registered using #registerEventType() and sent with \ref bwEventDispatcher::emitEvent().
+ *
  * TODO:
- * * Only default `onFoo()` style listeners are supported, custom `addEventListener()` doesn't work
- *   yet.
  * * Many widget handlers are friend classes to the widgets to access internal data. Instead
  *   widgets should have APIs to manipulate their state anyway, which they don't have yet.
  */
 class EventHandler {
  public:
-  enum EventType {
+  enum EventType : unsigned int {
+    MOUSE_MOVE,
     MOUSE_ENTER,
     MOUSE_LEAVE,
+    MOUSE_PRESS,
+    MOUSE_RELEASE,
+    MOUSE_CLICK,
+    MOUSE_DRAG,
+    MOUSE_WHEEL,
 
-    TOT_EVENT_TYPES,
+    TOT_BUILTIN_EVENT_TYPES,
   };
 
   EventHandler() = default;
   virtual ~EventHandler() = default;
 
+  /**
+   * Get a new event type, for events sent with \ref bwEventDispatcher::emitEvent(). Usually
+   * called once and stored in a static variable. Thread-safe.
+   */
+  static auto registerEventType() -> EventType;
+
   void addEventListener(EventType event_type, EventListener listener);
+  auto hasEventListeners() const -> bool;
+  /** Call all listeners for \a event_type, until one of them swallows the event. */
+  void callEventListeners(EventType event_type, Node& node, bwEvent& event) const;
 
   virtual void onMouseMove(bwEvent&);
   virtual void onMouseEnter(bwEvent&);
@@ -52,8 +75,14 @@ class EventHandler {
   virtual void onMouseWheel(bwMouseWheelEvent&);
 
  private:
-  std::array<std::list<EventListener>, TOT_EVENT_TYPES> listeners;
-  //	std::unordered_map<EventType, std::list<EventListener>> listener_map;
+  struct RegisteredListener {
+    EventType event_type;
+    EventListener listener;
+  };
+
+  /** Handlers rarely have more than a few listeners, if any. Searching a small array linearly
+   * is cheaper than indexing per event type, and doesn't take space for unused types. */
+  bwSmallVector<RegisteredListener, 2> listeners;
 };
 
 }  // namespace bwScreenGraph
@@ -0,0 +1,257 @@
+#include <cassert>
+
+#include "Mutator.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+Mutator::Mutator(ScreenGraph& screen_graph) : screen_graph(screen_graph)
+{
+}
+
+/**
+ * Get the rectangle of the node from the last layout calculation, if any.
+ */
+static auto node_rectangle(const Node& node) -> bwRectanglePixel
+{
+  if (!node.Layout() && !node.Widget()) {
+    return {};
+  }
+  return node.Rectangle();
+}
+
+static auto is_node_ancestor_or_self(const Node& node, const Node& ancestor) -> bool
+{
+  for (const Node* iter = &node; iter; iter = iter->Parent()) {
+    if (iter == &ancestor) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * \brief Tag the layout of \a node and of all its ancestors as dirty.
+ *
+ * Siblings and any other nodes are not affected, their layout can be reused.
+ */
+void Mutator::invalidateLayout(Node& node)
+{
+  for (Node* iter = &node; iter; iter = iter->Parent()) {
+    if (bwLayoutInterface* layout = iter->Layout()) {
+      layout->markDirty();
+    }
+  }
+}
+
+/**
+ * \brief Add the area of \a node to the damage of the screen-graph it belongs to, so the
+ * application knows it has to be drawn again.
+ *
+ * Static so widgets can use it without knowing the screen-graph, see
+ * \ref ScreenGraph::fromNode(). Does nothing if \a node isn't part of a screen-graph.
+ */
+void Mutator::requestRedraw(const Node& node)
+{
+  if (ScreenGraph* screen_graph = ScreenGraph::fromNode(node)) {
+    screen_graph->damage.add(node_rectangle(node));
+  }
+}
+
+/**
+ * \brief Let the next style pass set the style of all widgets in the subtree again (see
+ * \ref bwWidget::invalidateStyle()).
+ *
+ * Needed when the ancestors of the subtree change, e.g. because it's moved to a different parent.
+ */
+void Mutator::invalidateStyleOfSubtree(const Node& subtree_root)
+{
+  if (bwWidget* widget = subtree_root.Widget()) {
+    widget->invalidateStyle();
+  }
+  if (const Node::ChildList* children = subtree_root.Children()) {
+    for (const auto& child : *children) {
+      invalidateStyleOfSubtree(*child);
+    }
+  }
+}
+
+/**
+ * \param before: The sibling to insert \a node in front of. Appends if this is null.
+ * \return A reference to the inserted node (now owned by \a parent).
+ */
+auto Mutator::insert(LayoutNode& parent, Node* before, std::unique_ptr<Node> node) -> Node&
+{
+  assert(node && !node->parent);
+  assert(!before || (before->parent == &parent));
+
+  const Node::ChildIterator position = before ? before->iter_in_parent : parent.children.end();
+  Node& node_ref = *node;
+
+  node_ref.iter_in_parent = parent.children.insert(position, std::move(node));
+  node_ref.parent = &parent;
+
+  screen_graph.damage.add(node_rectangle(parent));
+  invalidateLayout(parent);
+  /* E.g. a node removed before, styled for its old ancestors. */
+  invalidateStyleOfSubtree(node_ref);
+
+  return node_ref;
+}
+
+auto Mutator::append(LayoutNode& parent, std::unique_ptr<Node> node) -> Node&
+{
+  return insert(parent, nullptr, std::move(node));
+}
+
+/**
+ * Prepare removing \a node (and its subtree) from its parent, by updating all state that may
+ * reference it.
+ */
+void Mutator::detach(Node& node)
+{
+  Node& parent = *node.parent;
+
+  screen_graph.event_dispatcher.handleSubtreeRemoval(node);
+  screen_graph.animator.handleSubtreeRemoval(node);
+
+  screen_graph.damage.add(node_rectangle(node));
+  screen_graph.damage.add(node_rectangle(parent));
+  invalidateLayout(parent);
+}
+
+/**
+ * Unlink \a node and its subtree from the screen-graph.
+ *
+ * \return The removed node, so the caller can keep it alive (e.g. to insert it again later).
+ *         Simply discard it to destruct the subtree.
+ */
+auto Mutator::remove(Node& node) -> std::unique_ptr<Node>
+{
+  assert(node.parent && "Can't remove the root node");
+
+  Node::ChildList& siblings = *node.parent->Children();
+  const Node::ChildIterator iter = node.iter_in_parent;
+
+  detach(node);
+
+  std::unique_ptr<Node> removed = std::move(*iter);
+  siblings.erase(iter);
+  removed->parent = nullptr;
+  removed->iter_in_parent = {};
+
+  return removed;
+}
+
+/**
+ * Move \a node and its subtree to a different position, possibly under a different parent.
+ * The node isn't reconstructed, so any state stays intact and references to it stay valid.
+ *
+ * \param before: The sibling to move \a node in front of. Appends if this is null.
+ */
+void Mutator::move(Node& node, LayoutNode& new_parent, Node* before)
+{
+  assert(node.parent && "Can't move the root node");
+  assert(!before || (before->parent == &new_parent));
+  assert(!is_node_ancestor_or_self(new_parent, node) && "Can't move node into its own subtree");
+
+  if (before == &node) {
+    return;
+  }
+
+  Node& old_parent = *node.parent;
+  const Node::ChildIterator position = before ? before->iter_in_parent : new_parent.children.end();
+
+  screen_graph.damage.add(node_rectangle(node));
+  screen_graph.damage.add(node_rectangle(old_parent));
+  screen_graph.damage.add(node_rectangle(new_parent));
+
+  /* Splicing keeps iterators valid, so node.iter_in_parent doesn't need to be updated. */
+  new_parent.children.splice(position, *old_parent.Children(), node.iter_in_parent);
+  node.parent = &new_parent;
+
+  invalidateLayout(old_parent);
+  if (&old_parent != &new_parent) {
+    invalidateLayout(new_parent);
+    invalidateStyleOfSubtree(node);
+  }
+}
+
+/**
+ * Put \a new_node at the position of \a old_node.
+ *
+ * \return The replaced node, so the caller can keep it alive. Simply discard it to destruct the
+ *         subtree.
+ */
+auto Mutator::replace(Node& old_node, std::unique_ptr<Node> new_node) -> std::unique_ptr<Node>
+{
+  assert(old_node.parent && "Can't replace the root node");
+  assert(new_node && !new_node->parent);
+
+  const Node::ChildIterator iter = old_node.iter_in_parent;
+
+  detach(old_node);
+
+  new_node->parent = old_node.parent;
+  new_node->iter_in_parent = iter;
+  iter->swap(new_node);
+  invalidateStyleOfSubtree(**iter);
+
+  /* new_node holds the old node now. */
+  new_node->parent = nullptr;
+  new_node->iter_in_parent = {};
+
+  return new_node;
+}
+
+/**
+ * \brief Destruct the children of a container created with \ref Builder::buildContainerLazy(),
+ * while it doesn't show them.
+ *
+ * They are built again by \ref Builder::buildLazyChildren() once the container shows them. Any
+ * state of the children not stored elsewhere is lost.
+ *
+ * \return True if children were freed.
+ */
+auto Mutator::freeLazyChildren(ContainerNode& node) -> bool
+{
+  if (!node.lazy_build_func || !node.are_children_built || node.childrenVisible()) {
+    return false;
+  }
+
+  while (!node.children.empty()) {
+    remove(*node.children.front());
+  }
+  node.are_children_built = false;
+
+  return true;
+}
+
+/**
+ * \brief Free the children of all lazily built containers in \a subtree_root that currently
+ * hide them (see \ref freeLazyChildren()).
+ *
+ * Meant to release memory, e.g. when the application runs low on it.
+ *
+ * \return The number of containers whose children were freed.
+ */
+auto Mutator::freeHiddenLazyChildren(Node& subtree_root) -> unsigned int
+{
+  if (ContainerNode* container = dynamic_cast<ContainerNode*>(&subtree_root)) {
+    if (freeLazyChildren(*container)) {
+      return 1;
+    }
+  }
+
+  unsigned int freed_count = 0;
+  if (Node::ChildList* children = subtree_root.Children()) {
+    for (auto& child : *children) {
+      freed_count += freeHiddenLazyChildren(*child);
+    }
+  }
+
+  return freed_count;
+}
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <type_traits>
+
+#include "Builder.h"
+#include "Node.h"
+#include "ScreenGraph.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+/**
+ * \brief Helper class to change existing screen-graphs.
+ *
+ * While the \ref Builder can only add nodes, the mutator can insert, remove, move and replace
+ * nodes anywhere in an existing screen-graph. All operations are constant time with respect to
+ * the number of siblings (linear only in the depth of the tree, for the ancestor updates).
+ *
+ * Every operation
+ * * keeps the screen-graph context (hovered and active node) valid,
+ * * tags the layouts of the affected nodes and their ancestors as dirty (see
+ *   \ref bwLayoutInterface::markDirty()), but not any other layouts,
+ * * adds the affected screen areas to \ref ScreenGraph::damage, so the application can
+ *   redraw partially,
+ * * invalidates the styles of subtrees getting a new parent, since style sheets may select
+ *   widgets by their ancestors.
+ *
+ * Note that the damage is based on the rectangles from the last layout calculation. When the
+ * layout changes geometry of further nodes, it's up to the layout to report that.
+ */
+class Mutator {
+ public:
+  Mutator(ScreenGraph& screen_graph);
+
+  auto insert(LayoutNode& parent, Node* before, std::unique_ptr<Node> node) -> Node&;
+  auto append(LayoutNode& parent, std::unique_ptr<Node> node) -> Node&;
+  auto remove(Node& node) -> std::unique_ptr<Node>;
+  void move(Node& node, LayoutNode& new_parent, Node* before = nullptr);
+  auto replace(Node& old_node, std::unique_ptr<Node> new_node) -> std::unique_ptr<Node>;
+
+  auto freeLazyChildren(ContainerNode& node) -> bool;
+  auto freeHiddenLazyChildren(Node& subtree_root) -> unsigned int;
+
+  /**
+   * \brief Insert a node for a widget created in-place.
+   *
+   * The arguments \a __args are forwarded to the widget constructor.
+   *
+   * \param before: The sibling to insert the new node in front of. Appends if this is null.
+   */
+  template<typename _WidgetType, typename... _Args>
+  auto insertWidget(LayoutNode& parent, Node* before, _Args&&... __args) -> _WidgetType&
+  {
+    static_assert(std::is_base_of<bwWidget, _WidgetType>::value, "Should derrive from bwWidget");
+
+    auto new_node = std::make_unique<WidgetNode>();
+    Builder::setWidget(*new_node, std::make_unique<_WidgetType>(std::forward<_Args>(__args)...));
+
+    WidgetNode& node_ref = static_cast<WidgetNode&>(insert(parent, before, std::move(new_node)));
+    return static_cast<_WidgetType&>(*node_ref.widget);
+  }
+
+  static void invalidateLayout(Node& node);
+  static void requestRedraw(const Node& node);
+  static void invalidateStyleOfSubtree(const Node& subtree_root);
+
+ private:
+  void detach(Node& node);
+
+  ScreenGraph& screen_graph;
+};
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <functional>
 #include <list>
+#include <string>
 
 #include "bwContainerWidget.h"
 #include "bwLayoutInterface.h"
+#include "bwPoint.h"
 #include "bwWidget.h"
 
 namespace bWidgets {
 namespace bwScreenGraph {
 
 class EventHandler;
+class ScreenGraph;
 
 /**
  * \brief The base data-structure for a screen-graph node
@@ -35,6 +39,9 @@ class EventHandler;
  */
 class Node {
   friend class Builder;
+  friend class Mutator;
+  friend class ReconcilingBuilder;
+  friend class ScreenGraph;
 
  public:
   using ChildList = std::list<std::unique_ptr<Node>>;
@@ -57,6 +64,15 @@ class Node {
     return true;
   }
 
+  /**
+   * Offset to move all children by when drawing or handling events. Lets containers scroll their
+   * contents, without recalculating the layout of them.
+   */
+  virtual auto ContentOffset() const -> bwPoint
+  {
+    return {};
+  }
+
   virtual auto Layout() const -> bwLayoutInterface*
   {
     return nullptr;
@@ -83,7 +99,16 @@ class Node {
 
  private:
   Node* parent{nullptr};
+  /** Position of this node in the parent's children list, for constant time list operations.
+   * Only valid if \a parent is set. */
+  ChildIterator iter_in_parent{};
+  /** Identifier that is stable over rebuilds, to find the node again (see
+   * \ref ReconcilingBuilder). Only unique among siblings. */
+  std::string key;
   std::unique_ptr<EventHandler> handler{nullptr};
+  /** Only set for the root node, so any node can find the screen-graph it belongs to (see
+   * \ref Mutator::requestRedraw()). */
+  ScreenGraph* screen_graph{nullptr};
 };
 
 /**
@@ -91,6 +116,7 @@ class Node {
  */
 class LayoutNode : virtual public Node {
   friend class Builder;
+  friend class Mutator;
 
  public:
   auto Children() const -> const ChildList* override
@@ -132,6 +158,7 @@ class LayoutNode : virtual public Node {
  */
 class WidgetNode : virtual public Node {
   friend class Builder;
+  friend class Mutator;
 
  public:
   auto Widget() const -> bwWidget* override
@@ -165,6 +192,9 @@ class WidgetNode : virtual public Node {
  * diamond problems.
  */
 class ContainerNode : public LayoutNode, public WidgetNode {
+  friend class Builder;
+  friend class Mutator;
+
  public:
   auto Children() const -> const ChildList* override
   {
@@ -213,6 +243,19 @@ class ContainerNode : public LayoutNode, public WidgetNode {
   {
     return ContainerWidget().childrenVisible();
   }
+
+  auto ContentOffset() const -> bwPoint override
+  {
+    return ContainerWidget().getContentOffset();
+  }
+
+ private:
+  /** Callback to build the children with, for containers built using
+   * \ref Builder::buildContainerLazy(). Kept after building, so children freed with
+   * \ref Mutator::freeLazyChildren() can be built again. */
+  std::function<void(ContainerNode&)> lazy_build_func;
+  /** False if building the children was deferred, or if they were freed. */
+  bool are_children_built{true};
 };
 
 }  // namespace bwScreenGraph
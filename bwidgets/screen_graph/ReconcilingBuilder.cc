@@ -0,0 +1,135 @@
+#include <cassert>
+
+#include "Iterators.h"
+
+#include "ReconcilingBuilder.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+ReconcilingBuilder::Level::Level(LayoutNode& parent)
+    : parent(&parent), cursor(parent.Children()->begin())
+{
+}
+
+ReconcilingBuilder::ReconcilingBuilder(ScreenGraph& screen_graph)
+    : ReconcilingBuilder(screen_graph, screen_graph.Root())
+{
+}
+
+/**
+ * \param layout_node: The node to reconcile the children of. Must be part of \a screen_graph.
+ */
+ReconcilingBuilder::ReconcilingBuilder(ScreenGraph& screen_graph, LayoutNode& layout_node)
+    : mutator(screen_graph), level(layout_node)
+{
+}
+
+ReconcilingBuilder::~ReconcilingBuilder()
+{
+  finish();
+}
+
+/**
+ * \brief Destruct the children that were not built again.
+ *
+ * Sub-layouts are finished as soon as their build function returns, this only applies to the
+ * children of the node this builder was created for. Called on destruction if not done before.
+ */
+void ReconcilingBuilder::finish()
+{
+  if (is_finished) {
+    return;
+  }
+  removeUnmatched();
+  is_finished = true;
+}
+
+auto ReconcilingBuilder::getStatistics() const -> const Statistics&
+{
+  return statistics;
+}
+
+/**
+ * Find a child of the current layout node with \a key, that wasn't matched before.
+ *
+ * Checking the child at the cursor first makes rebuilding in unchanged order constant time per
+ * item. Only once the order differs, a lookup table of the remaining children is created.
+ */
+auto ReconcilingBuilder::findNode(const std::string& key) -> Node*
+{
+  const Node::ChildList& children = *level.parent->Children();
+
+  if ((level.cursor != children.end()) && ((*level.cursor)->key == key)) {
+    if (level.lookup) {
+      level.lookup->erase(key);
+    }
+    return level.cursor->get();
+  }
+
+  if (!level.lookup) {
+    level.lookup = std::make_unique<std::unordered_map<std::string, Node*>>();
+    for (auto iter = level.cursor; iter != children.end(); ++iter) {
+      level.lookup->emplace((*iter)->key, iter->get());
+    }
+  }
+
+  auto found = level.lookup->find(key);
+  if (found == level.lookup->end()) {
+    return nullptr;
+  }
+
+  Node* node = found->second;
+  level.lookup->erase(found);
+  return node;
+}
+
+/**
+ * Place \a node (a not yet matched child of the current layout node) before the cursor.
+ */
+void ReconcilingBuilder::reuseNode(Node& node)
+{
+  assert(node.parent == level.parent);
+
+  if (level.cursor->get() == &node) {
+    ++level.cursor;
+  }
+  else {
+    mutator.move(node, *level.parent, level.cursor->get());
+  }
+  statistics.reused++;
+}
+
+auto ReconcilingBuilder::insertNode(const std::string& key, std::unique_ptr<Node> node) -> Node&
+{
+  const bool is_at_end = level.cursor == level.parent->Children()->end();
+
+  node->key = key;
+  statistics.created++;
+
+  return mutator.insert(*level.parent, is_at_end ? nullptr : level.cursor->get(), std::move(node));
+}
+
+/**
+ * Remove all children of the current layout node that weren't matched, they are all placed after
+ * the cursor.
+ */
+void ReconcilingBuilder::removeUnmatched()
+{
+  const Node::ChildList& children = *level.parent->Children();
+
+  while (level.cursor != children.end()) {
+    Node& node = **level.cursor;
+    ++level.cursor;
+
+    for (Node& iter_node : node) {
+      (void)iter_node;
+      statistics.destroyed++;
+    }
+    mutator.remove(node);
+  }
+  level.lookup = nullptr;
+}
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "Builder.h"
+#include "Mutator.h"
+#include "Node.h"
+#include "ScreenGraph.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+/**
+ * \brief Builder for screen-graphs that are regenerated over and over (e.g. every redraw).
+ *
+ * Rather than constructing a new screen-graph, this builder compares what is built with the
+ * children existing from the previous build. Each item is identified by a key that must be stable
+ * over rebuilds and unique among its siblings. If a child with the same key and of the same type
+ * exists already, it is reused in place. Nodes, widgets, layouts and event handlers then keep all
+ * their state (e.g. the text of a text box being edited). Only items with new keys are allocated,
+ * children that aren't built again are destroyed.
+ *
+ * Note that arguments to construct widgets or layouts are only used if the item has to be
+ * created. To update reused widgets, use the returned reference.
+ *
+ * \code
+ * ReconcilingBuilder builder(screen_graph);
+ *
+ * for (const Object& object : objects) {
+ *   builder.addWidget<bwLabel>(object.id, object.name).setLabel(object.name);
+ * }
+ * builder.finish();
+ * \endcode
+ *
+ * Changes are applied using the \ref Mutator, so only layouts of actually changed nodes are
+ * invalidated.
+ */
+class ReconcilingBuilder {
+ public:
+  template<typename _BuilderType = ReconcilingBuilder>
+  using BuildFunc = std::function<void(_BuilderType&)>;
+
+  /** Counters for the last build, mainly for debugging and profiling. */
+  struct Statistics {
+    unsigned int reused{0};
+    unsigned int created{0};
+    unsigned int destroyed{0};
+  };
+
+  ReconcilingBuilder(ScreenGraph& screen_graph);
+  ReconcilingBuilder(ScreenGraph& screen_graph, LayoutNode& layout_node);
+  virtual ~ReconcilingBuilder();
+
+  void finish();
+  auto getStatistics() const -> const Statistics&;
+
+  template<typename _WidgetType, typename... _Args>
+  auto addWidget(const std::string& key, _Args&&... __args) -> _WidgetType&
+  {
+    static_assert(std::is_base_of<bwWidget, _WidgetType>::value, "Should derrive from bwWidget");
+
+    Node* node = findNode(key);
+    if (node && !node->Children() && node->Widget() &&
+        (typeid(*node->Widget()) == typeid(_WidgetType)))
+    {
+      reuseNode(*node);
+      return static_cast<_WidgetType&>(*node->Widget());
+    }
+
+    auto new_node = std::make_unique<WidgetNode>();
+    Builder::setWidget(*new_node, std::make_unique<_WidgetType>(std::forward<_Args>(__args)...));
+    node = &insertNode(key, std::move(new_node));
+
+    return static_cast<_WidgetType&>(*node->Widget());
+  }
+
+  template<typename _LayoutType, typename... _Args>
+  auto buildLayout(BuildFunc<> build_func, const std::string& key, _Args&&... __args)
+      -> LayoutNode&
+  {
+    return buildLayout<_LayoutType, ReconcilingBuilder>(
+        build_func, key, std::forward<_Args>(__args)...);
+  }
+
+  template<typename _LayoutType, typename _BuilderType, typename... _Args>
+  auto buildLayout(BuildFunc<_BuilderType> build_func, const std::string& key, _Args&&... __args)
+      -> LayoutNode&
+  {
+    static_assert(std::is_base_of_v<bwLayoutInterface, _LayoutType>,
+                  "Should implement bwLayoutInterface");
+    static_assert(std::is_base_of_v<ReconcilingBuilder, _BuilderType>,
+                  "Should inherit from ReconcilingBuilder");
+
+    Node* node = findNode(key);
+    LayoutNode* layout_node = nullptr;
+
+    if (node && !node->Widget() && node->Layout() &&
+        (typeid(*node->Layout()) == typeid(_LayoutType)))
+    {
+      reuseNode(*node);
+      layout_node = dynamic_cast<LayoutNode*>(node);
+    }
+    else {
+      auto new_node = std::make_unique<LayoutNode>();
+      Builder::setLayout(*new_node, std::make_unique<_LayoutType>(std::forward<_Args>(__args)...));
+      layout_node = new_node.get();
+      insertNode(key, std::move(new_node));
+    }
+
+    buildChildren(build_func, *layout_node);
+    return *layout_node;
+  }
+
+  template<typename _WidgetType, typename... _Args>
+  auto buildContainer(BuildFunc<> build_func,
+                      const std::string& key,
+                      std::unique_ptr<bwLayoutInterface> layout,
+                      _Args&&... __args) -> ContainerNode&
+  {
+    return buildContainer<_WidgetType, ReconcilingBuilder>(
+        build_func, key, std::move(layout), std::forward<_Args>(__args)...);
+  }
+
+  /**
+   * \param layout: Only used if the container is created, or if the reused container has a layout
+   *                of a different type.
+   */
+  template<typename _WidgetType, typename _BuilderType, typename... _Args>
+  auto buildContainer(BuildFunc<_BuilderType> build_func,
+                      const std::string& key,
+                      std::unique_ptr<bwLayoutInterface> layout,
+                      _Args&&... __args) -> ContainerNode&
+  {
+    static_assert(std::is_base_of<bwContainerWidget, _WidgetType>::value,
+                  "Should derrive from bwContainerWidget");
+    static_assert(std::is_base_of_v<ReconcilingBuilder, _BuilderType>,
+                  "Should inherit from ReconcilingBuilder");
+
+    assert(layout);
+
+    Node* node = findNode(key);
+    ContainerNode* container_node = nullptr;
+
+    if (node && node->Children() && node->Widget() &&
+        (typeid(*node->Widget()) == typeid(_WidgetType)))
+    {
+      reuseNode(*node);
+      container_node = dynamic_cast<ContainerNode*>(node);
+      if (typeid(*container_node->Layout()) != typeid(*layout)) {
+        Builder::setLayout(*container_node, std::move(layout));
+        /* The new layout was never calculated, and the parents may have to make room for it. */
+        mutator.invalidateLayout(*container_node);
+        Mutator::requestRedraw(*container_node);
+      }
+    }
+    else {
+      auto new_node = std::make_unique<ContainerNode>();
+      Builder::setLayout(*new_node, std::move(layout));
+      Builder::setWidget(*new_node,
+                         std::make_unique<_WidgetType>(*new_node, std::forward<_Args>(__args)...));
+      container_node = new_node.get();
+      insertNode(key, std::move(new_node));
+    }
+
+    buildChildren(build_func, *container_node);
+    return *container_node;
+  }
+
+ private:
+  /** Reconciliation state for the children of one layout node. */
+  struct Level {
+    Level(LayoutNode& parent);
+
+    LayoutNode* parent;
+    /** The first child that wasn't matched yet. Children before it are built already. */
+    Node::ChildIterator cursor;
+    /** Unmatched children by key, only created when children are not built in the existing
+     * order. */
+    std::unique_ptr<std::unordered_map<std::string, Node*>> lookup;
+  };
+
+  auto findNode(const std::string& key) -> Node*;
+  void reuseNode(Node& node);
+  auto insertNode(const std::string& key, std::unique_ptr<Node> node) -> Node&;
+  void removeUnmatched();
+
+  template<typename _BuilderType>
+  void buildChildren(BuildFunc<_BuilderType> build_func, LayoutNode& node)
+  {
+    Level parent_level = std::move(level);
+    level = Level(node);
+
+    build_func(static_cast<_BuilderType&>(*this));
+    removeUnmatched();
+
+    level = std::move(parent_level);
+  }
+
+  Mutator mutator;
+  Level level;
+  Statistics statistics;
+  bool is_finished{false};
+};
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
@@ -0,0 +1,30 @@
+#include "Node.h"
+
+#include "ScreenGraph.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+void ScreenGraph::attachRoot()
+{
+  root_node->screen_graph = this;
+}
+
+auto ScreenGraph::fromNode(const Node& node) -> ScreenGraph*
+{
+  const Node* root = &node;
+  while (root->Parent()) {
+    root = root->Parent();
+  }
+  return root->screen_graph;
+}
+
+auto ScreenGraph::needsRedraw() const -> bool
+{
+  /* Invalidating a layout tags all ancestor layouts too, so checking the root is enough. */
+  const bwLayoutInterface* root_layout = root_node->Layout();
+  return (root_layout && root_layout->isDirty()) || !damage.isEmpty();
+}
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
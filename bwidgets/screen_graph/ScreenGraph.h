@@ -1,8 +1,11 @@
 #pragma once
 
+#include "bwAnimator.h"
 #include "bwContext.h"
 #include "bwEventDispatcher.h"
 
+#include "DamageRegion.h"
+
 namespace bWidgets {
 namespace bwScreenGraph {
 
@@ -15,6 +18,7 @@ class ScreenGraph {
   ScreenGraph(std::unique_ptr<_NodeType> _root_node)
       : event_dispatcher(*this), root_node(std::move(_root_node))
   {
+    attachRoot();
   }
 
   auto Root() const -> LayoutNode&
@@ -22,11 +26,27 @@ class ScreenGraph {
     return *root_node;
   }
 
+  /** \return The screen-graph \a node belongs to, if any. Linear in the depth of \a node. */
+  static auto fromNode(const Node& node) -> ScreenGraph*;
+
   /** The context describing the state of this screen-graph */
   bwContext context;
   bwEventDispatcher event_dispatcher;
+  /**
+   * Check if anything changed since the screen-graph was last drawn: a layout needs to be
+   * recalculated, or areas were damaged (by changes to the screen-graph or by widgets, see
+   * \ref bwWidget::requestRedraw()). If not, the application can skip drawing.
+   */
+  auto needsRedraw() const -> bool;
+
+  /** Areas that need to be redrawn because the screen-graph changed (see \ref Mutator). Cleared
+   * when drawing (see \ref Drawer::draw()). */
+  DamageRegion damage;
+  bwAnimator animator;
 
  private:
+  void attachRoot();
+
   std::unique_ptr<LayoutNode> root_node;
 };
 
@@ -0,0 +1,86 @@
+#include "bwStyle.h"
+#include "bwStyleManager.h"
+#include "bwTaskPool.h"
+#include "bwWidget.h"
+
+#include "Node.h"
+#include "ScreenGraph.h"
+
+#include "StyleResolver.h"
+
+namespace bWidgets {
+namespace bwScreenGraph {
+
+/** Styling a widget takes well below a microsecond, so give tasks plenty of them. */
+static constexpr std::size_t STYLE_GRAIN_SIZE = 64;
+
+StyleResolver::StyleResolver(bwStyle& _style)
+    : style(_style), style_generation(bwStyleManager::getStyleManager().getStyleGeneration())
+{
+}
+
+void StyleResolver::resolve(ScreenGraph& screen_graph, bwStyle& style)
+{
+  resolveSubtree(screen_graph.Root(), style);
+}
+
+void StyleResolver::resolveSubtree(Node& subtree_root, bwStyle& style)
+{
+  StyleResolver resolver{style};
+  resolver.collectRecursive(subtree_root);
+  resolver.styleCollected();
+}
+
+/**
+ * Collect the widgets of the nodes the \ref Drawer draws, that need to be styled.
+ */
+void StyleResolver::collectRecursive(Node& node)
+{
+  bwWidget* widget = node.Widget();
+  if (widget && node.isVisible() && !node.Rectangle().isEmpty() && needsStyle(*widget)) {
+    widgets.push_back(widget);
+  }
+
+  if (node.childrenVisible() && node.Children()) {
+    for (auto& child_node : *node.Children()) {
+      collectRecursive(*child_node);
+    }
+  }
+}
+
+void StyleResolver::styleCollected()
+{
+  if (widgets.empty()) {
+    return;
+  }
+
+  if (!style.canSetWidgetStylesConcurrently()) {
+    for (bwWidget* widget : widgets) {
+      styleWidget(*widget);
+    }
+    return;
+  }
+
+  style.prepareWidgetStyles(widgets);
+  /* Each task only writes to the widgets of its own range. */
+  bwParallelFor(0, widgets.size(), STYLE_GRAIN_SIZE, [this](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) {
+      styleWidget(*widgets[i]);
+    }
+  });
+}
+
+auto StyleResolver::needsStyle(const bwWidget& widget) const -> bool
+{
+  return (widget.styled_generation != style_generation) || (widget.styled_state != widget.state);
+}
+
+void StyleResolver::styleWidget(bwWidget& widget)
+{
+  style.setWidgetStyle(widget);
+  widget.styled_generation = style_generation;
+  widget.styled_state = widget.state;
+}
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+namespace bWidgets {
+
+class bwStyle;
+class bwWidget;
+
+namespace bwScreenGraph {
+class ScreenGraph;
+class Node;
+
+/**
+ * \brief Sets the styles of the widgets in a screen-graph, in a pass of its own.
+ *
+ * The \ref Drawer runs this before drawing anything, drawing then only reads the styles set here.
+ * Only widgets that will be drawn are styled, and only if their state or the style generation
+ * (see \ref bwStyleManager::getStyleGeneration()) changed since they were styled last, or their
+ * style was invalidated (see \ref bwWidget::invalidateStyle()). So activating a different style,
+ * or changing something all styles depend on (like the DPI factor), has to bump the generation.
+ *
+ * Styling a widget doesn't depend on other widgets. If the style allows it (see
+ * \ref bwStyle::canSetWidgetStylesConcurrently()), widgets are styled in parallel with
+ * \ref bwParallelFor(). Otherwise one after the other, in drawing order.
+ */
+class StyleResolver {
+ public:
+  static void resolve(ScreenGraph& screen_graph, bwStyle& style);
+  static void resolveSubtree(Node& subtree_root, bwStyle& style);
+
+ private:
+  StyleResolver(bwStyle& style);
+
+  void collectRecursive(Node& node);
+  void styleCollected();
+  auto needsStyle(const bwWidget& widget) const -> bool;
+  void styleWidget(bwWidget& widget);
+
+  bwStyle& style;
+  const unsigned int style_generation;
+  /** The widgets to style, in drawing order. */
+  std::vector<bwWidget*> widgets;
+};
+
+}  // namespace bwScreenGraph
+}  // namespace bWidgets
@@ -15,4 +15,14 @@ void bwStyle::polish(class bwWidget&)
   /* Nothing by default. */
 }
 
+auto bwStyle::canSetWidgetStylesConcurrently() const -> bool
+{
+  return false;
+}
+
+void bwStyle::prepareWidgetStyles(const std::vector<bwWidget*>&)
+{
+  /* Nothing by default. */
+}
+
 }  // namespace bWidgets
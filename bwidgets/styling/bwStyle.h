@@ -2,6 +2,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 namespace bWidgets {
 
@@ -31,6 +32,15 @@ class bwStyle {
   virtual void setWidgetStyle(bwWidget& widget) = 0;
   virtual void polish(bwWidget&);
 
+  /**
+   * If true, #setWidgetStyle() may be called for different widgets from multiple threads at
+   * once, after #prepareWidgetStyles() was called for them. Otherwise widgets are styled one
+   * after the other, in drawing order. See \ref bwScreenGraph::StyleResolver.
+   */
+  virtual auto canSetWidgetStylesConcurrently() const -> bool;
+  /** Build what #setWidgetStyle() would build lazily for \a widgets, so it doesn't have to. */
+  virtual void prepareWidgetStyles(const std::vector<bwWidget*>& widgets);
+
   static unsigned int s_default_widget_size_hint;
 
   TypeID type_id;
@@ -17,14 +17,15 @@ void bwStyleCSS::setWidgetStyle(bwWidget& widget)
 {
   polish(widget);
 
-  if (auto* button = widget_cast<bwAbstractButton>(widget)) {
-    button->base_style.roundbox_corners = button->rounded_corners;
+  if (widget_is<bwAbstractButton>(widget)) {
+    auto& button = static_cast<bwAbstractButton&>(widget);
+    button.base_style.roundbox_corners = button.rounded_corners;
   }
-  else if (auto* container = widget_cast<bwContainerWidget>(widget)) {
-    container->base_style.roundbox_corners = RoundboxCorner::ALL;
+  else if (widget_is<bwContainerWidget>(widget)) {
+    static_cast<bwContainerWidget&>(widget).base_style.roundbox_corners = RoundboxCorner::ALL;
   }
-  else if (auto* text_box = widget_cast<bwTextBox>(widget)) {
-    text_box->base_style.roundbox_corners =
+  else if (widget_is<bwTextBox>(widget)) {
+    static_cast<bwTextBox&>(widget).base_style.roundbox_corners =
         RoundboxCorner::ALL;  // XXX Incorrect, should set this in layout.
   }
   else {
@@ -59,4 +59,14 @@ auto bwStyleManager::getBuiltinStyleTypes() const -> const bwStyleManager::Style
   return builtin_style_types;
 }
 
+auto bwStyleManager::getStyleGeneration() const -> unsigned int
+{
+  return style_generation.load(std::memory_order_acquire);
+}
+
+void bwStyleManager::bumpStyleGeneration()
+{
+  style_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
 }  // namespace bWidgets
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 
 #include "bwStyle.h"
@@ -21,6 +22,14 @@ class bwStyleManager {
 
   auto getBuiltinStyleTypes() const -> const StyleTypeArray&;
 
+  /**
+   * Incremented whenever the styling of widgets may have changed, e.g. because a different style
+   * was activated or a style sheet was reloaded. Caches of resolved style data can store the
+   * generation they were built for, and rebuild once it differs.
+   */
+  auto getStyleGeneration() const -> unsigned int;
+  void bumpStyleGeneration();
+
  private:
   bwStyleManager() = default;
   bwStyleManager(bwStyleManager const&) = delete;
@@ -28,6 +37,7 @@ class bwStyleManager {
   void operator=(bwStyleManager const&) = delete;
 
   StyleTypeArray builtin_style_types;
+  std::atomic<unsigned int> style_generation{0};
   //	std::vector<StyleType> custom_types;
 };
 
@@ -1,27 +1,86 @@
 #include <cassert>
-#include <iostream>
-
-#include "bwColor.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
 
 #include "bwStyleProperties.h"
 
 namespace bWidgets {
 
-template<typename _Type> class bwStylePropertyInternal : public bwStyleProperty {
+/**
+ * Global table of property descriptors. Descriptors are allocated individually and never freed,
+ * so properties can reference them while the table grows.
+ */
+class bwStylePropertyDescriptorTable {
  public:
-  bwStylePropertyInternal(const std::string_view& name, _Type& reference);
-  bwStylePropertyInternal(const std::string_view& name);
+  using Descriptor = bwStyleProperty::Descriptor;
+  using Value = bwStyleProperty::Value;
+
+  static auto get() -> bwStylePropertyDescriptorTable&
+  {
+    static bwStylePropertyDescriptorTable table;
+    return table;
+  }
 
-  void setValue(const _Type& value);
-  auto getValue() const -> const _Type;
+  auto ensure(const bwAtom identifier, const Value& default_value) -> const Descriptor&
+  {
+    const Key key{identifier, default_value};
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex);
+      if (const auto iter = descriptors.find(key); iter != descriptors.end()) {
+        return *iter->second;
+      }
+    }
 
-  _Type default_value{};
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    /* Might have been added while not locked. */
+    std::unique_ptr<Descriptor>& descriptor = descriptors[key];
+    if (!descriptor) {
+      descriptor = std::make_unique<Descriptor>(
+          Descriptor{identifier, bwStyleProperty::Type(default_value.index()), default_value});
+    }
+    return *descriptor;
+  }
 
  private:
-  _Type& reference;
-  // If #bwStylePropertyInternal constructor is called without reference
-  // parameter, this value is used and reference references this.
-  _Type value;
+  struct Key {
+    bwAtom identifier;
+    Value default_value;
+
+    auto operator==(const Key& other) const -> bool
+    {
+      return (identifier == other.identifier) && (default_value == other.default_value);
+    }
+  };
+  struct KeyHash {
+    auto operator()(const Key& key) const -> std::size_t
+    {
+      std::size_t hash = std::hash<bwAtom>()(key.identifier) ^ key.default_value.index();
+      const auto combine = [&hash](std::size_t value) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      };
+
+      std::visit(
+          [&combine](const auto& value) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(value)>, bwColor>) {
+              for (int i = 0; i < 4; i++) {
+                combine(std::hash<float>()(value.getColor()[i]));
+              }
+            }
+            else {
+              combine(std::hash<std::decay_t<decltype(value)>>()(value));
+            }
+          },
+          key.default_value);
+
+      return hash;
+    }
+  };
+
+  std::shared_mutex mutex;
+  std::unordered_map<Key, std::unique_ptr<Descriptor>, KeyHash> descriptors;
 };
 
 // --------------------------------------------------------------------
@@ -51,279 +110,190 @@ static auto property_value_is_copyable(const bwStyleProperty& destination,
   return false;
 }
 
-template<typename _Type> void bwStylePropertyInternal<_Type>::setValue(const _Type& value)
-{
-  reference = value;
-}
-template<typename _Type> auto bwStylePropertyInternal<_Type>::getValue() const -> const _Type
-{
-  return reference;
-}
-
 void bwStyleProperty::setValue(bool value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<bool>&>(*this);
-  assert(type == Type::BOOL);
-  property.setValue(value);
+  assert(getType() == Type::BOOL);
+  *static_cast<bool*>(this->value) = value;
 }
 void bwStyleProperty::setValue(int value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<int>&>(*this);
-  assert(type == Type::INTEGER);
-  property.setValue(value);
+  assert(getType() == Type::INTEGER);
+  *static_cast<int*>(this->value) = value;
 }
 void bwStyleProperty::setValue(float value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<float>&>(*this);
-  assert(type == Type::FLOAT);
-  property.setValue(value);
+  assert(getType() == Type::FLOAT);
+  *static_cast<float*>(this->value) = value;
 }
 void bwStyleProperty::setValue(const bwColor& value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<bwColor>&>(*this);
-  assert(type == Type::COLOR);
-  property.setValue(value);
+  assert(getType() == Type::COLOR);
+  *static_cast<bwColor*>(this->value) = value;
 }
 
-template<typename _Type>
-static void property_copy_value(bwStyleProperty& destination_property_base,
-                                const bwStyleProperty& source_property_base)
+void bwStyleProperty::setValue(const bwStyleProperty& from_property)
 {
-  if (property_value_is_copyable(destination_property_base, source_property_base)) {
-    const auto& from_property = static_cast<const bwStylePropertyInternal<_Type>&>(
-        source_property_base);
-    destination_property_base.setValue(from_property.getValue());
-  }
-  else {
+  if (!property_value_is_copyable(*this, from_property)) {
     throw "Invalid style-property value.";
   }
-}
 
-void bwStyleProperty::setValue(const bwStyleProperty& from_property_base)
-{
-  switch (type) {
+  switch (from_property.getType()) {
     case bwStyleProperty::Type::BOOL:
-      property_copy_value<bool>(*this, from_property_base);
+      setValue(from_property.getValue<bool>());
+      break;
+    case bwStyleProperty::Type::INTEGER:
+      if (getType() == Type::FLOAT) {
+        setValue(float(from_property.getValue<int>()));
+      }
+      else {
+        setValue(from_property.getValue<int>());
+      }
       break;
     case bwStyleProperty::Type::FLOAT:
-      property_copy_value<float>(*this, from_property_base);
+      setValue(from_property.getValue<float>());
       break;
     case bwStyleProperty::Type::COLOR:
-      property_copy_value<bwColor>(*this, from_property_base);
-      break;
-    case bwStyleProperty::Type::INTEGER:
-    default:
-      property_copy_value<int>(*this, from_property_base);
+      setValue(from_property.getValue<bwColor>());
       break;
   }
 }
 
 void bwStyleProperty::setValueToDefault()
 {
-  switch (type) {
-    case bwStyleProperty::Type::BOOL: {
-      auto& property = static_cast<bwStylePropertyInternal<bool>&>(*this);
-      property.setValue(property.default_value);
-      break;
-    }
-    case bwStyleProperty::Type::INTEGER: {
-      auto& property = static_cast<bwStylePropertyInternal<int>&>(*this);
-      property.setValue(property.default_value);
-      break;
-    }
-    case bwStyleProperty::Type::FLOAT: {
-      auto& property = static_cast<bwStylePropertyInternal<float>&>(*this);
-      property.setValue(property.default_value);
-      break;
-    }
-    case bwStyleProperty::Type::COLOR: {
-      auto& property = static_cast<bwStylePropertyInternal<bwColor>&>(*this);
-      property.setValue(property.default_value);
-      break;
-    }
-    default:
-      assert(0);
-      break;
-  }
+  std::visit([this](const auto& default_value) { setValue(default_value); },
+             descriptor->default_value);
+}
+
+/**
+ * Descriptors are shared, so rather than changing the default in it, switch to the descriptor
+ * with the new default.
+ */
+void bwStyleProperty::setDefaultValue(const Value& value)
+{
+  assert(value.index() == std::size_t(getType()));
+  descriptor = &ensureDescriptor(getIdentifier(), value);
 }
 
 void bwStyleProperty::setDefaultValue(bool value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<bool>&>(*this);
-  assert(type == Type::BOOL);
-  property.default_value = value;
+  setDefaultValue(Value(value));
 }
 void bwStyleProperty::setDefaultValue(int value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<int>&>(*this);
-  assert(type == Type::INTEGER);
-  property.default_value = value;
+  setDefaultValue(Value(value));
 }
 void bwStyleProperty::setDefaultValue(float value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<float>&>(*this);
-  assert(type == Type::FLOAT);
-  property.default_value = value;
+  setDefaultValue(Value(value));
 }
 void bwStyleProperty::setDefaultValue(const bwColor& value)
 {
-  auto& property = static_cast<bwStylePropertyInternal<bwColor>&>(*this);
-  assert(type == Type::COLOR);
-  property.default_value = value;
+  setDefaultValue(Value(value));
 }
 
-// --------------------------------------------------------------------
-/**
- * Simple type-trait mechanism to get the right bwStyleProperty::PropType
- * from the data-type of the property (bool, int, bwColor, ...) and vise versa.
- *
- * \{
- */
-
-template<typename> struct PropType;
-
-template<> struct PropType<bool> {
-  const static bwStyleProperty::Type type{bwStyleProperty::Type::BOOL};
-};
-template<> struct PropType<int> {
-  const static bwStyleProperty::Type type{bwStyleProperty::Type::INTEGER};
-};
-template<> struct PropType<float> {
-  const static bwStyleProperty::Type type{bwStyleProperty::Type::FLOAT};
-};
-template<> struct PropType<bwColor> {
-  const static bwStyleProperty::Type type{bwStyleProperty::Type::COLOR};
-};
-
-#if 0
-template<enum bwStyleProperty::PropertyType> struct PropDataType;
-
-template<> struct PropDataType<bwStyleProperty::TYPE_BOOL>
-{
-	using type = bool;
-};
-template<> struct PropDataType<bwStyleProperty::TYPE_INTEGER>
-{
-	using type = int;
-};
-template<> struct PropDataType<bwStyleProperty::TYPE_FLOAT>
-{
-	using type = float;
-};
-template<> struct PropDataType<bwStyleProperty::TYPE_COLOR>
-{
-	using type = bwColor;
-};
-#endif
-
-/** \} */
-
 // --------------------------------------------------------------------
 /**
  * \name Property registration
  * \{
  */
 
-bwStyleProperty::bwStyleProperty(std::string_view identifier, enum Type type)
-    : identifier(std::string(identifier)), type(type)
+bwStyleProperty::bwStyleProperty(const Descriptor& descriptor, void* value)
+    : descriptor(&descriptor), value(value)
 {
 }
 
-template<typename _Type>
-bwStylePropertyInternal<_Type>::bwStylePropertyInternal(const std::string_view& name,
-                                                        _Type& reference)
-    : bwStyleProperty(name, PropType<_Type>::type), reference(reference)
-{
-}
-template<typename _Type>
-bwStylePropertyInternal<_Type>::bwStylePropertyInternal(const std::string_view& name)
-    : bwStyleProperty(name, PropType<_Type>::type), reference(value)
+auto bwStyleProperty::ensureDescriptor(const bwAtom identifier, const Value& default_value)
+    -> const Descriptor&
 {
+  /* The type of a property is the index of its value type in the variant. */
+  static_assert(std::is_same_v<std::variant_alternative_t<int(Type::BOOL), Value>, bool>);
+  static_assert(std::is_same_v<std::variant_alternative_t<int(Type::INTEGER), Value>, int>);
+  static_assert(std::is_same_v<std::variant_alternative_t<int(Type::FLOAT), Value>, float>);
+  static_assert(std::is_same_v<std::variant_alternative_t<int(Type::COLOR), Value>, bwColor>);
+
+  return bwStylePropertyDescriptorTable::get().ensure(identifier, default_value);
 }
 
 template<typename _Type>
-static auto properties_add_property(bwStyleProperties::PropertyList& properties,
-                                    const std::string_view& name,
-                                    _Type& reference) -> bwStyleProperty&
+auto bwStyleProperties::addTypedProperty(const std::string_view& name, _Type& reference)
+    -> bwStyleProperty&
 {
-  properties.push_back(std::make_unique<bwStylePropertyInternal<_Type>>(name, reference));
-  return *properties.back();
+  const bwStyleProperty::Descriptor& descriptor = bwStyleProperty::ensureDescriptor(
+      bwAtom(name), _Type{});
+  return properties.emplace_back(bwStyleProperty(descriptor, &reference));
 }
 template<typename _Type>
-static auto properties_add_property(bwStyleProperties::PropertyList& properties,
-                                    const std::string_view& name) -> bwStyleProperty&
+auto bwStyleProperties::addTypedProperty(const std::string_view& name) -> bwStyleProperty&
 {
-  properties.push_back(std::make_unique<bwStylePropertyInternal<_Type>>(name));
-  return *properties.back();
+  owned_values.emplace_front(_Type{});
+  return addTypedProperty(name, std::get<_Type>(owned_values.front()));
 }
 
 auto bwStyleProperties::addBool(const std::string_view& name, bool& reference) -> bwStyleProperty&
 {
-  return properties_add_property<bool>(properties, name, reference);
+  return addTypedProperty<bool>(name, reference);
 }
 auto bwStyleProperties::addBool(const std::string_view& name) -> bwStyleProperty&
 {
-  return properties_add_property<bool>(properties, name);
+  return addTypedProperty<bool>(name);
 }
 auto bwStyleProperties::addInteger(const std::string_view& name, int& reference)
     -> bwStyleProperty&
 {
-  return properties_add_property<int>(properties, name, reference);
+  return addTypedProperty<int>(name, reference);
 }
 auto bwStyleProperties::addInteger(const std::string_view& name) -> bwStyleProperty&
 {
-  return properties_add_property<int>(properties, name);
+  return addTypedProperty<int>(name);
 }
 auto bwStyleProperties::addFloat(const std::string_view& name, float& reference)
     -> bwStyleProperty&
 {
-  return properties_add_property<float>(properties, name, reference);
+  return addTypedProperty<float>(name, reference);
 }
 auto bwStyleProperties::addFloat(const std::string_view& name) -> bwStyleProperty&
 {
-  return properties_add_property<float>(properties, name);
+  return addTypedProperty<float>(name);
 }
 auto bwStyleProperties::addColor(const std::string_view& name, bwColor& reference)
     -> bwStyleProperty&
 {
-  return properties_add_property<bwColor>(properties, name, reference);
+  return addTypedProperty<bwColor>(name, reference);
 }
 auto bwStyleProperties::addColor(const std::string_view& name) -> bwStyleProperty&
 {
-  return properties_add_property<bwColor>(properties, name);
+  return addTypedProperty<bwColor>(name);
 }
 
 auto bwStyleProperties::addProperty(const std::string_view& name,
                                     const bwStyleProperty::Type prop_type) -> bwStyleProperty&
 {
-  //	properties_add_property<PropDataType<prop_type>::type>(properties, name);
-  //	properties.push_back(std::make_unique<bwStylePropertyInternal<prop_type>(name));
   switch (prop_type) {
     case bwStyleProperty::Type::BOOL:
-      return properties_add_property<bool>(properties, name);
+      return addTypedProperty<bool>(name);
     case bwStyleProperty::Type::INTEGER:
-      return properties_add_property<int>(properties, name);
+      return addTypedProperty<int>(name);
     case bwStyleProperty::Type::FLOAT:
-      return properties_add_property<float>(properties, name);
+      return addTypedProperty<float>(name);
     case bwStyleProperty::Type::COLOR:
-      return properties_add_property<bwColor>(properties, name);
+      return addTypedProperty<bwColor>(name);
   }
 
   assert(0);
-  return properties_add_property<int>(properties, name);
+  return addTypedProperty<int>(name);
 }
 
 /** \} */
 
 // --------------------------------------------------------------------
 
-auto bwStyleProperty::getIdentifier() const -> std::string_view
+auto bwStyleProperty::getIdentifier() const -> bwAtom
 {
-  return identifier;
+  return descriptor->identifier;
 }
 auto bwStyleProperty::getType() const -> bwStyleProperty::Type
 {
-  return type;
+  return descriptor->type;
 }
 
 // --------------------------------------------------------------------
@@ -331,8 +301,18 @@ auto bwStyleProperty::getType() const -> bwStyleProperty::Type
 auto bwStyleProperties::lookup(const std::string_view& name) const -> const bwStyleProperty*
 {
   for (const auto& property : properties) {
-    if (property->getIdentifier() == name) {
-      return property.get();
+    if (property.getIdentifier().str() == name) {
+      return &property;
+    }
+  }
+
+  return nullptr;
+}
+auto bwStyleProperties::lookup(const bwAtom name) const -> const bwStyleProperty*
+{
+  for (const auto& property : properties) {
+    if (property.getIdentifier() == name) {
+      return &property;
     }
   }
 
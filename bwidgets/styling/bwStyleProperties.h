@@ -1,13 +1,14 @@
 #pragma once
 
-#include <memory>
-#include <optional>
-#include <string>
-#include <vector>
+#include <forward_list>
+#include <string_view>
+#include <variant>
 
-namespace bWidgets {
+#include "bwAtom.h"
+#include "bwColor.h"
+#include "bwSmallVector.h"
 
-class bwColor;
+namespace bWidgets {
 
 /**
  * \class bwStyleProperty
@@ -31,9 +32,15 @@ class bwColor;
  * property.setValue(42);
  * assert(some_int == 42);
  * \endcode
+ *
+ * A property only references its value and a descriptor with the identifier, type and default
+ * value. Descriptors are shared by all properties with the same identifier, type and default
+ * value (e.g. the "background-color" property of all buttons), so the property itself is just
+ * two pointers.
  */
 class bwStyleProperty {
-  template<typename> friend class bwStylePropertyInternal;
+  friend class bwStyleProperties;
+  friend class bwStylePropertyDescriptorTable;
 
  public:
   enum class Type {
@@ -50,19 +57,40 @@ class bwStyleProperty {
   void setValue(const bwStyleProperty&);
   void setValueToDefault();
 
+  /** Only changes the default of this property, not of others sharing the same descriptor. */
   void setDefaultValue(bool);
   void setDefaultValue(int);
   void setDefaultValue(float);
   void setDefaultValue(const bwColor&);
 
-  auto getIdentifier() const -> std::string_view;
+  /** The value, with the type matching #getType() (bool, int, float or bwColor). */
+  template<typename _Type> auto getValue() const -> const _Type&
+  {
+    return *static_cast<const _Type*>(value);
+  }
+
+  auto getIdentifier() const -> bwAtom;
   auto getType() const -> Type;
 
  private:
-  bwStyleProperty(std::string_view identifier, enum Type type);
+  using Value = std::variant<bool, int, float, bwColor>;
+
+  /** Immutable, created once for each identifier, type and default value. */
+  struct Descriptor {
+    const bwAtom identifier;
+    const Type type;
+    const Value default_value;
+  };
 
-  const std::string identifier;
-  enum Type type;
+  bwStyleProperty(const Descriptor& descriptor, void* value);
+
+  static auto ensureDescriptor(bwAtom identifier, const Value& default_value)
+      -> const Descriptor&;
+  void setDefaultValue(const Value& value);
+
+  const Descriptor* descriptor;
+  /** Points to a variable of the type matching the descriptor. */
+  void* value;
 };
 
 /**
@@ -73,13 +101,26 @@ class bwStyleProperty {
  * * Add/register new properties (addFoo() functions).
  * * Lookup a property from its identifier (lookup() function).
  * * Get iterators to iterate over all properties.
+ *
+ * Properties are stored inline, so registering the properties of a widget doesn't allocate. Like
+ * with `std::vector`, adding a property invalidates references to the others.
  */
 class bwStyleProperties {
  public:
-  // Store properties as pointer, they are actually created as bwStylePropertyInternal instances.
-  using PropertyList = std::vector<std::unique_ptr<bwStyleProperty>>;
-  using iterator = PropertyList::iterator;
-  using const_iterator = PropertyList::const_iterator;
+  /** Enough for the properties of all built-in widgets. */
+  constexpr static std::size_t INLINE_PROPERTY_COUNT = 8;
+
+  using PropertyList = bwSmallVector<bwStyleProperty, INLINE_PROPERTY_COUNT>;
+  using iterator = bwStyleProperty*;
+  using const_iterator = const bwStyleProperty*;
+
+  bwStyleProperties() = default;
+  /* Properties would still reference the values owned by the original. */
+  bwStyleProperties(const bwStyleProperties&) = delete;
+  auto operator=(const bwStyleProperties&) -> bwStyleProperties& = delete;
+  /* The owned values move along (#owned_values nodes aren't reallocated). */
+  bwStyleProperties(bwStyleProperties&&) = default;
+  auto operator=(bwStyleProperties&&) -> bwStyleProperties& = default;
 
   auto addBool(const std::string_view& name, bool& reference) -> bwStyleProperty&;
   auto addBool(const std::string_view& name) -> bwStyleProperty&;
@@ -93,6 +134,8 @@ class bwStyleProperties {
       -> bwStyleProperty&;
 
   auto lookup(const std::string_view& name) const -> const bwStyleProperty*;
+  /** Faster than looking up by name, only compares the atoms. */
+  auto lookup(bwAtom name) const -> const bwStyleProperty*;
 
   auto begin() -> iterator;
   auto end() -> iterator;
@@ -100,7 +143,14 @@ class bwStyleProperties {
   auto end() const -> const_iterator;
 
  private:
+  template<typename _Type>
+  auto addTypedProperty(const std::string_view& name, _Type& reference) -> bwStyleProperty&;
+  template<typename _Type>
+  auto addTypedProperty(const std::string_view& name) -> bwStyleProperty&;
+
   PropertyList properties{};
+  /** Values of properties not referencing an existing variable. A list, so they don't move. */
+  std::forward_list<bwStyleProperty::Value> owned_values{};
 };
 
 }  // namespace bWidgets
@@ -0,0 +1,82 @@
+#include <iterator>
+
+#include "bwStyleManager.h"
+#include "bwStyleProperties.h"
+
+#include "bwWidgetBaseStyleTable.h"
+
+namespace bWidgets {
+
+bwWidgetBaseStyleTable::bwWidgetBaseStyleTable(const bwWidgetTypeMap<BuildFunc>& build_funcs)
+    : build_funcs(build_funcs)
+{
+}
+
+auto bwWidgetBaseStyleTable::buildBlock(const bwWidget& widget) const -> std::unique_ptr<Block>
+{
+  const BuildFunc* build_func = build_funcs.lookup(widget.getType());
+  if (!build_func) {
+    return nullptr;
+  }
+
+  auto block = std::make_unique<Block>();
+
+  /* Same as setting all style properties of a widget to their default. */
+  bwStyleProperties base_style_properties;
+  block->base_style.registerProperties(base_style_properties);
+  for (auto& property : base_style_properties) {
+    property.setValueToDefault();
+  }
+  (*build_func)(widget.getState(), block->base_style);
+
+  block->has_other_properties =
+      std::distance(widget.style_properties.begin(), widget.style_properties.end()) !=
+      std::distance(base_style_properties.begin(), base_style_properties.end());
+
+  return block;
+}
+
+/** Drop all blocks if they were built for a different style generation or DPI factor. */
+void bwWidgetBaseStyleTable::ensureUpToDate(const float dpi_fac)
+{
+  const unsigned int style_generation = bwStyleManager::getStyleManager().getStyleGeneration();
+  if ((style_generation != built_style_generation) || (dpi_fac != built_dpi_fac)) {
+    blocks.clear();
+    is_built.clear();
+    built_style_generation = style_generation;
+    built_dpi_fac = dpi_fac;
+  }
+}
+
+auto bwWidgetBaseStyleTable::ensureBlock(const bwWidget& widget) -> const Block*
+{
+  const std::size_t index = widget.getType().id * std::size_t(bwWidget::State::STATE_TOT) +
+                            std::size_t(widget.getState());
+  if (index >= blocks.size()) {
+    blocks.resize(bwWidgetType::count() * std::size_t(bwWidget::State::STATE_TOT));
+    is_built.resize(blocks.size());
+  }
+
+  if (!is_built[index]) {
+    blocks[index] = buildBlock(widget);
+    is_built[index] = true;
+  }
+
+  return blocks[index].get();
+}
+
+auto bwWidgetBaseStyleTable::lookup(const bwWidget& widget, const float dpi_fac) -> const Block*
+{
+  ensureUpToDate(dpi_fac);
+  return ensureBlock(widget);
+}
+
+void bwWidgetBaseStyleTable::prepare(const std::vector<bwWidget*>& widgets, const float dpi_fac)
+{
+  ensureUpToDate(dpi_fac);
+  for (const bwWidget* widget : widgets) {
+    ensureBlock(*widget);
+  }
+}
+
+}  // namespace bWidgets
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "bwWidget.h"
+#include "bwWidgetBaseStyle.h"
+#include "bwWidgetType.h"
+
+namespace bWidgets {
+
+/**
+ * \brief Base styles of a style defined in C++, precomputed per widget type and state.
+ *
+ * Such styles give all widgets of a type in a state the same base style. Rather than computing
+ * it for each widget on each redraw, the style builds it once here (a block), and just copies
+ * the block into the widget.
+ *
+ * Blocks are built on first use, and rebuilt once the style generation (see
+ * \ref bwStyleManager::getStyleGeneration()) or the DPI factor changed.
+ *
+ * \note Lookups build blocks, so they are not thread-safe. Unless the blocks were built up front
+ *       with #prepare(), then looking them up only reads.
+ */
+class bwWidgetBaseStyleTable {
+ public:
+  /**
+   * Set the base style for widgets in \a state. \a r_base_style has all style property values
+   * set to their default when called.
+   */
+  using BuildFunc = void (*)(bwWidget::State state, bwWidgetBaseStyle& r_base_style);
+
+  struct Block {
+    bwWidgetBaseStyle base_style;
+    /** Widgets of the type have style properties not stored in the base style. These still
+     * have to be set to their default when applying the block. */
+    bool has_other_properties;
+  };
+
+  /**
+   * \param build_funcs: The function building the base style for each widget type. Types without
+   *                     own function use the one of their closest ancestor.
+   */
+  explicit bwWidgetBaseStyleTable(const bwWidgetTypeMap<BuildFunc>& build_funcs);
+
+  /**
+   * \return The block for the type and state of \a widget, or null if there's no build function
+   *         for its type.
+   */
+  auto lookup(const bwWidget& widget, float dpi_fac) -> const Block*;
+  /**
+   * Build the blocks for \a widgets, so they can be looked up from multiple threads at once
+   * (with the same \a dpi_fac and style generation).
+   */
+  void prepare(const std::vector<bwWidget*>& widgets, float dpi_fac);
+
+ private:
+  auto buildBlock(const bwWidget& widget) const -> std::unique_ptr<Block>;
+  void ensureUpToDate(float dpi_fac);
+  auto ensureBlock(const bwWidget& widget) -> const Block*;
+
+  const bwWidgetTypeMap<BuildFunc>& build_funcs;
+  /** Indexed by widget type ID and state. */
+  std::vector<std::unique_ptr<Block>> blocks;
+  /** If the block of the same index was built already (it may be null). */
+  std::vector<bool> is_built;
+
+  unsigned int built_style_generation{0};
+  float built_dpi_fac{0.0f};
+};
+
+}  // namespace bWidgets
@@ -7,7 +7,7 @@
 
 namespace bWidgets {
 
-static void widget_base_style_checkbox_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_checkbox_set(bwWidget::State state, bwWidgetBaseStyle& r_base_style)
 {
   r_base_style.background_color = 0.27451f;
   r_base_style.text_color = 0.0f;
@@ -17,7 +17,7 @@ static void widget_base_style_checkbox_set(bwWidget& widget, bwWidgetBaseStyle&
   r_base_style.shade_bottom = -15;
   r_base_style.corner_radius = 4.0f;
 
-  switch (widget.getState()) {
+  switch (state) {
     case bwWidget::State::HIGHLIGHTED:
       r_base_style.background_color.shade(0.06f);
       break;
@@ -29,7 +29,8 @@ static void widget_base_style_checkbox_set(bwWidget& widget, bwWidgetBaseStyle&
       break;
   }
 }
-static void widget_base_style_number_slider_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_number_slider_set(bwWidget::State state,
+                                                bwWidgetBaseStyle& r_base_style)
 {
   r_base_style.background_color = 180u;
   r_base_style.text_color = 0.0f;
@@ -39,7 +40,7 @@ static void widget_base_style_number_slider_set(bwWidget& widget, bwWidgetBaseSt
   r_base_style.shade_bottom = 0;
   r_base_style.corner_radius = 10.0f;
 
-  switch (widget.getState()) {
+  switch (state) {
     case bwWidget::State::HIGHLIGHTED:
       r_base_style.background_color.shade(0.06f);
       break;
@@ -51,7 +52,8 @@ static void widget_base_style_number_slider_set(bwWidget& widget, bwWidgetBaseSt
       break;
   }
 }
-static void widget_base_style_push_button_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_push_button_set(bwWidget::State state,
+                                              bwWidgetBaseStyle& r_base_style)
 {
   r_base_style.background_color = 0.6f;
   r_base_style.text_color = 0.0f;
@@ -60,7 +62,7 @@ static void widget_base_style_push_button_set(bwWidget& widget, bwWidgetBaseStyl
   r_base_style.shade_bottom = -15;
   r_base_style.corner_radius = 5.0f;
 
-  switch (widget.getState()) {
+  switch (state) {
     case bwWidget::State::HIGHLIGHTED:
       r_base_style.background_color.shade(0.06f);
       break;
@@ -73,7 +75,8 @@ static void widget_base_style_push_button_set(bwWidget& widget, bwWidgetBaseStyl
       break;
   }
 }
-static void widget_base_style_radio_button_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_radio_button_set(bwWidget::State state,
+                                               bwWidgetBaseStyle& r_base_style)
 {
   r_base_style.background_color = 0.27451f;
   r_base_style.text_color = 1.0f;
@@ -83,7 +86,7 @@ static void widget_base_style_radio_button_set(bwWidget& widget, bwWidgetBaseSty
   r_base_style.text_alignment = TextAlignment::CENTER;
   r_base_style.corner_radius = 4.0f;
 
-  switch (widget.getState()) {
+  switch (state) {
     case bwWidget::State::HIGHLIGHTED:
       r_base_style.background_color.shade(0.06f);
       break;
@@ -96,7 +99,8 @@ static void widget_base_style_radio_button_set(bwWidget& widget, bwWidgetBaseSty
       break;
   }
 }
-static void widget_base_style_scroll_bar_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_scroll_bar_set(bwWidget::State state,
+                                             bwWidgetBaseStyle& r_base_style)
 {
   r_base_style.background_color = bwColor(80u, 180u);
   r_base_style.text_color = 0.0f;
@@ -106,7 +110,7 @@ static void widget_base_style_scroll_bar_set(bwWidget& widget, bwWidgetBaseStyle
   r_base_style.shade_bottom = -5;
   r_base_style.corner_radius = 6.5f;
 
-  switch (widget.getState()) {
+  switch (state) {
     case bwWidget::State::SUNKEN:
       r_base_style.decoration_color.shade(5u);
       r_base_style.text_color = 1.0f;
@@ -115,7 +119,7 @@ static void widget_base_style_scroll_bar_set(bwWidget& widget, bwWidgetBaseStyle
       break;
   }
 }
-static void widget_base_style_text_box_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_text_box_set(bwWidget::State state, bwWidgetBaseStyle& r_base_style)
 {
   r_base_style.background_color = 0.6f;
   r_base_style.text_color = 0.0f;
@@ -125,7 +129,7 @@ static void widget_base_style_text_box_set(bwWidget& widget, bwWidgetBaseStyle&
   r_base_style.shade_bottom = 25;
   r_base_style.corner_radius = 4.0f;
 
-  switch (widget.getState()) {
+  switch (state) {
     case bwWidget::State::HIGHLIGHTED:
       r_base_style.background_color.shade(0.06f);
     case bwWidget::State::SUNKEN:
@@ -135,17 +139,13 @@ static void widget_base_style_text_box_set(bwWidget& widget, bwWidgetBaseStyle&
       break;
   }
 }
-static void widget_base_style_panel_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_panel_set(bwWidget::State, bwWidgetBaseStyle& r_base_style)
 {
-  bwPanel& panel = *widget_cast<bwPanel>(widget);
-
   r_base_style.background_color = 114u;
   r_base_style.border_color = 114u;
-
-  panel.draw_separator = true;
 }
 
-static void widget_base_style_scrollview_set(bwWidget&, bwWidgetBaseStyle& r_base_style)
+static void widget_base_style_scrollview_set(bwWidget::State, bwWidgetBaseStyle& r_base_style)
 {
   r_base_style.background_color = 114u;
   r_base_style.border_color = 114u;
@@ -154,73 +154,87 @@ static void widget_base_style_scrollview_set(bwWidget&, bwWidgetBaseStyle& r_bas
 static void widget_style_properties_set_to_default(bwWidget& widget)
 {
   for (auto& property : widget.style_properties) {
-    property->setValueToDefault();
+    property.setValueToDefault();
   }
 }
 
-static void widget_base_style_set(bwWidget& widget, bwWidgetBaseStyle& r_base_style)
+/**
+ * The function to build the base style with, for each widget type. Widget types without own
+ * entry use the one of their closest ancestor (e.g. bwNumberSlider doesn't use the bwTextBox one).
+ */
+static auto base_style_build_funcs() -> const bwWidgetTypeMap<bwWidgetBaseStyleTable::BuildFunc>&
 {
-  /* Anti-pattern/code-smell: This kind of widget_cast<>() usage to eventually find the correct
-   * type is rather inefficient (compared to an enum type checked in a switch).
-   * This isn't performance critical code, so it's fine-ish, even if ugly. More importantly, this
-   * way of applying styles isn't meant as permanent solution anyway. */
-  if (widget_cast<bwCheckbox>(widget)) {
-    widget_base_style_checkbox_set(widget, r_base_style);
-  }
-  else if (widget_cast<bwNumberSlider>(widget)) {
-    widget_base_style_number_slider_set(widget, r_base_style);
-  }
-  else if (widget_cast<bwPushButton>(widget)) {
-    widget_base_style_push_button_set(widget, r_base_style);
-  }
-  else if (widget_cast<bwRadioButton>(widget)) {
-    widget_base_style_radio_button_set(widget, r_base_style);
-  }
-  else if (widget_cast<bwScrollBar>(widget)) {
-    widget_base_style_scroll_bar_set(widget, r_base_style);
-  }
-  else if (widget_cast<bwTextBox>(widget)) {
-    widget_base_style_text_box_set(widget, r_base_style);
-  }
-  else if (widget_cast<bwPanel>(widget)) {
-    widget_base_style_panel_set(widget, r_base_style);
-  }
-  else if (widget_cast<bwScrollView>(widget)) {
-    widget_base_style_scrollview_set(widget, r_base_style);
-  }
+  static const bwWidgetTypeMap<bwWidgetBaseStyleTable::BuildFunc> funcs = []() {
+    bwWidgetTypeMap<bwWidgetBaseStyleTable::BuildFunc> funcs;
+    funcs.add<bwCheckbox>(widget_base_style_checkbox_set);
+    funcs.add<bwNumberSlider>(widget_base_style_number_slider_set);
+    funcs.add<bwPushButton>(widget_base_style_push_button_set);
+    funcs.add<bwRadioButton>(widget_base_style_radio_button_set);
+    funcs.add<bwScrollBar>(widget_base_style_scroll_bar_set);
+    funcs.add<bwTextBox>(widget_base_style_text_box_set);
+    funcs.add<bwPanel>(widget_base_style_panel_set);
+    funcs.add<bwScrollView>(widget_base_style_scrollview_set);
+    return funcs;
+  }();
+
+  return funcs;
 }
 
-bwStyleClassic::bwStyleClassic() : bwStyle(TypeID::CLASSIC)
+bwStyleClassic::bwStyleClassic()
+    : bwStyle(TypeID::CLASSIC), base_style_table(base_style_build_funcs())
 {
 }
 
-void bwStyleClassic::setWidgetStyle(bwWidget& widget)
+/**
+ * Styling only reads the base style table once it's prepared, and writes to the styled widget.
+ */
+auto bwStyleClassic::canSetWidgetStylesConcurrently() const -> bool
 {
-  bwWidgetBaseStyle* base_style = nullptr;
+  return true;
+}
+
+void bwStyleClassic::prepareWidgetStyles(const std::vector<bwWidget*>& widgets)
+{
+  base_style_table.prepare(widgets, dpi_fac);
+}
 
+void bwStyleClassic::setWidgetStyle(bwWidget& widget)
+{
   polish(widget);
 
-  if (auto* button = widget_cast<bwAbstractButton>(widget)) {
-    button->base_style.roundbox_corners = button->rounded_corners;
-    base_style = &button->base_style;
+  const bwWidgetBaseStyleTable::Block* block = base_style_table.lookup(widget, dpi_fac);
+  if (!block || block->has_other_properties) {
+    widget_style_properties_set_to_default(widget);
   }
-  else if (auto* text_box = widget_cast<bwTextBox>(widget)) {
-    text_box->base_style.roundbox_corners =
+
+  if (widget_is<bwAbstractButton>(widget)) {
+    auto& button = static_cast<bwAbstractButton&>(widget);
+    if (block) {
+      button.base_style = block->base_style;
+    }
+    button.base_style.roundbox_corners = button.rounded_corners;
+  }
+  else if (widget_is<bwTextBox>(widget)) {
+    auto& text_box = static_cast<bwTextBox&>(widget);
+    if (block) {
+      text_box.base_style = block->base_style;
+    }
+    text_box.base_style.roundbox_corners =
         RoundboxCorner::ALL;  // XXX Incorrect, should set this in layout.
-    base_style = &text_box->base_style;
   }
-  else if (auto* container = widget_cast<bwContainerWidget>(widget)) {
-    container->base_style.roundbox_corners = RoundboxCorner::ALL;
-    base_style = &container->base_style;
+  else if (widget_is<bwContainerWidget>(widget)) {
+    auto& container = static_cast<bwContainerWidget&>(widget);
+    if (block) {
+      container.base_style = block->base_style;
+    }
+    container.base_style.roundbox_corners = RoundboxCorner::ALL;
   }
   else {
     // base_style->roundbox_corners = RoundboxCorner::ALL;
   }
 
-  widget_style_properties_set_to_default(widget);
-
-  if (base_style) {
-    widget_base_style_set(widget, *base_style);
+  if (widget_is<bwPanel>(widget)) {
+    static_cast<bwPanel&>(widget).draw_separator = true;
   }
 }
 
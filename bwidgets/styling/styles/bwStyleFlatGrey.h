@@ -1,6 +1,7 @@
 #pragma once
 
 #include "bwStyle.h"
+#include "bwWidgetBaseStyleTable.h"
 
 namespace bWidgets {
 
@@ -9,6 +10,11 @@ class bwStyleFlat : public bwStyle {
   bwStyleFlat();
 
   void setWidgetStyle(class bwWidget& widget) override;
+  auto canSetWidgetStylesConcurrently() const -> bool override;
+  void prepareWidgetStyles(const std::vector<bwWidget*>& widgets) override;
+
+ private:
+  bwWidgetBaseStyleTable base_style_table;
 };
 
 }  // namespace bWidgets
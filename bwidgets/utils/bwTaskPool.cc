@@ -0,0 +1,255 @@
+#include <chrono>
+
+#include "bwTaskPool.h"
+
+namespace bWidgets {
+
+static std::atomic<bwExecutor*> global_executor{nullptr};
+
+/** The pool the calling thread is a worker of, if any. */
+static thread_local const bwTaskPool* current_pool = nullptr;
+static thread_local int current_worker_index = -1;
+
+auto bwExecutor::getGlobal() -> bwExecutor&
+{
+  if (bwExecutor* executor = global_executor.load(std::memory_order_acquire)) {
+    return *executor;
+  }
+
+  /* Only created if the application didn't supply its own executor. */
+  static bwTaskPool default_pool;
+  return default_pool;
+}
+
+void bwExecutor::setGlobal(bwExecutor* executor)
+{
+  global_executor.store(executor, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------- */
+
+void bwSerialExecutor::execute(Task task)
+{
+  task();
+}
+
+auto bwSerialExecutor::getConcurrency() const -> unsigned int
+{
+  return 1;
+}
+
+/* -------------------------------------------------------------------- */
+
+bwTaskPool::bwTaskPool(unsigned int thread_count)
+{
+  /* Without workers, there still needs to be a queue for the tasks to wait in. */
+  queues.resize(std::max(thread_count, 1u));
+  for (std::unique_ptr<WorkerQueue>& queue : queues) {
+    queue = std::make_unique<WorkerQueue>();
+  }
+
+  threads.reserve(thread_count);
+  for (unsigned int i = 0; i < thread_count; i++) {
+    threads.emplace_back(&bwTaskPool::workerMain, this, i);
+  }
+}
+
+bwTaskPool::~bwTaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stop = true;
+  }
+  wakeup.notify_all();
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  /* Without workers, nobody else is going to run them. */
+  while (tryRunPendingTask()) {
+  }
+}
+
+auto bwTaskPool::getDefaultThreadCount() -> unsigned int
+{
+  return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+}
+
+auto bwTaskPool::getThreadCount() const -> unsigned int
+{
+  return threads.size();
+}
+
+auto bwTaskPool::getConcurrency() const -> unsigned int
+{
+  return threads.size() + 1;
+}
+
+auto bwTaskPool::getCurrentWorkerIndex() const -> int
+{
+  return (current_pool == this) ? current_worker_index : -1;
+}
+
+void bwTaskPool::execute(Task task)
+{
+  const int worker_index = getCurrentWorkerIndex();
+  const unsigned int queue_index = (worker_index >= 0) ?
+                                       worker_index :
+                                       (next_queue.fetch_add(1, std::memory_order_relaxed) %
+                                        queues.size());
+  WorkerQueue& queue = *queues[queue_index];
+
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+    queued_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /* Lock so a worker can't miss the notification between checking for tasks and going to
+   * sleep. */
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+  }
+  wakeup.notify_one();
+}
+
+auto bwTaskPool::popTask(Task& r_task) -> bool
+{
+  if (queued_count.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+
+  const int worker_index = getCurrentWorkerIndex();
+  if (worker_index >= 0) {
+    WorkerQueue& queue = *queues[worker_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      r_task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      queued_count.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  /* Steal, starting at the next queue so thieves spread over the queues. */
+  const unsigned int queue_count = queues.size();
+  const unsigned int start = (worker_index >= 0) ? (worker_index + 1) : 0;
+  for (unsigned int i = 0; i < queue_count; i++) {
+    WorkerQueue& queue = *queues[(start + i) % queue_count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      r_task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      queued_count.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+auto bwTaskPool::tryRunPendingTask() -> bool
+{
+  Task task;
+  if (!popTask(task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void bwTaskPool::workerMain(unsigned int worker_index)
+{
+  current_pool = this;
+  current_worker_index = worker_index;
+
+  while (true) {
+    if (tryRunPendingTask()) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    wakeup.wait(lock, [this]() {
+      return stop || (queued_count.load(std::memory_order_relaxed) > 0);
+    });
+    if (stop && (queued_count.load(std::memory_order_relaxed) == 0)) {
+      return;
+    }
+  }
+}
+
+/* -------------------------------------------------------------------- */
+
+bwTaskGroup::bwTaskGroup(bwExecutor& executor) : executor(executor)
+{
+}
+
+bwTaskGroup::~bwTaskGroup()
+{
+  waitForTasks();
+}
+
+void bwTaskGroup::run(bwExecutor::Task task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  executor.execute([this, task = std::move(task)]() {
+    std::exception_ptr task_exception;
+    try {
+      task();
+    }
+    catch (...) {
+      task_exception = std::current_exception();
+    }
+
+    /* Unlocking the mutex publishes the task's writes to the waiting thread, which locks it
+     * before returning. Notify with the mutex still locked, once it's unlocked the group may be
+     * destructed. */
+    std::lock_guard<std::mutex> lock(mutex);
+    if (task_exception && !exception) {
+      exception = task_exception;
+    }
+    if (pending_count.fetch_sub(1, std::memory_order_relaxed) == 1) {
+      finished.notify_all();
+    }
+  });
+}
+
+void bwTaskGroup::waitForTasks()
+{
+  while (true) {
+    /* Help instead of blocking, the tasks of this group may be waiting in a queue. */
+    if ((pending_count.load(std::memory_order_relaxed) > 0) && executor.tryRunPendingTask()) {
+      continue;
+    }
+
+    /* Always check with the mutex locked, see the memory model described in the header. */
+    std::unique_lock<std::mutex> lock(mutex);
+    if (pending_count.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    /* Time out to help again, running tasks may queue more work (e.g. nested groups). */
+    finished.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+      return pending_count.load(std::memory_order_relaxed) == 0;
+    });
+  }
+}
+
+void bwTaskGroup::wait()
+{
+  waitForTasks();
+
+  std::exception_ptr task_exception;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::swap(task_exception, exception);
+  }
+  if (task_exception) {
+    std::rethrow_exception(task_exception);
+  }
+}
+
+}  // namespace bWidgets
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bWidgets {
+
+/**
+ * \brief Runs tasks asynchronously, the interface bWidgets subsystems submit their work to.
+ *
+ * bWidgets uses a single executor for all of its parallel work (see #getGlobal()). By default
+ * that's a \ref bwTaskPool, but an application with its own thread pool or job system can supply
+ * it with #setGlobal(), so bWidgets doesn't compete with it for cores.
+ *
+ * Tasks must not throw, use \ref bwTaskGroup to get exceptions back to the waiting thread.
+ */
+class bwExecutor {
+ public:
+  using Task = std::function<void()>;
+
+  virtual ~bwExecutor() = default;
+
+  /** Run \a task at some point, on any thread (including the calling one). */
+  virtual void execute(Task task) = 0;
+  /**
+   * Run a queued task on the calling thread, if there is one. Threads waiting for tasks call
+   * this to help, rather than blocking. Executors that can't do this just return false.
+   * \return True if a task was run.
+   */
+  virtual auto tryRunPendingTask() -> bool
+  {
+    return false;
+  }
+  /** Number of tasks that can run in parallel, to decide how finely to split work. */
+  virtual auto getConcurrency() const -> unsigned int = 0;
+
+  /** The executor bWidgets submits its work to. A \ref bwTaskPool, unless the application
+   * supplied its own. */
+  static auto getGlobal() -> bwExecutor&;
+  /**
+   * Let bWidgets submit its work to \a executor. Pass null to go back to the default pool. The
+   * executor has to outlive all work submitted to it, don't change it while tasks are running.
+   */
+  static void setGlobal(bwExecutor* executor);
+};
+
+/**
+ * \brief Runs tasks right away on the calling thread.
+ *
+ * For single-threaded applications, and to get deterministic behavior when debugging.
+ */
+class bwSerialExecutor : public bwExecutor {
+ public:
+  void execute(Task task) override;
+  auto getConcurrency() const -> unsigned int override;
+};
+
+/**
+ * \brief Small work-stealing thread pool.
+ *
+ * Each worker thread has its own task queue. Tasks submitted from a worker (i.e. nested tasks) go
+ * to the back of its own queue, which it processes last-in-first-out, so recently submitted (and
+ * likely still cached) work runs first. Tasks submitted from other threads are distributed over
+ * the queues. A worker running out of tasks steals the oldest task from the front of another
+ * worker's queue, which tends to be the biggest chunk of work remaining.
+ *
+ * Queues are protected by a mutex each, so workers only contend when stealing. The tasks this is
+ * meant for (layout, style or paint work for a number of widgets) are much more expensive than
+ * that.
+ */
+class bwTaskPool : public bwExecutor {
+ public:
+  /** \param thread_count: Number of worker threads. With 0, tasks only run while a thread waits
+   *                       for them (see #tryRunPendingTask()). */
+  explicit bwTaskPool(unsigned int thread_count = getDefaultThreadCount());
+  /** Runs all queued tasks, then joins the worker threads. */
+  ~bwTaskPool() override;
+
+  bwTaskPool(const bwTaskPool&) = delete;
+  auto operator=(const bwTaskPool&) -> bwTaskPool& = delete;
+
+  void execute(Task task) override;
+  auto tryRunPendingTask() -> bool override;
+  /** Number of worker threads, plus the thread waiting for the tasks. */
+  auto getConcurrency() const -> unsigned int override;
+
+  auto getThreadCount() const -> unsigned int;
+  /** One less than the number of hardware threads, since the thread submitting the work helps
+   * while waiting for it. */
+  static auto getDefaultThreadCount() -> unsigned int;
+
+ private:
+  struct alignas(64) WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void workerMain(unsigned int worker_index);
+  /** Pop from the back of the own queue (if the calling thread is a worker of this pool), then
+   * steal from the front of the others. */
+  auto popTask(Task& r_task) -> bool;
+  auto getCurrentWorkerIndex() const -> int;
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::vector<std::thread> threads;
+  /** Queue the next task submitted from outside the pool goes to. */
+  std::atomic<unsigned int> next_queue{0};
+  /** Tasks queued, but not popped yet. */
+  std::atomic<unsigned int> queued_count{0};
+
+  std::mutex sleep_mutex;
+  std::condition_variable wakeup;
+  bool stop{false};
+};
+
+/**
+ * \brief A set of tasks to wait for together.
+ *
+ * Memory model: everything the tasks of a group write happens-before #wait() returns. So once
+ * it returned, the waiting thread (usually the UI thread) can read the results without further
+ * synchronization. Tasks should write their results into memory only they access (e.g. one slot
+ * per index), and must not modify the screen-graph or other UI state directly. That is for the UI
+ * thread to do, once the results are published this way.
+ *
+ * Groups can be nested: tasks may run groups of their own and wait for them.
+ */
+class bwTaskGroup {
+ public:
+  explicit bwTaskGroup(bwExecutor& executor = bwExecutor::getGlobal());
+  /** Waits for the remaining tasks, but doesn't rethrow their exceptions. */
+  ~bwTaskGroup();
+
+  bwTaskGroup(const bwTaskGroup&) = delete;
+  auto operator=(const bwTaskGroup&) -> bwTaskGroup& = delete;
+
+  void run(bwExecutor::Task task);
+  /**
+   * Wait until all tasks run so far are finished, helping to run queued tasks meanwhile.
+   * Rethrows the first exception thrown by a task, if any.
+   */
+  void wait();
+
+ private:
+  void waitForTasks();
+
+  bwExecutor& executor;
+  /** Only modified with #mutex locked, atomic so #wait() can check it without locking. */
+  std::atomic<unsigned int> pending_count{0};
+  std::mutex mutex;
+  std::condition_variable finished;
+  std::exception_ptr exception;
+};
+
+/**
+ * Call \a func for sub-ranges of [\a begin, \a end) in parallel and wait for all calls to finish.
+ * The range is split into chunks of at least \a grain_size indices, pick it so a chunk is worth
+ * the overhead of a task (a few microseconds of work). The calling thread processes chunks too.
+ * Same memory model as \ref bwTaskGroup.
+ *
+ * \param func: Called as `func(chunk_begin, chunk_end)`.
+ */
+template<typename _Func>
+void bwParallelFor(std::size_t begin,
+                   std::size_t end,
+                   std::size_t grain_size,
+                   const _Func& func,
+                   bwExecutor& executor = bwExecutor::getGlobal())
+{
+  if (begin >= end) {
+    return;
+  }
+  const std::size_t size = end - begin;
+  const std::size_t concurrency = executor.getConcurrency();
+  /* A few chunks per thread, so threads finishing early can steal some. */
+  const std::size_t max_chunk_count = concurrency * 4;
+  std::size_t chunk_size = std::max<std::size_t>(grain_size, 1);
+  chunk_size = std::max(chunk_size, (size + max_chunk_count - 1) / max_chunk_count);
+
+  if ((concurrency <= 1) || (chunk_size >= size)) {
+    func(begin, end);
+    return;
+  }
+
+  bwTaskGroup group(executor);
+  std::size_t chunk_begin = begin;
+  for (; (end - chunk_begin) > chunk_size; chunk_begin += chunk_size) {
+    group.run([&func, chunk_begin, chunk_size]() { func(chunk_begin, chunk_begin + chunk_size); });
+  }
+  /* The last chunk runs on the calling thread. Exceptions still wait for the other chunks
+   * (they reference \a func), see ~bwTaskGroup(). */
+  func(chunk_begin, end);
+  group.wait();
+}
+
+}  // namespace bWidgets
@@ -16,6 +16,17 @@ bwAbstractButton::bwAbstractButton(const std::string& text,
   initialize();
 }
 
+auto bwAbstractButton::staticType() -> const bwWidgetType&
+{
+  static const bwWidgetType type{"bwAbstractButton", &bwWidget::staticType()};
+  return type;
+}
+
+auto bwAbstractButton::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
 void bwAbstractButton::draw(bwStyle& style)
 {
   const bwGradient gradient{
@@ -42,6 +53,7 @@ auto bwAbstractButton::getLabel() const -> const std::string*
 auto bwAbstractButton::setLabel(const std::string& label) -> bwAbstractButton&
 {
   text = label;
+  requestRedraw();
   return *this;
 }
 
@@ -16,6 +16,9 @@ class bwIconInterface;
  */
 class bwAbstractButton : public bwWidget {
  public:
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+
   void draw(class bwStyle& style) override;
   void registerProperties() override;
 
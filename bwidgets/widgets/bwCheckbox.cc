@@ -15,9 +15,21 @@ bwCheckbox::bwCheckbox(const std::string& text,
 {
 }
 
-auto bwCheckbox::getTypeIdentifier() const -> std::string_view
+auto bwCheckbox::staticType() -> const bwWidgetType&
 {
-  return "bwCheckbox";
+  static const bwWidgetType type{"bwCheckbox", &bwAbstractButton::staticType()};
+  return type;
+}
+
+auto bwCheckbox::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwCheckbox::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwCheckbox");
+  return identifier;
 }
 
 void bwCheckbox::draw(bwStyle& style)
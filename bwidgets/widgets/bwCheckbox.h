@@ -10,7 +10,9 @@ class bwCheckbox : public bwAbstractButton {
              std::optional<unsigned int> width_hint = std::nullopt,
              std::optional<unsigned int> height_hint = std::nullopt);
 
-  auto getTypeIdentifier() const -> std::string_view override;
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+  auto getTypeIdentifier() const -> bwAtom override;
 
   void draw(class bwStyle& style) override;
 
@@ -10,6 +10,17 @@ bwContainerWidget::bwContainerWidget(const bwScreenGraph::ContainerNode& node,
   initialize();
 }
 
+auto bwContainerWidget::staticType() -> const bwWidgetType&
+{
+  static const bwWidgetType type{"bwContainerWidget", &bwWidget::staticType()};
+  return type;
+}
+
+auto bwContainerWidget::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
 auto bwContainerWidget::getMaskRectangle() -> bwRectanglePixel
 {
   bwRectanglePixel maskrect = rectangle;
@@ -30,6 +41,16 @@ auto bwContainerWidget::childrenVisible() const -> bool
   return true;
 }
 
+/**
+ * Offset to apply to all children when drawing and handling events. Containers that scroll their
+ * children can return the scroll distance, so the layout of children doesn't have to be
+ * recalculated for scrolling.
+ */
+auto bwContainerWidget::getContentOffset() const -> bwPoint
+{
+  return {};
+}
+
 void bwContainerWidget::registerProperties()
 {
   base_style.registerProperties(style_properties);
@@ -11,8 +11,12 @@ class ContainerNode;
 
 class bwContainerWidget : public bwWidget {
  public:
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+
   virtual auto getMaskRectangle() -> bwRectanglePixel;
   virtual auto childrenVisible() const -> bool;
+  virtual auto getContentOffset() const -> bwPoint;
 
   void registerProperties() override;
 
@@ -15,9 +15,21 @@ bwLabel::bwLabel(std::string text,
   initialize();
 }
 
-auto bwLabel::getTypeIdentifier() const -> std::string_view
+auto bwLabel::staticType() -> const bwWidgetType&
 {
-  return "bwLabel";
+  static const bwWidgetType type{"bwLabel", &bwWidget::staticType()};
+  return type;
+}
+
+auto bwLabel::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwLabel::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwLabel");
+  return identifier;
 }
 
 void bwLabel::draw(bwStyle& style)
@@ -42,6 +54,7 @@ auto bwLabel::getLabel() const -> const std::string*
 auto bwLabel::setLabel(const std::string& label) -> bwLabel&
 {
   text = label;
+  requestRedraw();
   return *this;
 }
 
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/Node.h"
+
+#include "bwListView.h"
+
+namespace bWidgets {
+
+bwListView::bwListView(bwScreenGraph::ContainerNode& node,
+                       unsigned int row_count,
+                       unsigned int row_height,
+                       RowCreateFunc create_row_func,
+                       RowBindFunc bind_row_func,
+                       unsigned int width,
+                       unsigned int height)
+    : bwScrollView(node, width, height),
+      list_node(node),
+      row_count(row_count),
+      row_height(row_height),
+      create_row_func(create_row_func),
+      bind_row_func(bind_row_func)
+{
+  assert(row_height > 0);
+}
+
+auto bwListView::staticType() -> const bwWidgetType&
+{
+  static const bwWidgetType type{"bwListView", &bwScrollView::staticType()};
+  return type;
+}
+
+auto bwListView::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwListView::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwListView");
+  return identifier;
+}
+
+auto bwListView::setRowCount(unsigned int value) -> bwListView&
+{
+  if (row_count != value) {
+    row_count = value;
+    rebindRows();
+    invalidateLayout();
+  }
+  return *this;
+}
+
+auto bwListView::getRowCount() const -> unsigned int
+{
+  return row_count;
+}
+
+auto bwListView::getRowHeight(float _interface_scale) const -> int
+{
+  return std::max(1, int(std::round(row_height * _interface_scale)));
+}
+
+/**
+ * The height all rows would take up if they were placed below each other.
+ */
+auto bwListView::getContentHeight(float _interface_scale) const -> int
+{
+  return int(row_count) * getRowHeight(_interface_scale);
+}
+
+/**
+ * \brief Assign the row widgets to the rows in view and place them.
+ *
+ * Only binds widgets to new rows if they don't show that row already. So when scrolling, only the
+ * rows that scrolled into view are bound. Must be called whenever the layout placed the list view,
+ * scrolling calls it already.
+ */
+void bwListView::updateRows(float _interface_scale)
+{
+  interface_scale = _interface_scale;
+
+  const bwRectanglePixel content_rect = node.ContentRectangle();
+  const int row_height_px = getRowHeight(interface_scale);
+  const int view_height = std::max(0, rectangle.height());
+  /* Distance from the top of the content to the top of the visible region. */
+  const int scrolled_dist = std::max(0, content_rect.ymax - rectangle.ymax + getScrollOffsetY());
+
+  /* Enough widgets to cover the view with a row partially visible at the top and bottom. */
+  ensureRowWidgetCount((view_height / row_height_px) + 2 + (2 * OVERSCAN_ROWS));
+
+  const unsigned int first_visible = scrolled_dist / row_height_px;
+  const unsigned int end_visible = (scrolled_dist + view_height + row_height_px - 1) /
+                                   row_height_px;
+  const unsigned int first_row = first_visible - std::min(first_visible, OVERSCAN_ROWS);
+  const unsigned int end_row = std::min(row_count, end_visible + OVERSCAN_ROWS);
+  const unsigned int widget_count = row_widgets.size();
+
+  for (unsigned int i = 0; i < widget_count; i++) {
+    bwWidget& row_widget = *row_widgets[i];
+    /* The row in range that maps to this widget (see #row_widgets). */
+    const unsigned int row_index = first_row + ((i + widget_count - (first_row % widget_count)) %
+                                                widget_count);
+
+    if (row_index >= end_row) {
+      /* Not needed currently. With an empty rectangle it's neither drawn nor hit-tested. */
+      row_widget.rectangle = bwRectanglePixel();
+      continue;
+    }
+
+    if (bound_rows[i] != row_index) {
+      bind_row_func(row_widget, row_index);
+      bound_rows[i] = row_index;
+    }
+    row_widget.rectangle.set(content_rect.xmin,
+                             content_rect.width(),
+                             content_rect.ymax - int(row_index + 1) * row_height_px,
+                             row_height_px);
+  }
+}
+
+/**
+ * Force binding all rows again on the next #updateRows() call, e.g. because the data they
+ * display changed.
+ */
+void bwListView::rebindRows()
+{
+  std::fill(bound_rows.begin(), bound_rows.end(), std::nullopt);
+}
+
+void bwListView::onScrollValueChange()
+{
+  updateRows(interface_scale);
+}
+
+void bwListView::ensureRowWidgetCount(unsigned int count)
+{
+  if (row_widgets.size() >= count) {
+    return;
+  }
+
+  while (row_widgets.size() < count) {
+    row_widgets.push_back(&bwScreenGraph::Builder::addWidget(list_node, create_row_func()));
+  }
+  /* Rows map to different widgets now. */
+  bound_rows.assign(count, std::nullopt);
+}
+
+}  // namespace bWidgets
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "bwScrollView.h"
+
+namespace bWidgets {
+
+/**
+ * \brief Scroll-view showing a (potentially huge) list of equally sized rows.
+ *
+ * Only the rows inside the view, plus a few rows of overscan above and below, get a widget and a
+ * screen-graph node. These widgets are recycled as the view scrolls: a row scrolling out of view
+ * passes its widget on to a row scrolling into view, which is then filled with the new row's data
+ * through the row-binding callback. So drawing and event handling only ever deal with a small,
+ * constant number of nodes, independent of the row count.
+ *
+ * The layout owning the list view is expected to make the content rectangle (see
+ * \ref bwScreenGraph::ContainerNode::ContentRectangle()) \ref getContentHeight() high, and to call
+ * \ref updateRows() once it placed the list view.
+ */
+class bwListView : public bwScrollView {
+ public:
+  /** Create a widget to display a row with. Rows are filled with data using \ref RowBindFunc. */
+  using RowCreateFunc = std::function<std::unique_ptr<bwWidget>()>;
+  /** Fill \a row_widget with the data of the row at \a row_index. */
+  using RowBindFunc = std::function<void(bwWidget& row_widget, unsigned int row_index)>;
+
+  bwListView(bwScreenGraph::ContainerNode& node,
+             unsigned int row_count,
+             unsigned int row_height,
+             RowCreateFunc create_row_func,
+             RowBindFunc bind_row_func,
+             unsigned int width = 0,
+             unsigned int height = 0);
+
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+  auto getTypeIdentifier() const -> bwAtom override;
+
+  auto setRowCount(unsigned int row_count) -> bwListView&;
+  auto getRowCount() const -> unsigned int;
+  auto getRowHeight(float interface_scale) const -> int;
+  auto getContentHeight(float interface_scale) const -> int;
+
+  void updateRows(float interface_scale);
+  void rebindRows();
+
+  /** Number of rows to keep instantiated above and below the visible ones. */
+  constexpr static unsigned int OVERSCAN_ROWS = 2;
+
+ protected:
+  void onScrollValueChange() override;
+
+ private:
+  void ensureRowWidgetCount(unsigned int count);
+
+  /** Non-const version of the node, so row nodes can be added to it. */
+  bwScreenGraph::ContainerNode& list_node;
+
+  unsigned int row_count;
+  unsigned int row_height;
+  RowCreateFunc create_row_func;
+  RowBindFunc bind_row_func;
+
+  /** The recycled row widgets, the row at index `i` uses the widget at `i % size()`. */
+  std::vector<bwWidget*> row_widgets;
+  /** The row each widget in \a row_widgets currently shows, if any. */
+  std::vector<std::optional<unsigned int>> bound_rows;
+
+  /** The interface scale passed to the last #updateRows() call. */
+  float interface_scale{1.0f};
+};
+
+}  // namespace bWidgets
@@ -19,9 +19,21 @@ bwNumberSlider::bwNumberSlider(std::optional<unsigned int> width_hint,
 {
 }
 
-auto bwNumberSlider::getTypeIdentifier() const -> std::string_view
+auto bwNumberSlider::staticType() -> const bwWidgetType&
 {
-  return "bwNumberSlider";
+  static const bwWidgetType type{"bwNumberSlider", &bwTextBox::staticType()};
+  return type;
+}
+
+auto bwNumberSlider::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwNumberSlider::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwNumberSlider");
+  return identifier;
 }
 
 void bwNumberSlider::draw(bwStyle& style)
@@ -100,8 +112,12 @@ auto bwNumberSlider::setValue(float _value) -> bwNumberSlider&
 {
   const int precision_fac = std::pow(10, precision);
   const float unclamped_value = std::max(min, std::min(max, _value));
+  const float new_value = std::roundf(unclamped_value * precision_fac) / precision_fac;
 
-  value = std::roundf(unclamped_value * precision_fac) / precision_fac;
+  if (value != new_value) {
+    value = new_value;
+    requestRedraw();
+  }
   return *this;
 }
 
@@ -175,7 +191,7 @@ void bwNumberSliderHandler::onMousePress(bwMouseButtonEvent& event)
       endTextEditing();
     }
     else if (is_dragging) {
-      numberslider.value = initial_value;
+      numberslider.setValue(initial_value);
     }
 
     event.swallow();
@@ -14,7 +14,9 @@ class bwNumberSlider : public bwTextBox {
   bwNumberSlider(std::optional<unsigned int> width_hint = std::nullopt,
                  std::optional<unsigned int> height_hint = std::nullopt);
 
-  auto getTypeIdentifier() const -> std::string_view override;
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+  auto getTypeIdentifier() const -> bwAtom override;
 
   void draw(bwStyle& style) override;
 
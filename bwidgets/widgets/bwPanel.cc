@@ -7,21 +7,38 @@
 #include "bwPanel.h"
 #include "bwStyle.h"
 
+#include "screen_graph/Builder.h"
+
 namespace bWidgets {
 
-bwPanel::bwPanel(const bwScreenGraph::ContainerNode& node,
+bwPanel::bwPanel(bwScreenGraph::ContainerNode& node,
                  std::string label,
-                 std::optional<unsigned int> header_height_hint)
+                 std::optional<unsigned int> header_height_hint,
+                 State panel_state)
     : bwContainerWidget(node, 0, header_height_hint),
       header_height(header_height_hint.value_or(height_hint)),
+      panel_state(panel_state),
+      panel_node(node),
       label(std::move(label))
 {
   initialize();
 }
 
-auto bwPanel::getTypeIdentifier() const -> std::string_view
+auto bwPanel::staticType() -> const bwWidgetType&
+{
+  static const bwWidgetType type{"bwPanel", &bwContainerWidget::staticType()};
+  return type;
+}
+
+auto bwPanel::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwPanel::getTypeIdentifier() const -> bwAtom
 {
-  return "bwPanel";
+  static const bwAtom identifier("bwPanel");
+  return identifier;
 }
 
 void bwPanel::draw(bwStyle& style)
@@ -180,10 +197,14 @@ void bwPanelHandler::onMousePress(bwMouseButtonEvent& event)
   }
   else if (panel.panel_state == bwPanel::State::CLOSED) {
     panel.panel_state = bwPanel::State::OPEN;
+    /* In case the panel was built lazily and the content wasn't needed so far. */
+    bwScreenGraph::Builder::buildLazyChildren(panel.panel_node);
+    panel.invalidateLayout();
     event.swallow();
   }
   else if (panel.panel_state == bwPanel::State::OPEN) {
     panel.panel_state = bwPanel::State::CLOSED;
+    panel.invalidateLayout();
     event.swallow();
   }
   else {
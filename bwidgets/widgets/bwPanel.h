@@ -13,11 +13,14 @@ class bwPanel : public bwContainerWidget {
     CLOSED,
   };
 
-  bwPanel(const bwScreenGraph::ContainerNode& node,
+  bwPanel(bwScreenGraph::ContainerNode& node,
           std::string label,
-          std::optional<unsigned int> header_height_hint = std::nullopt);
+          std::optional<unsigned int> header_height_hint = std::nullopt,
+          State panel_state = State::OPEN);
 
-  auto getTypeIdentifier() const -> std::string_view override;
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+  auto getTypeIdentifier() const -> bwAtom override;
   
   void draw(class bwStyle& style) override;
 
@@ -38,6 +41,9 @@ class bwPanel : public bwContainerWidget {
   auto getHeaderRectangle() const -> bwRectanglePixel;
   auto isCoordinateInsideHeader(const bwPoint& point) const -> bool;
 
+  /** Non-const version of the node, to build lazily built children on opening. */
+  bwScreenGraph::ContainerNode& panel_node;
+
   std::string label;
 
  public:
@@ -9,9 +9,21 @@ bwPushButton::bwPushButton(const std::string& text,
 {
 }
 
-auto bwPushButton::getTypeIdentifier() const -> std::string_view
+auto bwPushButton::staticType() -> const bwWidgetType&
 {
-  return "bwPushButton";
+  static const bwWidgetType type{"bwPushButton", &bwAbstractButton::staticType()};
+  return type;
+}
+
+auto bwPushButton::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwPushButton::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwPushButton");
+  return identifier;
 }
 
 auto bwPushButton::getIcon() const -> const bwIconInterface*
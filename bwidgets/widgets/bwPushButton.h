@@ -12,7 +12,9 @@ class bwPushButton : public bwAbstractButton {
                std::optional<unsigned int> width_hint = std::nullopt,
                std::optional<unsigned int> height_hint = std::nullopt);
 
-  auto getTypeIdentifier() const -> std::string_view override;
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+  auto getTypeIdentifier() const -> bwAtom override;
 
   auto getIcon() const -> const bwIconInterface* override;
   auto setIcon(const class bwIconInterface&) -> bwPushButton&;
@@ -10,9 +10,21 @@ bwRadioButton::bwRadioButton(const std::string& text,
 {
 }
 
-auto bwRadioButton::getTypeIdentifier() const -> std::string_view
+auto bwRadioButton::staticType() -> const bwWidgetType&
 {
-  return "bwRadioButton";
+  static const bwWidgetType type{"bwRadioButton", &bwAbstractButton::staticType()};
+  return type;
+}
+
+auto bwRadioButton::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwRadioButton::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwRadioButton");
+  return identifier;
 }
 
 auto bwRadioButton::canAlign() const -> bool
@@ -11,9 +11,21 @@ bwScrollBar::bwScrollBar(unsigned int width_hint, unsigned int height_hint)
 {
 }
 
-auto bwScrollBar::getTypeIdentifier() const -> std::string_view
+auto bwScrollBar::staticType() -> const bwWidgetType&
 {
-  return "bwScrollBar";
+  static const bwWidgetType type{"bwScrollBar", &bwAbstractButton::staticType()};
+  return type;
+}
+
+auto bwScrollBar::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwScrollBar::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwScrollBar");
+  return identifier;
 }
 
 static auto getInnerRect(bwScrollBar& scrollbar) -> bwRectanglePixel
@@ -128,6 +140,7 @@ void bwScrollBarHandler::onMouseDrag(bwMouseButtonDragEvent& event)
 void bwScrollBarHandler::setScrollOffset(int value)
 {
   scrollbar.scroll_offset = value;
+  scrollbar.requestRedraw();
   apply();
 }
 
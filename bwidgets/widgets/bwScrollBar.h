@@ -8,7 +8,9 @@ class bwScrollBar : public bwAbstractButton {
  public:
   bwScrollBar(unsigned int width_hint = 0, unsigned int height_hint = 0);
 
-  auto getTypeIdentifier() const -> std::string_view override;
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+  auto getTypeIdentifier() const -> bwAtom override;
 
   void draw(bwStyle& style) override;
 
@@ -9,6 +9,7 @@
 #include "screen_graph/Builder.h"
 #include "screen_graph/Drawer.h"
 #include "screen_graph/Node.h"
+#include "screen_graph/ScreenGraph.h"
 
 #include "bwScrollBar.h"
 
@@ -27,9 +28,21 @@ bwScrollView::bwScrollView(bwScreenGraph::ContainerNode& node,
   bwScreenGraph::Builder::setWidget(*scrollbar_node, std::move(scrollbar));
 }
 
-auto bwScrollView::getTypeIdentifier() const -> std::string_view
+auto bwScrollView::staticType() -> const bwWidgetType&
 {
-  return "bwScrollView";
+  static const bwWidgetType type{"bwScrollView", &bwContainerWidget::staticType()};
+  return type;
+}
+
+auto bwScrollView::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwScrollView::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwScrollView");
+  return identifier;
 }
 
 auto bwScrollView::getVerticalScrollBar() const -> bwScrollBar&
@@ -94,6 +107,12 @@ auto bwScrollView::getScrollOffsetY() const -> int
   return vert_scroll;
 }
 
+auto bwScrollView::getContentOffset() const -> bwPoint
+{
+  /* Content is layed out as if not scrolled, move it up by the scroll distance. */
+  return {0.0f, float(vert_scroll)};
+}
+
 auto bwScrollView::getContentBounds(float interface_scale) const -> bwRectanglePixel
 {
   bwRectanglePixel bounds{rectangle};
@@ -108,6 +127,13 @@ auto bwScrollView::isScrollable() const -> bool
   return (node.ContentRectangle().height() > node.Rectangle().height()) || (vert_scroll != 0);
 }
 
+/**
+ * Called after the scroll value was changed through user interaction.
+ */
+void bwScrollView::onScrollValueChange()
+{
+}
+
 auto bwScrollView::getScrollbarWidth(float interface_scale) -> int
 {
   return std::round(SCROLL_BAR_SIZE * interface_scale);
@@ -135,10 +161,16 @@ class bwScrollViewHandler : public bwScreenGraph::EventHandler {
   auto isEventInsideScrollbar(const class bwEvent& event) const -> bool;
 
   void setScrollValue(int value);
+  void animateScrollValue(int value);
+  void cancelScrollAnimation();
 
  private:
   bwScrollView& scrollview;
   constexpr static int SCROLL_STEP_SIZE = 40;
+  constexpr static std::chrono::milliseconds SCROLL_ANIMATION_DURATION{120};
+
+  /** Value the running scroll animation ends at, see #animateScrollValue(). */
+  int scroll_target{0};
 
   bool was_inside_scrollbar{false};
 };
@@ -195,7 +227,15 @@ void bwScrollViewHandler::onMouseWheel(bwMouseWheelEvent& event)
       break;
   }
 
-  setScrollValue(scrollview.vert_scroll + (direction_fac * SCROLL_STEP_SIZE));
+  /* Scrolling further while animating adds to where the animation would end. */
+  const bwScreenGraph::ScreenGraph* screen_graph = bwScreenGraph::ScreenGraph::fromNode(
+      scrollview.node);
+  const bool is_animating = screen_graph &&
+                            screen_graph->animator.isAnimating(scrollview.node,
+                                                               &scrollview.vert_scroll);
+  const int scroll_from = is_animating ? scroll_target : scrollview.vert_scroll;
+
+  animateScrollValue(scroll_from + (direction_fac * SCROLL_STEP_SIZE));
 
   event.swallow();
 }
@@ -251,6 +291,7 @@ void bwScrollViewHandler::onMouseDrag(bwMouseButtonDragEvent& event)
 {
   if (forwardEventToScrollbarIfInside<bwMouseButtonDragEvent&>(
           *this, *scrollview.scrollbar_node, event, &EventHandler::onMouseDrag, event)) {
+    cancelScrollAnimation();
     setScrollValue(scrollview.getVerticalScrollBar().scroll_offset);
     event.swallow();
   }
@@ -276,6 +317,7 @@ void bwScrollViewHandler::onMouseClick(bwMouseButtonEvent& event)
 {
   if (forwardEventToScrollbarIfInside<bwMouseButtonEvent&>(
           *this, *scrollview.scrollbar_node, event, &EventHandler::onMouseClick, event)) {
+    cancelScrollAnimation();
     setScrollValue(scrollview.getVerticalScrollBar().scroll_offset);
     event.swallow();
   }
@@ -285,8 +327,51 @@ void bwScrollViewHandler::setScrollValue(int value)
 {
   assert(scrollview.isScrollable());
 
+  /* No need to invalidate the layout, the content is only moved using the content offset. */
   scrollview.vert_scroll = value;
   scrollview.validizeScrollValues();
+  scrollview.onScrollValueChange();
+  scrollview.requestRedraw();
+}
+
+/**
+ * Scroll smoothly to \a value. Jumps right away if the scroll view isn't part of a screen-graph,
+ * which runs the animation.
+ */
+void bwScrollViewHandler::animateScrollValue(int value)
+{
+  bwScreenGraph::ScreenGraph* screen_graph = bwScreenGraph::ScreenGraph::fromNode(
+      scrollview.node);
+  if (!screen_graph) {
+    setScrollValue(value);
+    return;
+  }
+
+  bwRange<int>::clampValue(value,
+                           0,
+                           scrollview.node.ContentRectangle().height() -
+                               scrollview.node.Rectangle().height());
+  scroll_target = value;
+  screen_graph->animator.animate(scrollview.node,
+                                 &scrollview.vert_scroll,
+                                 scrollview.vert_scroll,
+                                 value,
+                                 SCROLL_ANIMATION_DURATION,
+                                 bwEasing::EASE_OUT,
+                                 [this](int value) {
+                                   /* May have changed while animating, e.g. by resizing. */
+                                   if (scrollview.isScrollable()) {
+                                     setScrollValue(value);
+                                   }
+                                 });
+}
+
+void bwScrollViewHandler::cancelScrollAnimation()
+{
+  if (bwScreenGraph::ScreenGraph* screen_graph = bwScreenGraph::ScreenGraph::fromNode(
+          scrollview.node)) {
+    screen_graph->animator.cancel(scrollview.node, &scrollview.vert_scroll);
+  }
 }
 
 }  // namespace bWidgets
@@ -19,15 +19,21 @@ class bwScrollView : public bwContainerWidget {
                unsigned int width = 0,
                unsigned int height = 0);
 
-  auto getTypeIdentifier() const -> std::string_view override;
+  static auto staticType() -> const bwWidgetType&;
+  auto getType() const -> const bwWidgetType& override;
+  auto getTypeIdentifier() const -> bwAtom override;
 
   void draw(bwStyle& style) override;
 
   auto createHandler() -> std::unique_ptr<bwScreenGraph::EventHandler> override;
 
   auto getScrollOffsetY() const -> int;
+  auto getContentOffset() const -> bwPoint override;
   auto getContentBounds(float interface_scale) const -> bwRectanglePixel;
 
+ protected:
+  virtual void onScrollValueChange();
+
  private:
   auto getVerticalScrollBar() const -> bwScrollBar&;
   auto getVerticalScrollbarRect(const bwStyle& style) const -> bwRectanglePixel;
@@ -13,9 +13,21 @@ bwTextBox::bwTextBox(std::optional<unsigned int> width_hint,
   initialize();
 }
 
-auto bwTextBox::getTypeIdentifier() const -> std::string_view
+auto bwTextBox::staticType() -> const bwWidgetType&
 {
-  return "bwTextBox";
+  static const bwWidgetType type{"bwTextBox", &bwWidget::staticType()};
+  return type;
+}
+
+auto bwTextBox::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
+auto bwTextBox::getTypeIdentifier() const -> bwAtom
+{
+  static const bwAtom identifier("bwTextBox");
+  return identifier;
 }
 
 void bwTextBox::draw(bwStyle& style)
@@ -47,6 +59,7 @@ void bwTextBox::registerProperties()
 auto bwTextBox::setText(const std::string& value) -> bwTextBox&
 {
   text = value;
+  requestRedraw();
   return *this;
 }
 
@@ -1,17 +1,29 @@
 #include "bwStyle.h"
+#include "screen_graph/Mutator.h"
+#include "screen_graph/Node.h"
 
 #include "bwWidget.h"
 
 namespace bWidgets {
 
 bwWidget::bwWidget(std::optional<unsigned int> width_hint, std::optional<unsigned int> height_hint)
-    : state(State::NORMAL),
-      rectangle(0, 0, 0, 0),
+    : rectangle(0, 0, 0, 0),
       width_hint(width_hint.value_or(bwStyle::s_default_widget_size_hint)),
       height_hint(height_hint.value_or(bwStyle::s_default_widget_size_hint))
 {
 }
 
+auto bwWidget::staticType() -> const bwWidgetType&
+{
+  static const bwWidgetType type{"bwWidget", nullptr};
+  return type;
+}
+
+auto bwWidget::getType() const -> const bwWidgetType&
+{
+  return staticType();
+}
+
 auto bwWidget::getState() const -> State
 {
   return state;
@@ -19,13 +31,95 @@ auto bwWidget::getState() const -> State
 
 auto bwWidget::setState(State value) -> bwWidget&
 {
-  state = value;
+  if (state != value) {
+    state = value;
+    requestRedraw();
+    /* The widget itself is styled again because its state changed. Style sheets may also select
+     * descendants by it, e.g. `bwPanel:hover bwLabel`. */
+    if (screen_graph_node && screen_graph_node->Children() &&
+        !screen_graph_node->Children()->empty()) {
+      invalidateStyleOfSubtree();
+    }
+  }
   return *this;
 }
 
+auto bwWidget::addStyleClass(std::string_view name) -> bwWidget&
+{
+  const bwAtom name_atom(name);
+  if (!hasStyleClass(name_atom)) {
+    style_classes.push_back(name_atom);
+    requestRedraw();
+    invalidateStyleOfSubtree();
+  }
+  return *this;
+}
+
+auto bwWidget::removeStyleClass(std::string_view name) -> bwWidget&
+{
+  const bwAtom name_atom(name);
+  for (std::size_t i = 0; i < style_classes.size(); i++) {
+    if (style_classes[i] == name_atom) {
+      style_classes.removeUnordered(i);
+      requestRedraw();
+      invalidateStyleOfSubtree();
+      break;
+    }
+  }
+  return *this;
+}
+
+auto bwWidget::hasStyleClass(const bwAtom name) const -> bool
+{
+  for (const bwAtom style_class : style_classes) {
+    if (style_class == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto bwWidget::getStyleClasses() const -> const StyleClassList&
+{
+  return style_classes;
+}
+
+auto bwWidget::setStyleID(std::string_view id) -> bwWidget&
+{
+  const bwAtom id_atom(id);
+  if (style_id != id_atom) {
+    style_id = id_atom;
+    requestRedraw();
+    invalidateStyleOfSubtree();
+  }
+  return *this;
+}
+
+auto bwWidget::getStyleID() const -> bwAtom
+{
+  return style_id;
+}
+
+auto bwWidget::getParentWidget() const -> bwWidget*
+{
+  if (!screen_graph_node) {
+    return nullptr;
+  }
+  for (const bwScreenGraph::Node* node = screen_graph_node->Parent(); node;
+       node = node->Parent()) {
+    if (bwWidget* widget = node->Widget()) {
+      return widget;
+    }
+  }
+  return nullptr;
+}
+
 auto bwWidget::hide(bool _hidden) -> bwWidget&
 {
-  hidden = _hidden;
+  if (hidden != _hidden) {
+    hidden = _hidden;
+    invalidateLayout();
+  }
   return *this;
 }
 
@@ -34,6 +128,68 @@ auto bwWidget::isHidden() -> bool
   return hidden;
 }
 
+auto bwWidget::setWidthHint(unsigned int value) -> bwWidget&
+{
+  if (width_hint != value) {
+    width_hint = value;
+    invalidateLayout();
+  }
+  return *this;
+}
+
+auto bwWidget::setHeightHint(unsigned int value) -> bwWidget&
+{
+  if (height_hint != value) {
+    height_hint = value;
+    invalidateLayout();
+  }
+  return *this;
+}
+
+/**
+ * \brief Tag the layout containing this widget as needing to be recalculated.
+ *
+ * Call this whenever a change to the widget may affect the layout, e.g. a size change. Only the
+ * layouts of the widget's ancestors are affected.
+ */
+void bwWidget::invalidateLayout()
+{
+  if (screen_graph_node) {
+    bwScreenGraph::Mutator::invalidateLayout(*screen_graph_node);
+  }
+}
+
+/**
+ * \brief Tag the widget as needing to be drawn again.
+ *
+ * Call this whenever a change to the widget affects how it's drawn, but not the layout (use
+ * #invalidateLayout() for that, which implies a redraw). Lets the application skip drawing while
+ * nothing changed.
+ */
+void bwWidget::requestRedraw()
+{
+  if (screen_graph_node) {
+    bwScreenGraph::Mutator::requestRedraw(*screen_graph_node);
+  }
+}
+
+void bwWidget::invalidateStyle()
+{
+  styled_generation = std::nullopt;
+}
+
+/**
+ * Invalidate the style of the widget and of all widgets below it. For changes style sheets may
+ * select descendants by, like style classes.
+ */
+void bwWidget::invalidateStyleOfSubtree()
+{
+  invalidateStyle();
+  if (screen_graph_node) {
+    bwScreenGraph::Mutator::invalidateStyleOfSubtree(*screen_graph_node);
+  }
+}
+
 auto bwWidget::getLabel() const -> const std::string*
 {
   return nullptr;
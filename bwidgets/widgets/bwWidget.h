@@ -3,10 +3,13 @@
 #include <optional>
 #include <typeinfo>
 
+#include "bwAtom.h"
 #include "bwDistance.h"
 #include "bwFunctorInterface.h"
 #include "bwRectangle.h"
+#include "bwSmallVector.h"
 #include "bwStyleProperties.h"
+#include "bwWidgetType.h"
 #include "screen_graph/EventHandler.h"
 
 namespace bWidgets {
@@ -15,6 +18,11 @@ class bwEvent;
 class bwMouseButtonEvent;
 class bwMouseButtonDragEvent;
 class bwStyle;
+namespace bwScreenGraph {
+class Builder;
+class Node;
+class StyleResolver;
+}  // namespace bwScreenGraph
 
 /**
  * \brief Abstract base class that all widgets derive from.
@@ -29,6 +37,8 @@ class bwWidget {
     STATE_TOT
   };
 
+  using StyleClassList = bwSmallVector<bwAtom, 2>;
+
   bwWidget(std::optional<unsigned int> width_hint, std::optional<unsigned int> height_hint);
   virtual ~bwWidget() = default;
 
@@ -44,8 +54,40 @@ class bwWidget {
   auto setState(State) -> bwWidget&;
   auto hide(bool _hidden = true) -> bwWidget&;
   auto isHidden() -> bool;
+  auto setWidthHint(unsigned int value) -> bwWidget&;
+  auto setHeightHint(unsigned int value) -> bwWidget&;
+  void invalidateLayout();
+  void requestRedraw();
+  /**
+   * Let the next style pass set the style of the widget again (see
+   * \ref bwScreenGraph::StyleResolver). By default, it's only set again once the state of the
+   * widget or of an ancestor, or the style generation changed. Call this after changing something
+   * else the style depends on.
+   */
+  void invalidateStyle();
 
-  virtual auto getTypeIdentifier() const -> std::string_view = 0;
+  /**
+   * Style classes and ID, for style sheets to select widgets with (e.g. `.primary` and `#apply`
+   * in CSS). bWidgets itself doesn't do anything with them.
+   */
+  auto addStyleClass(std::string_view name) -> bwWidget&;
+  auto removeStyleClass(std::string_view name) -> bwWidget&;
+  auto hasStyleClass(bwAtom name) const -> bool;
+  auto getStyleClasses() const -> const StyleClassList&;
+  auto setStyleID(std::string_view id) -> bwWidget&;
+  /** Empty atom if no ID is set. */
+  auto getStyleID() const -> bwAtom;
+  /** The closest screen-graph ancestor that has a widget, or null. */
+  auto getParentWidget() const -> bwWidget*;
+
+  static auto staticType() -> const bwWidgetType&;
+  /**
+   * The registered type of the widget class, see \ref bwWidgetType. Widget classes should
+   * override this, otherwise they are treated like their parent class in type checks (see
+   * \ref widget_is()).
+   */
+  virtual auto getType() const -> const bwWidgetType&;
+  virtual auto getTypeIdentifier() const -> bwAtom = 0;
 
   virtual void draw(bwStyle& style) = 0;
   virtual auto getLabel() const -> const std::string*;
@@ -63,6 +105,8 @@ class bwWidget {
    * Define size hints for the widget. bWidgets itself doesn't do anything with it. The actual
    * application can use it for its layout calculations or simply ignore it. For bWidgets all
    * that matters is the final \a rectangle. Like the name suggests it's really just a hint.
+   * \note Prefer changing these using #setWidthHint() and #setHeightHint(), which tell the layout
+   *       to update.
    */
   unsigned int width_hint, height_hint;
 
@@ -73,6 +117,14 @@ class bwWidget {
   virtual void registerProperties();
 
  private:
+  friend class bwScreenGraph::Builder;
+  friend class bwScreenGraph::StyleResolver;
+
+  void invalidateStyleOfSubtree();
+
+  /** The screen-graph node owning this widget, set by the builder. May be null. */
+  bwScreenGraph::Node* screen_graph_node{nullptr};
+
   /**
    * Hint if widget was explicitly hidden. bWidgets itself doesn't do
    * anything with it (yet). The actual application can use it for its layout
@@ -85,9 +137,30 @@ class bwWidget {
    */
   bool hidden{false};
 
-  State state;
+  State state{State::NORMAL};
+
+  StyleClassList style_classes;
+  bwAtom style_id;
+
+  /** The style generation the style was last set for, unset if it has to be set again. */
+  std::optional<unsigned int> styled_generation;
+  /** The state the style was last set for. */
+  State styled_state{State::NORMAL};
 };
 
+/**
+ * Check if \a widget is of type `T` or of a type derived from it, in constant time and without
+ * RTTI (see \ref bwWidgetType). Prefer this over `widget_cast<>()` in performance critical code,
+ * e.g. by checking the type with this and using `static_cast<>()` to get the derived type. For
+ * checks against many types, consider a \ref bwWidgetTypeMap.
+ */
+template<class T> inline auto widget_is(const bwWidget& widget) -> bool
+{
+  static_assert(std::is_base_of<bwWidget, T>::value, "Type is not a widget");
+
+  return widget.getType().isA(T::staticType());
+}
+
 /**
  * Try to dynamically cast a widget from one widget type to another. Use-case is not just to
  * perform the cast itself, but to also to check if a widget is of a specific type.
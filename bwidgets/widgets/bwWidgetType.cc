@@ -0,0 +1,23 @@
+#include <atomic>
+
+#include "bwWidgetType.h"
+
+namespace bWidgets {
+
+static std::atomic<bwWidgetType::ID> registered_type_count{0};
+
+bwWidgetType::bwWidgetType(std::string_view name, const bwWidgetType* parent)
+    : name(name), parent(parent), id(registered_type_count++)
+{
+  if (parent) {
+    ancestor_ids = parent->ancestor_ids;
+  }
+  ancestor_ids.push_back(id);
+}
+
+auto bwWidgetType::count() -> ID
+{
+  return registered_type_count;
+}
+
+}  // namespace bWidgets
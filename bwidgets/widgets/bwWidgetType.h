@@ -0,0 +1,122 @@
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace bWidgets {
+
+/**
+ * \brief Run-time type descriptor of a widget class, for type checks without RTTI.
+ *
+ * Each widget class registers one descriptor, by defining it as function-local static in its
+ * `staticType()` function and returning it from its `getType()` override. For example:
+ * \code
+ * auto bwFoo::staticType() -> const bwWidgetType&
+ * {
+ *   static const bwWidgetType type{"bwFoo", &bwWidget::staticType()};
+ *   return type;
+ * }
+ * auto bwFoo::getType() const -> const bwWidgetType&
+ * {
+ *   return staticType();
+ * }
+ * \endcode
+ * Types defined outside of bWidgets can register themselves the same way, there's no central
+ * list of types to extend.
+ *
+ * Registration assigns a compact ID, and stores the IDs of all ancestor types indexed by their
+ * depth in the class hierarchy. Checking if a type inherits from another one is then a single
+ * comparison (see #isA()), independent of the depth of the hierarchy or the number of types.
+ */
+class bwWidgetType {
+ public:
+  using ID = unsigned int;
+
+  bwWidgetType(std::string_view name, const bwWidgetType* parent);
+
+  bwWidgetType(const bwWidgetType&) = delete;
+  auto operator=(const bwWidgetType&) = delete;
+
+  /**
+   * Check if this type is \a other or inherits from it.
+   */
+  auto isA(const bwWidgetType& other) const -> bool
+  {
+    const size_t other_depth = other.ancestor_ids.size() - 1;
+    return (other_depth < ancestor_ids.size()) && (ancestor_ids[other_depth] == other.id);
+  }
+
+  /** Number of registered types. IDs are always smaller than this. */
+  static auto count() -> ID;
+
+  const std::string_view name;
+  const bwWidgetType* const parent;
+  const ID id;
+
+ private:
+  /** IDs of all ancestors and of this type itself, indexed by depth in the class hierarchy. */
+  std::vector<ID> ancestor_ids;
+};
+
+/**
+ * \brief Map from widget types to values, where types inherit the values of their ancestors.
+ *
+ * Use this to dispatch to a function per widget type (a visitor), instead of a chain of type
+ * checks. A lookup only has to search the ancestors of a type the first time the type is looked
+ * up, after that the result is cached, so lookups are constant time.
+ *
+ * \note Lookups modify the cache, so they are not thread-safe.
+ */
+template<typename _Value> class bwWidgetTypeMap {
+ public:
+  template<typename _WidgetType> void add(_Value value)
+  {
+    add(_WidgetType::staticType(), std::move(value));
+  }
+
+  void add(const bwWidgetType& type, _Value value)
+  {
+    if (type.id >= values.size()) {
+      values.resize(type.id + 1);
+    }
+    values[type.id] = std::move(value);
+    /* Types may resolve to a different value now. */
+    resolved_ids.clear();
+  }
+
+  /**
+   * \return The value added for \a type, or the one of its closest ancestor a value was added
+   *         for. Null if there's none.
+   */
+  auto lookup(const bwWidgetType& type) const -> const _Value*
+  {
+    if (type.id >= resolved_ids.size()) {
+      resolved_ids.resize(bwWidgetType::count(), UNRESOLVED);
+    }
+
+    bwWidgetType::ID& resolved_id = resolved_ids[type.id];
+    if (resolved_id == UNRESOLVED) {
+      resolved_id = NONE;
+      for (const bwWidgetType* iter = &type; iter; iter = iter->parent) {
+        if ((iter->id < values.size()) && values[iter->id]) {
+          resolved_id = iter->id;
+          break;
+        }
+      }
+    }
+
+    return (resolved_id == NONE) ? nullptr : &*values[resolved_id];
+  }
+
+ private:
+  constexpr static bwWidgetType::ID UNRESOLVED = std::numeric_limits<bwWidgetType::ID>::max();
+  constexpr static bwWidgetType::ID NONE = UNRESOLVED - 1;
+
+  std::vector<std::optional<_Value>> values;
+  /** Cache of lookup results: The ID of the type whose value to use, indexed by type ID. */
+  mutable std::vector<bwWidgetType::ID> resolved_ids;
+};
+
+}  // namespace bWidgets
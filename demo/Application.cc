@@ -20,6 +20,7 @@
  */
 
 #include <cassert>
+#include <iostream>
 
 #include "WindowManager.h"
 
@@ -33,10 +34,18 @@ Application& Application::ensureApplication()
   return app;
 }
 
-void Application::setup()
+void Application::setup(const Options& options)
 {
   WindowManager& wm = WindowManager::getWindowManager();
-  wm.addWindow("bWidgets Demo");
+  wm.setUseUIThread(options.use_ui_thread);
+  wm.setPrintInputLatency(options.print_input_latency);
+  Window& win = wm.addWindow("bWidgets Demo");
+
+  if (!options.event_recording_filepath.empty() &&
+      !win.startEventRecording(options.event_recording_filepath)) {
+    std::cout << "Error: Could not open '" << options.event_recording_filepath
+              << "' for recording events" << std::endl;
+  }
 }
 
 void Application::mainLoop()
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <string>
+
 namespace bWidgetsDemo {
 
 /**
@@ -28,9 +30,18 @@ namespace bWidgetsDemo {
  */
 class Application {
  public:
+  struct Options {
+    /** Run event handling, layout and drawing on a separate thread. */
+    bool use_ui_thread{false};
+    /** On exit, print the longest time input events waited for the UI thread. */
+    bool print_input_latency{false};
+    /** If set, write all input events to this file, for replaying them later. */
+    std::string event_recording_filepath;
+  };
+
   static Application& ensureApplication();
 
-  void setup();
+  void setup(const Options& options);
   void mainLoop();
   void exit();
 
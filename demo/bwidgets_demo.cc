@@ -19,15 +19,30 @@
  * ***** END GPL LICENSE BLOCK *****
  */
 
+#include <cstring>
+
 #include "Application.h"
 
 using namespace bWidgetsDemo;
 
-int main(int /*argc*/, char** /*argv*/)
+int main(int argc, char** argv)
 {
   Application& app = Application::ensureApplication();
+  Application::Options options;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--ui-thread") == 0) {
+      options.use_ui_thread = true;
+    }
+    else if (std::strcmp(argv[i], "--print-latency") == 0) {
+      options.print_input_latency = true;
+    }
+    else if ((std::strcmp(argv[i], "--record") == 0) && ((i + 1) < argc)) {
+      options.event_recording_filepath = argv[++i];
+    }
+  }
 
-  app.setup();
+  app.setup(options);
   app.mainLoop();
   app.exit();
 
@@ -117,6 +117,25 @@ DefaultStage::DefaultStage(unsigned int mask_width, unsigned int mask_height)
       std::make_unique<PanelLayout>(),
       "More Testing...",
       PANEL_HEADER_HEIGHT);
+
+  // Starts collapsed, so the list is only built when opening the panel.
+  builder.buildContainerLazy<bwPanel>(
+      [](Builder& builder) {
+        builder.addContainer<bwListView>(
+            std::make_unique<ListViewLayout>(),
+            1000000,
+            20,
+            []() { return std::make_unique<bwLabel>(); },
+            [](bwWidget& row_widget, unsigned int row_index) {
+              static_cast<bwLabel&>(row_widget).setLabel("Item " + std::to_string(row_index));
+            },
+            0,
+            200);
+      },
+      std::make_unique<PanelLayout>(),
+      "List View (1,000,000 Items)",
+      PANEL_HEADER_HEIGHT,
+      bwPanel::State::CLOSED);
 }
 
 auto isUseCSSVersionToggleHidden(const bwStyle& style) -> bool
@@ -68,6 +68,14 @@ void GawainPaintEngine::enableMask(const bwRectanglePixel& rect)
             (rect.height() + 1) * m_scale_y);
 }
 
+auto GawainPaintEngine::translatedRectangle(const bwRectanglePixel& rect) const -> bwRectanglePixel
+{
+  const bwPoint& translation = getTranslation();
+  bwRectanglePixel result = rect;
+  result.translate(int(translation.x), int(translation.y));
+  return result;
+}
+
 // --------------------------------------------------------------------
 // Polygon Drawing
 
@@ -165,6 +173,10 @@ void GawainPaintEngine::drawPolygon(const bwPainter& painter, const bwPolygon& p
 
   GPUShader::immBind(is_shaded ? GPUShader::ID_SMOOTH_COLOR : GPUShader::ID_UNIFORM_COLOR);
 
+  // Apply the translation using the matrix, saves transforming all vertices.
+  const bwPoint& translation = getTranslation();
+  gpuTranslate2f(translation.x * m_scale_x, translation.y * m_scale_y);
+
   if (painter.use_antialiasing) {
     bwColor drawcolor = color;
 
@@ -182,6 +194,8 @@ void GawainPaintEngine::drawPolygon(const bwPainter& painter, const bwPolygon& p
         painter, poly, color, prim_type, attr_pos, attr_color, m_scale_x, m_scale_y);
   }
 
+  gpuTranslate2f(-translation.x * m_scale_x, -translation.y * m_scale_y);
+
   GPUShader::immUnbind();
   glDisable(GL_BLEND);
 }
@@ -216,10 +230,13 @@ static auto stage_text_xpos_calc(Font& font,
 
 void GawainPaintEngine::drawText(const bwPainter& painter,
                                  const std::string& text,
-                                 const bwRectanglePixel& rectangle,
+                                 const bwRectanglePixel& untranslated_rectangle,
                                  const TextAlignment alignment)
 {
-  bwRectanglePixel scaled_mask = painter.getContentMask();
+  // Font rendering masks in window coordinates, so translate explicitly instead of using the
+  // matrix.
+  const bwRectanglePixel rectangle = translatedRectangle(untranslated_rectangle);
+  bwRectanglePixel scaled_mask = translatedRectangle(painter.getContentMask());
   const float font_height = font.getSize();
   const float draw_pos_x = stage_text_xpos_calc(font, text, rectangle, alignment, m_scale_x);
   const float draw_pos_y = (rectangle.centerY() + 1.0f) * m_scale_y - (font_height / 2.0f);
@@ -328,7 +345,8 @@ void GawainPaintEngine::drawIcon(const bwPainter& /*painter*/,
   bwRectanglePixel icon_rect;
   GLuint texture_id = 0;
 
-  engine_icon_rectangle_adjust(icon_rect, rectangle, pixmap, m_scale_x, m_scale_y);
+  engine_icon_rectangle_adjust(
+      icon_rect, translatedRectangle(rectangle), pixmap, m_scale_x, m_scale_y);
 
   engine_icon_texture_drawing_prepare(pixmap, texture_id);
   engine_icon_texture_draw(icon_rect);
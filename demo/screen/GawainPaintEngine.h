@@ -45,6 +45,8 @@ class GawainPaintEngine : public bWidgets::bwPaintEngine {
   float m_scale_y{1.0f};
 
  private:
+  auto translatedRectangle(const bWidgets::bwRectanglePixel&) const -> bWidgets::bwRectanglePixel;
+
   class Font& font;
   class IconMap& icon_map;
 };
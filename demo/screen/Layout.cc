@@ -21,9 +21,11 @@
 
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "builtin_widgets.h"
 #include "bwPainter.h"
+#include "screen_graph/Iterators.h"
 
 #include "Layout.h"
 
@@ -40,8 +42,8 @@ void resolveScreenGraphNodeLayout(bwScreenGraph::LayoutNode& node,
       assert(node.Children());
 
       if (bwWidget* widget = node.Widget()) {
-        widget->width_hint = rect.width();
-        widget->height_hint = rect.height();
+        widget->setWidthHint(rect.width());
+        widget->setHeightHint(rect.height());
       }
 
       root->resolve(node, {rect.xmin, rect.ymin}, root->item_margin, scale_fac);
@@ -59,97 +61,127 @@ auto LayoutItem::getHeight() const -> unsigned int
   return height;
 }
 
-static auto getNextUnhiddenNode(const bwScreenGraph::Node::ChildList::const_iterator& current)
-    -> bwScreenGraph::Node*
-{
-  for (auto iter = ++bwScreenGraph::Node::ChildList::const_iterator(current);
-       iter != (*current)->Parent()->Children()->end();
-       ++iter) {
-    if ((*iter)->isVisible()) {
-      return iter->get();
-    }
-  }
+/**
+ * Information on a visible child of a layout, gathered in a single sweep so that the layout
+ * calculation doesn't have to search through siblings for each child.
+ */
+struct VisibleChild {
+  bwScreenGraph::Node* node;
+  bool can_align;
+  bool is_aligned_to_previous;
+  bool is_aligned_to_next;
+  bool needs_margin_after;
+};
 
-  return nullptr;
-}
-static auto getPreviousUnhiddenNode(const bwScreenGraph::Node::ChildIterator& current)
-    -> bwScreenGraph::Node*
+/**
+ * Gather the visible children of a layout and determine alignment and margins for them, in a
+ * single sweep over the children.
+ *
+ * \return The number of margins needed in between the visible children.
+ */
+static auto collectVisibleChildren(const bwScreenGraph::Node::ChildList& children,
+                                   const bool align,
+                                   std::vector<VisibleChild>& r_visible_children) -> unsigned int
 {
-  for (auto iter = bwScreenGraph::Node::ChildList::reverse_iterator(current);
-       iter != (*current)->Parent()->Children()->rend();
-       ++iter) {
-    if ((*iter)->isVisible()) {
-      return iter->get();
-    }
-  }
+  unsigned int tot_margins = 0;
 
-  return nullptr;
-}
+  r_visible_children.clear();
+  r_visible_children.reserve(children.size());
 
-static auto shouldWidgetAlignToPrevious(const bwScreenGraph::Node::ChildIterator& current) -> bool
-{
-  bwScreenGraph::Node* prev_item = getPreviousUnhiddenNode(current);
-  bwWidget* prev_widget = prev_item ? prev_item->Widget() : nullptr;
+  for (const auto& child : children) {
+    if (!child->isVisible()) {
+      continue;
+    }
 
-  if (!prev_item || !prev_widget || !prev_widget->canAlign()) {
-    return false;
-  }
+    const bwWidget* widget = child->Widget();
+    const bool can_align = widget && widget->canAlign();
 
-  return true;
-}
-static auto shouldWidgetAlignToNext(const bwScreenGraph::Node::ChildIterator& current) -> bool
-{
-  bwScreenGraph::Node* next_item = getNextUnhiddenNode(current);
-  bwWidget* next_widget = next_item ? next_item->Widget() : nullptr;
+    if (!r_visible_children.empty()) {
+      VisibleChild& prev = r_visible_children.back();
 
-  if (!next_item || !next_widget || !next_widget->canAlign()) {
-    return false;
+      prev.is_aligned_to_next = can_align;
+      prev.needs_margin_after = !(align && prev.can_align && can_align);
+      if (prev.needs_margin_after) {
+        tot_margins++;
+      }
+    }
+
+    const bool is_aligned_to_previous = !r_visible_children.empty() &&
+                                        r_visible_children.back().can_align;
+    r_visible_children.push_back({child.get(), can_align, is_aligned_to_previous, false, false});
   }
 
-  return true;
+  return tot_margins;
 }
-static void alignNode(bwScreenGraph::Node::ChildIterator node_iter,
-                      const LayoutItem::FlowDirection flow_direction)
+
+static void alignNode(const VisibleChild& child, const LayoutItem::FlowDirection flow_direction)
 {
-  bwWidget* widget = (*node_iter)->Widget();
-  bwAbstractButton* abstract_button;
+  bwWidget* widget = child.node->Widget();
 
-  if (!widget || !widget->canAlign() ||
-      !(abstract_button = widget_cast<bwAbstractButton>(widget))) {
+  if (!child.can_align || !widget_is<bwAbstractButton>(*widget)) {
     return;
   }
-  abstract_button->rounded_corners = 0;
+  auto* abstract_button = static_cast<bwAbstractButton*>(widget);
+  unsigned int rounded_corners = 0;
 
-  if (!shouldWidgetAlignToPrevious(node_iter)) {
-    abstract_button->rounded_corners |= (flow_direction == LayoutItem::FLOW_DIRECTION_HORIZONTAL) ?
-                                            (TOP_LEFT | BOTTOM_LEFT) :
-                                            (TOP_LEFT | TOP_RIGHT);
+  if (!child.is_aligned_to_previous) {
+    rounded_corners |= (flow_direction == LayoutItem::FLOW_DIRECTION_HORIZONTAL) ?
+                           (TOP_LEFT | BOTTOM_LEFT) :
+                           (TOP_LEFT | TOP_RIGHT);
+  }
+  if (!child.is_aligned_to_next) {
+    rounded_corners |= (flow_direction == LayoutItem::FLOW_DIRECTION_HORIZONTAL) ?
+                           (TOP_RIGHT | BOTTOM_RIGHT) :
+                           (BOTTOM_LEFT | BOTTOM_RIGHT);
   }
-  if (!shouldWidgetAlignToNext(node_iter)) {
-    abstract_button->rounded_corners |= (flow_direction == LayoutItem::FLOW_DIRECTION_HORIZONTAL) ?
-                                            (TOP_RIGHT | BOTTOM_RIGHT) :
-                                            (BOTTOM_LEFT | BOTTOM_RIGHT);
+
+  if (abstract_button->rounded_corners != rounded_corners) {
+    abstract_button->rounded_corners = rounded_corners;
+    /* Styles apply the corners. */
+    abstract_button->invalidateStyle();
   }
 }
 
-static auto needsMarginAfterNode(const bwScreenGraph::Node::ChildList::const_iterator node_iter,
-                                 const bool align) -> bool
+/**
+ * Move \a node and all its descendants by \a x and \a y, without recalculating their layouts.
+ */
+void LayoutItem::translateNode(bwScreenGraph::Node& node, const int x, const int y)
 {
-  const bwWidget* widget = (*node_iter)->Widget();
-  const bwScreenGraph::Node* next_iter = getNextUnhiddenNode(node_iter);
-  const bwWidget* next_widget = next_iter ? next_iter->Widget() : nullptr;
-
-  if (!next_iter) {
-    return false;
+  if ((x == 0) && (y == 0)) {
+    return;
   }
 
-  if (align && widget && next_widget) {
-    if (widget->canAlign() && next_widget->canAlign()) {
-      return false;
+  const bwPoint offset(x, y);
+
+  for (bwScreenGraph::Node& iter_node : node) {
+    if (bwWidget* widget = iter_node.Widget()) {
+      widget->rectangle.translate(x, y);
+    }
+    if (LayoutItem* layout = static_cast<LayoutItem*>(iter_node.Layout())) {
+      layout->location = layout->location + offset;
+      layout->resolved_pos = layout->resolved_pos + offset;
     }
   }
+}
 
-  return true;
+/**
+ * Remember the state the layout was calculated for, so following calls can check if it has to be
+ * recalculated.
+ */
+void LayoutItem::markResolved(const bwPoint& pos, const float scale_fac)
+{
+  resolved_pos = pos;
+  resolved_scale_fac = scale_fac;
+  clearDirty();
+}
+
+/**
+ * Check if the results of the last calculation are still valid for placing the item with
+ * \a new_width. If so, the item can just be moved to a new position.
+ */
+auto LayoutItem::canReuseResolved(const int new_width, const float scale_fac) const -> bool
+{
+  return !isDirty() && (width == new_width) && (resolved_scale_fac == scale_fac);
 }
 
 void LayoutItem::resolvePanelContents(bwScreenGraph::Node& panel_node,
@@ -196,8 +228,10 @@ void LayoutItem::resolve(bwScreenGraph::Node& node,
 
   height = 0;
 
+  std::vector<VisibleChild> visible_children;
+  const unsigned int margin_count = collectVisibleChildren(*children, align, visible_children);
+
   if (flow_direction == FLOW_DIRECTION_HORIZONTAL) {
-    const unsigned int margin_count = countNeededMargins(*children);
     const unsigned int width_no_margins = width - (margin_count * item_margin) - (2 * padding);
     // The max-width of each item is the max-width of the parent, divided by the count of its
     // horizontally placed sub-items. In other words, each item has the same max-width that
@@ -217,21 +251,17 @@ void LayoutItem::resolve(bwScreenGraph::Node& node,
     item_width_base = width - (2 * padding);
   }
 
-  for (auto node_iter = children->begin(); node_iter != children->end(); ++node_iter) {
-    bwScreenGraph::Node& child_node = **node_iter;
+  for (auto child_iter = visible_children.begin(); child_iter != visible_children.end();
+       ++child_iter) {
+    bwScreenGraph::Node& child_node = *child_iter->node;
     LayoutItem* layout = static_cast<LayoutItem*>(child_node.Layout());
     bwWidget* widget = child_node.Widget();
     int item_width = item_width_base;
-
-    if (!child_node.isVisible()) {
-      continue;
-    }
-
-    const bwScreenGraph::Node* next = getNextUnhiddenNode(node_iter);
+    const bool has_next = std::next(child_iter) != visible_children.end();
 
     // Simple correction for precision issues.
     if (additional_remainder_x > 0) {
-      if (next) {
+      if (has_next) {
         item_width++;
         additional_remainder_x--;
       }
@@ -244,7 +274,13 @@ void LayoutItem::resolve(bwScreenGraph::Node& node,
       }
     }
 
-    if (widget && widget_cast<bwPanel>(widget)) {
+    if (layout && layout->canReuseResolved(item_width, scale_fac)) {
+      // Nothing changed inside, only the position may have changed.
+      translateNode(
+          child_node, xpos - int(layout->resolved_pos.x), ypos - int(layout->resolved_pos.y));
+      location.y = ypos;
+    }
+    else if (widget && widget_is<bwPanel>(*widget)) {
       bwPanel& panel = static_cast<bwPanel&>(*widget);
 
       assert(layout);
@@ -264,12 +300,15 @@ void LayoutItem::resolve(bwScreenGraph::Node& node,
       layout->resolve(child_node, bwPoint(xpos, ypos), item_margin, scale_fac);
       location.y = ypos;
     }
+    if (layout) {
+      layout->markResolved(bwPoint(xpos, ypos), scale_fac);
+    }
     if (widget) {
       const int widget_height = layout ? layout->height : widget->height_hint * scale_fac;
       widget->rectangle.set(xpos, item_width, ypos - widget_height, widget_height);
       location.y = widget->rectangle.ymin;
       if (align) {
-        alignNode(node_iter, flow_direction);
+        alignNode(*child_iter, flow_direction);
       }
     }
 
@@ -277,11 +316,11 @@ void LayoutItem::resolve(bwScreenGraph::Node& node,
     const int child_height = child_node.Rectangle().height();
 
     if (flow_direction == FLOW_DIRECTION_VERTICAL) {
-      if (needsMarginAfterNode(node_iter, align)) {
+      if (child_iter->needs_margin_after) {
         ypos -= item_margin;
         height += item_margin;
       }
-      else if (next) {
+      else if (has_next) {
         ypos += 1;
         height -= 1;
       }
@@ -289,10 +328,10 @@ void LayoutItem::resolve(bwScreenGraph::Node& node,
       height += child_height;
     }
     else if (flow_direction == FLOW_DIRECTION_HORIZONTAL) {
-      if (needsMarginAfterNode(node_iter, align)) {
+      if (child_iter->needs_margin_after) {
         xpos += item_margin;
       }
-      else if (next) {
+      else if (has_next) {
         xpos -= 1;
         additional_remainder_x += 1;
       }
@@ -346,28 +385,6 @@ auto LayoutItem::countRowColumns(const bwScreenGraph::Node::ChildList& children)
   return count_child_cols;
 }
 
-/**
- * Calculate how many margins need to be added in between child-items of this layout.
- */
-auto LayoutItem::countNeededMargins(const bwScreenGraph::Node::ChildList& children) const
-    -> unsigned int
-{
-  unsigned int tot_margins = 0;
-
-  for (auto child_iter = children.begin(); child_iter != children.end(); ++child_iter) {
-    const bwScreenGraph::Node& child = **child_iter;
-
-    if (!child.isVisible()) {
-      continue;
-    }
-    if (needsMarginAfterNode(child_iter, align)) {
-      tot_margins++;
-    }
-  }
-
-  return tot_margins;
-}
-
 ColumnLayout::ColumnLayout(const bool align)
     : LayoutItem(LayoutItem::Type::COLUMN, align, FLOW_DIRECTION_VERTICAL)
 {
@@ -400,18 +417,70 @@ void ScrollViewLayout::resolve(bwScreenGraph::Node& node,
     return;
   }
 
-  // Could check if layout actually needs to be updated.
+  if (!isDirty() && (resolved_scale_fac == scale_fac) && (resolved_pos == layout_pos)) {
+    // Nothing changed since the last calculation.
+    return;
+  }
 
   widget->rectangle.set(layout_pos.x, widget->width_hint, layout_pos.y, widget->height_hint);
 
-  bwRectanglePixel content_bounds = view_widget->getContentBounds(scale_fac);
-  width = content_bounds.width();
+  // The scroll-bar takes away space from the content. If the content size changes so that the
+  // scroll-bar appears or disappears, the content has to be calculated again. Can't leave this to
+  // the next redraw, since that won't recalculate the layout unless it's tagged dirty.
+  for (int pass = 0; pass < 2; pass++) {
+    bwRectanglePixel content_bounds = view_widget->getContentBounds(scale_fac);
+    width = content_bounds.width();
 
-  bwPoint children_pos{float(content_bounds.xmin),
-                       float(content_bounds.ymax + view_widget->getScrollOffsetY())};
+    // Scrolling is applied as content offset when drawing and handling events, so the layout
+    // doesn't depend on it.
+    bwPoint children_pos{float(content_bounds.xmin), float(content_bounds.ymax)};
 
-  LayoutItem::resolve(node, children_pos, item_margin, scale_fac);
-  height += padding;
+    LayoutItem::resolve(node, children_pos, item_margin, scale_fac);
+    height += padding;
+
+    if (view_widget->getContentBounds(scale_fac).width() == width) {
+      break;
+    }
+  }
+
+  markResolved(layout_pos, scale_fac);
+}
+
+ListViewLayout::ListViewLayout()
+    : LayoutItem(LayoutItem::Type::LIST_VIEW, false, FLOW_DIRECTION_VERTICAL)
+{
+}
+
+void ListViewLayout::resolve(bwScreenGraph::Node& node,
+                             const bwPoint& layout_pos,
+                             const unsigned int /*item_margin*/,
+                             const float scale_fac)
+{
+  bwListView* list_view = widget_cast<bwListView>(node.Widget());
+
+  if (!list_view) {
+    assert(false);
+    return;
+  }
+
+  location = layout_pos;
+  // The height of the view, not of the content. The parent uses it to place the list view.
+  height = list_view->height_hint * scale_fac;
+  list_view->rectangle.set(layout_pos.x, width, layout_pos.y - height, height);
+
+  // Needs the content height to know if there's a scroll-bar taking away width.
+  content_height = list_view->getContentHeight(scale_fac);
+  content_width = list_view->getContentBounds(scale_fac).width();
+
+  list_view->updateRows(scale_fac);
+}
+
+auto ListViewLayout::getRectangle() -> bwRectanglePixel
+{
+  const int xmin = int(location.x);
+  const int ymax = int(location.y);
+
+  return bwRectanglePixel{xmin, xmin + content_width, ymax - content_height, ymax};
 }
 
 }  // namespace bWidgetsDemo
@@ -53,6 +53,11 @@ void resolveScreenGraphNodeLayout(bWidgets::bwScreenGraph::LayoutNode& node,
  * \note We currently expect a RootLayout to be at the top of the tree. Through it
  *       the needed position and size hints can be set. Without changing these, the
  *       calculated widget-coordinates don't change.
+ *
+ * Layouts are only recalculated if they are tagged dirty (see
+ * bWidgets::bwLayoutInterface::markDirty()), or if their width or the scale changed. Otherwise
+ * the results of the last calculation are kept and, if the parent places the item at a different
+ * position, simply moved there.
  */
 class LayoutItem : public bWidgets::bwLayoutInterface {
  public:
@@ -61,6 +66,7 @@ class LayoutItem : public bWidgets::bwLayoutInterface {
     COLUMN,
     PANEL,
     SCROLL_VIEW,
+    LIST_VIEW,
   };
 
   enum FlowDirection {
@@ -94,6 +100,8 @@ class LayoutItem : public bWidgets::bwLayoutInterface {
              const bool align,
              FlowDirection flow_direction = FLOW_DIRECTION_HORIZONTAL);
 
+  static void translateNode(bWidgets::bwScreenGraph::Node& node, const int x, const int y);
+  void markResolved(const bWidgets::bwPoint& pos, const float scale_fac);
   static void resolvePanelContents(bWidgets::bwScreenGraph::Node& panel_node,
                                    const bWidgets::bwPoint& panel_pos,
                                    const unsigned int padding,
@@ -103,11 +111,15 @@ class LayoutItem : public bWidgets::bwLayoutInterface {
   int width{0}, height{0};
   bWidgets::bwPoint location;
 
+  /** The position the parent placed this item at in the last calculation. */
+  bWidgets::bwPoint resolved_pos;
+  /** The scale factor used for the last calculation. */
+  float resolved_scale_fac{0.0f};
+
  private:
+  auto canReuseResolved(const int new_width, const float scale_fac) const -> bool;
   auto countRowColumns(const bWidgets::bwScreenGraph::Node::ChildList& children) const
       -> unsigned int;
-  auto countNeededMargins(const bWidgets::bwScreenGraph::Node::ChildList& children) const
-      -> unsigned int;
 };
 
 class ColumnLayout : public LayoutItem {
@@ -137,4 +149,27 @@ class ScrollViewLayout : public LayoutItem {
   unsigned int item_margin = 0;
 };
 
+/**
+ * \brief Layout for bWidgets::bwListView.
+ *
+ * Doesn't resolve children itself, the list view only has children for the rows in view and
+ * places them itself. The content rectangle is made as high as all rows together, so scrolling
+ * works as expected.
+ */
+class ListViewLayout : public LayoutItem {
+ public:
+  explicit ListViewLayout();
+
+  void resolve(bWidgets::bwScreenGraph::Node& node,
+               const bWidgets::bwPoint& layout_pos,
+               const unsigned int item_margin,
+               const float scale_fac) override;
+
+  auto getRectangle() -> bWidgets::bwRectanglePixel override;
+
+ private:
+  int content_width{0};
+  int content_height{0};
+};
+
 }  // namespace bWidgetsDemo
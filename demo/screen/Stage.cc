@@ -21,6 +21,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <fstream>
 #include <iostream>
 
 // bWidgets lib
@@ -36,6 +37,7 @@
 
 #include "Event.h"
 #include "File.h"
+#include "GPU.h"
 #include "GPUShader.h"
 #include "GawainPaintEngine.h"
 #include "IconMap.h"
@@ -54,6 +56,7 @@ std::unique_ptr<StyleSheet> Stage::style_sheet = nullptr;
 std::unique_ptr<Font> Stage::font = nullptr;
 std::unique_ptr<IconMap> Stage::icon_map = nullptr;
 float Stage::interface_scale = 1.0f;
+unsigned int Stage::global_redraw_counter = 0;
 
 auto createScreenGraph(const unsigned int width, const unsigned int height)
     -> bwScreenGraph::ScreenGraph
@@ -71,8 +74,17 @@ auto createScreenGraph(const unsigned int width, const unsigned int height)
 }
 
 Stage::Stage(const unsigned int width, const unsigned int height)
-    : screen_graph(createScreenGraph(width, height)), mask_width(width), mask_height(height)
+    : screen_graph(createScreenGraph(width, height)),
+      event_queue(screen_graph.event_dispatcher),
+      mask_width(width),
+      mask_height(height)
 {
+  event_queue.resize_handler = [this](int new_width, int new_height) {
+    mask_width = new_width;
+    mask_height = new_height;
+    redraw_requested = true;
+  };
+
   initFonts();
   initIcons();
 
@@ -114,13 +126,6 @@ void Stage::activateStyleID(bwStyle::TypeID type_id)
 {
   style = std::unique_ptr<bwStyle>(bwStyleManager::createStyleFromTypeID(type_id));
   style->dpi_fac = interface_scale;
-}
-
-void Stage::draw()
-{
-  bwRectanglePixel stage_rect{0, int(mask_width) - 1, 0, int(mask_height - 1)};
-  bwStyleProperties properties;
-  bwColor clear_color{114u};
 
   if (style->type_id == bwStyle::TypeID::CLASSIC_CSS) {
     setStyleSheet(std::string(RESOURCES_PATH_STR) + "/" + "classic_style.css");
@@ -135,9 +140,31 @@ void Stage::draw()
     style_sheet = nullptr;
   }
 
+  bwStyleManager::getStyleManager().bumpStyleGeneration();
+  requestRedrawAll();
+}
+
+void Stage::draw()
+{
+  bwRectanglePixel stage_rect{0, int(mask_width) - 1, 0, int(mask_height - 1)};
+  bwStyleProperties properties;
+  bwColor clear_color{114u};
+
+  bwStyleManager& style_manager = bwStyleManager::getStyleManager();
+
+  /* Only swap at the beginning of a frame, so all widgets are drawn with the same version. */
+  if (style_sheet && style_sheet->update()) {
+    style_manager.bumpStyleGeneration();
+  }
+
+  redraw_requested = false;
+  drawn_global_redraw_counter = global_redraw_counter;
+  drawn_style_generation = style_manager.getStyleGeneration();
+
   bwStyleProperty& property = properties.addColor("background-color", clear_color);
   if (style_sheet) {
-    style_sheet->resolveValue("Stage", bwWidget::State::NORMAL, property);
+    static const bwAtom stage_identifier("Stage");
+    style_sheet->resolveValue(stage_identifier, bwWidget::State::NORMAL, property);
   }
 
   bwPainter::s_paint_engine->setupViewport(stage_rect, clear_color);
@@ -146,13 +173,26 @@ void Stage::draw()
   bwScreenGraph::Drawer::draw(screen_graph, *style);
 }
 
-void Stage::StyleSheetPolish(bwWidget& widget)
+auto Stage::needsFrame() const -> bool
+{
+  return !event_queue.isEmpty() || screen_graph.animator.isActive() || needsRedraw();
+}
+
+auto Stage::needsRedraw() const -> bool
 {
-  StyleSheet& stylesheet = *Stage::style_sheet;
+  return redraw_requested || (drawn_global_redraw_counter != global_redraw_counter) ||
+         (drawn_style_generation != bwStyleManager::getStyleManager().getStyleGeneration()) ||
+         (style_sheet && style_sheet->hasPendingUpdate()) || screen_graph.needsRedraw();
+}
 
-  for (auto& property : widget.style_properties) {
-    stylesheet.resolveValue(widget.getTypeIdentifier(), widget.getState(), *property);
-  }
+void Stage::requestRedrawAll()
+{
+  global_redraw_counter++;
+}
+
+void Stage::StyleSheetPolish(bwWidget& widget)
+{
+  Stage::style_sheet->polishWidget(widget);
 }
 
 void Stage::setContentScale(const float scale_x, const float scale_y)
@@ -168,6 +208,7 @@ void Stage::setInterfaceScale(const float value)
   if (value != interface_scale) {
     interface_scale = value;
     style->dpi_fac = value;
+    bwStyleManager::getStyleManager().bumpStyleGeneration();
     setFontSize(11.0f);
   }
 }
@@ -176,37 +217,43 @@ void Stage::setFontSize(const float size)
 {
   auto& gwn_engine = dynamic_cast<GawainPaintEngine&>(*bwPainter::s_paint_engine);
   font->setSize(size * interface_scale * gwn_engine.m_scale_x);
+  requestRedrawAll();
 }
 
 void Stage::setFontAntiAliasingMode(const Font::AntiAliasingMode aa_mode)
 {
   font->setFontAntiAliasingMode(aa_mode);
+  requestRedrawAll();
 }
 
 void Stage::setFontTightPositioning(const bool value)
 {
   font->setTightPositioning(value);
+  requestRedrawAll();
 }
 
 void Stage::setFontHinting(const bool value)
 {
   font->setHinting(value);
+  requestRedrawAll();
 }
 
 void Stage::setFontSubPixelPositioning(const bool value)
 {
   font->setSubPixelPositioning(value);
+  requestRedrawAll();
 }
 
 void Stage::setStyleSheet(const std::string& filepath)
 {
-  if (!style_sheet || (style_sheet->getFilepath() != filepath)) {
-    style_sheet = std::make_unique<StyleSheet>(filepath);
-  }
-  else {
-    /* TODO skip if file didn't change. */
-    style_sheet->reload();
+  if (style_sheet && (style_sheet->getFilepath() == filepath)) {
+    return;
   }
+
+  style_sheet = std::make_unique<StyleSheet>(filepath);
+  /* Changes are parsed in the background. Wake up the platform thread, which lets the stages
+   * check if they need a frame. */
+  style_sheet->watch([]() { glfwPostEmptyEvent(); });
 }
 
 void Stage::handleMouseMovementEvent(const MouseEvent& event)
@@ -215,20 +262,17 @@ void Stage::handleMouseMovementEvent(const MouseEvent& event)
 
   // TODO Multiple hovered items need to be possible (e.g. button + surrounding panel).
 
-  screen_graph.event_dispatcher.dispatchMouseMovement(bwEvent(mouse_location));
+  event_queue.pushMouseMovement(mouse_location);
 }
 
 void Stage::handleMouseButtonEvent(const MouseEvent& event)
 {
-  bwMouseButtonEvent bw_event(event.getButton(), event.getMouseLocation());
-  bwEventDispatcher& dispatcher = screen_graph.event_dispatcher;
-
   switch (event.getType()) {
     case MouseEvent::Type::PRESS:
-      dispatcher.dispatchMouseButtonPress(bw_event);
+      event_queue.pushMouseButtonPress(event.getButton(), event.getMouseLocation());
       break;
     case MouseEvent::Type::RELEASE:
-      dispatcher.dispatchMouseButtonRelease(bw_event);
+      event_queue.pushMouseButtonRelease(event.getButton(), event.getMouseLocation());
       break;
     default:
       break;
@@ -237,16 +281,34 @@ void Stage::handleMouseButtonEvent(const MouseEvent& event)
 
 void Stage::handleMouseScrollEvent(const MouseEvent& event, bwMouseWheelEvent::Direction dir)
 {
-  bwMouseWheelEvent bw_event(dir, event.getMouseLocation());
-  bwEventDispatcher& dispatcher = screen_graph.event_dispatcher;
-
-  dispatcher.dispatchMouseWheelScroll(bw_event);
+  event_queue.pushMouseWheel(dir, event.getMouseLocation());
 }
 
 void Stage::handleWindowResizeEvent(const Window& win)
 {
-  mask_width = win.getWidth();
-  mask_height = win.getHeight();
+  event_queue.pushResize(win.getWidth(), win.getHeight());
+}
+
+void Stage::flushEvents()
+{
+  /* Animations started by the events start at this frame. */
+  screen_graph.animator.advanceTo(bwAnimator::Clock::now());
+  event_queue.flush();
+}
+
+auto Stage::startEventRecording(const std::string& filepath) -> bool
+{
+  auto file = std::make_unique<std::ofstream>(filepath, std::ios::binary);
+  if (!*file) {
+    return false;
+  }
+
+  event_queue.setRecorder(nullptr);
+  event_recorder = std::make_unique<bwEventRecorder>(*file);
+  event_recording_file = std::move(file);
+  event_queue.setRecorder(event_recorder.get());
+
+  return true;
 }
 
 }  // namespace bWidgetsDemo
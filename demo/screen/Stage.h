@@ -21,10 +21,13 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <list>
 #include <memory>
 
 #include "bwEvent.h"
+#include "bwEventQueue.h"
+#include "bwEventRecording.h"
 #include "bwStyle.h"
 #include "screen_graph/Node.h"
 #include "screen_graph/ScreenGraph.h"
@@ -46,12 +49,28 @@ class Stage {
   virtual ~Stage();
 
   void draw();
+  /** Check if there are queued events to handle, running animations, or if the stage needs to
+   * be redrawn. */
+  auto needsFrame() const -> bool;
+  /** Check if anything changed since the last #draw(). */
+  auto needsRedraw() const -> bool;
+  /** Redraw all stages, needed after changes to the global UI data (e.g. the style). */
+  static void requestRedrawAll();
 
   void handleMouseMovementEvent(const MouseEvent& event);
   void handleMouseButtonEvent(const MouseEvent& event);
   void handleMouseScrollEvent(const MouseEvent& event,
                               enum bWidgets::bwMouseWheelEvent::Direction dir);
   void handleWindowResizeEvent(const Window& win);
+  /** Advance animations and dispatch events queued since the last call. Called once per frame,
+   * before drawing. */
+  void flushEvents();
+  /**
+   * Write all input events to \a filepath from now on, for replaying them (see
+   * \ref bWidgets::bwEventRecording).
+   * \return False if the file couldn't be opened.
+   */
+  auto startEventRecording(const std::string& filepath) -> bool;
 
   void setContentScale(float scale_x, float scale_y);
   static void setInterfaceScale(const float value);
@@ -65,6 +84,9 @@ class Stage {
   virtual void activateStyleID(bWidgets::bwStyle::TypeID type_id);
 
   bWidgets::bwScreenGraph::ScreenGraph screen_graph;
+  bWidgets::bwEventQueue event_queue;
+  std::unique_ptr<std::ofstream> event_recording_file;
+  std::unique_ptr<bWidgets::bwEventRecorder> event_recorder;
 
   // Static members, global UI data for all stages
   static std::unique_ptr<bWidgets::bwStyle> style;
@@ -72,14 +94,22 @@ class Stage {
   static std::unique_ptr<class IconMap> icon_map;
   static std::unique_ptr<class StyleSheet> style_sheet;
   static float interface_scale;
+  /** Incremented by #requestRedrawAll(). */
+  static unsigned int global_redraw_counter;
 
   unsigned int mask_width, mask_height;
+  bool redraw_requested{true};
+  unsigned int drawn_global_redraw_counter{0};
+  /** See \ref bWidgets::bwStyleManager::getStyleGeneration(). */
+  unsigned int drawn_style_generation{0};
 
  private:
   static void StyleSheetPolish(bWidgets::bwWidget& widget);
 
   void initFonts();
   void initIcons();
+  /** Load the style sheet at \a filepath and reload it whenever the file changes. Does nothing
+   * if it's already loaded. */
   void setStyleSheet(const std::string& filepath);
 };
 
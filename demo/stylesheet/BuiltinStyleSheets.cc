@@ -0,0 +1,111 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#include "bwColor.h"
+
+#include "StyleRuleSet.h"
+
+#include "BuiltinStyleSheets.h"
+
+using namespace bWidgets;
+
+namespace bWidgetsDemo {
+
+auto findBuiltinStyleSheet(const std::string_view source) -> const BuiltinStyleSheet*
+{
+  const std::uint64_t source_hash = styleSheetSourceHash(source);
+
+  for (std::size_t i = 0; i < builtin_style_sheet_count; i++) {
+    const BuiltinStyleSheet& style_sheet = builtin_style_sheets[i];
+    if ((style_sheet.source_hash == source_hash) &&
+        (style_sheet.source_length == source.length())) {
+      return &style_sheet;
+    }
+  }
+
+  return nullptr;
+}
+
+static auto builtin_selector_to_style_selector(const BuiltinStyleRule& rule) -> StyleSelector
+{
+  StyleSelector selector;
+
+  for (std::size_t i = 0; i < rule.compound_count; i++) {
+    const BuiltinCompoundSelector& builtin_compound = rule.compounds[i];
+    CompoundSelector compound;
+
+    compound.type = bwAtom(builtin_compound.type);
+    compound.id = bwAtom(builtin_compound.id);
+    for (std::size_t j = 0; j < builtin_compound.class_count; j++) {
+      compound.classes.emplace_back(builtin_compound.classes[j]);
+    }
+    if (builtin_compound.has_state) {
+      compound.state = builtin_compound.state;
+    }
+
+    selector.addCompound(std::move(compound), builtin_compound.combinator);
+  }
+
+  return selector;
+}
+
+static void builtin_declaration_add(bwStyleProperties& declarations,
+                                    const BuiltinDeclaration& declaration)
+{
+  bwStyleProperty& property = declarations.addProperty(declaration.property, declaration.type);
+
+  switch (declaration.type) {
+    case bwStyleProperty::Type::BOOL:
+      property.setValue(declaration.bool_value);
+      break;
+    case bwStyleProperty::Type::INTEGER:
+      property.setValue(declaration.int_value);
+      break;
+    case bwStyleProperty::Type::FLOAT:
+      property.setValue(declaration.float_value);
+      break;
+    case bwStyleProperty::Type::COLOR:
+      property.setValue(bwColor(declaration.color_value[0],
+                                declaration.color_value[1],
+                                declaration.color_value[2],
+                                declaration.color_value[3]));
+      break;
+  }
+}
+
+auto ruleSetFromBuiltinStyleSheet(const BuiltinStyleSheet& style_sheet)
+    -> std::unique_ptr<StyleRuleSet>
+{
+  auto rule_set = std::make_unique<StyleRuleSet>();
+
+  for (std::size_t i = 0; i < style_sheet.rule_count; i++) {
+    const BuiltinStyleRule& rule = style_sheet.rules[i];
+    bwStyleProperties& declarations = rule_set->addRule(builtin_selector_to_style_selector(rule));
+
+    for (std::size_t j = 0; j < rule.declaration_count; j++) {
+      builtin_declaration_add(declarations, rule.declarations[j]);
+    }
+  }
+
+  return rule_set;
+}
+
+}  // namespace bWidgetsDemo
@@ -0,0 +1,113 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "bwStyleProperties.h"
+#include "bwWidget.h"
+
+#include "StyleSelector.h"
+
+namespace bWidgetsDemo {
+
+class StyleRuleSet;
+
+/**
+ * \name Built-in style sheets
+ *
+ * The style sheets shipped with the application are compiled at build time (by
+ * `bwd_style_sheet_compiler`, see StyleSheetCompiler.cc) into constant tables of the structs
+ * below. Loading one then only means building a \ref StyleRuleSet from the table, instead of
+ * parsing CSS. The resulting rule set is the same as when parsing the CSS, so both resolve values
+ * the same way.
+ *
+ * \{
+ */
+
+struct BuiltinCompoundSelector {
+  /** Empty for any type. */
+  const char* type;
+  /** Empty for any ID. */
+  const char* id;
+  const char* const* classes;
+  std::size_t class_count;
+  bool has_state;
+  bWidgets::bwWidget::State state;
+  /** How the compound relates to the one before it (to its right). */
+  StyleSelector::Combinator combinator;
+};
+
+struct BuiltinDeclaration {
+  const char* property;
+  bWidgets::bwStyleProperty::Type type;
+  /** Only the value for #type is used. */
+  bool bool_value;
+  int int_value;
+  float float_value;
+  float color_value[4];
+};
+
+struct BuiltinStyleRule {
+  /** Right to left, like in \ref StyleSelector. */
+  const BuiltinCompoundSelector* compounds;
+  std::size_t compound_count;
+  const BuiltinDeclaration* declarations;
+  std::size_t declaration_count;
+};
+
+struct BuiltinStyleSheet {
+  /** File name of the CSS it was compiled from. */
+  const char* name;
+  /** Of the CSS it was compiled from, see #styleSheetSourceHash(). */
+  std::uint64_t source_hash;
+  std::size_t source_length;
+  /** In source order. */
+  const BuiltinStyleRule* rules;
+  std::size_t rule_count;
+};
+
+/** Generated, all style sheets compiled into the application. */
+extern const BuiltinStyleSheet builtin_style_sheets[];
+extern const std::size_t builtin_style_sheet_count;
+
+/** FNV-1a, to recognize the CSS of a built-in style sheet. */
+constexpr auto styleSheetSourceHash(const std::string_view source) -> std::uint64_t
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  for (const char c : source) {
+    hash = (hash ^ std::uint8_t(c)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+/** \return The built-in style sheet compiled from exactly \a source, if any. */
+auto findBuiltinStyleSheet(std::string_view source) -> const BuiltinStyleSheet*;
+auto ruleSetFromBuiltinStyleSheet(const BuiltinStyleSheet& style_sheet)
+    -> std::unique_ptr<StyleRuleSet>;
+
+/** \} */
+
+}  // namespace bWidgetsDemo
@@ -0,0 +1,262 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include "StyleRuleSet.h"
+#include "StyleSelector.h"
+
+#include "CompiledStyleTable.h"
+
+using namespace bWidgets;
+
+namespace bWidgetsDemo {
+
+static auto widget_property_count(const bwWidget& widget) -> std::size_t
+{
+  return std::distance(widget.style_properties.begin(), widget.style_properties.end());
+}
+
+auto CompiledStyleTable::MatchKey::operator==(const MatchKey& other) const -> bool
+{
+  return (type == other.type) && (id == other.id) && (state == other.state) &&
+         std::equal(classes.begin(), classes.end(), other.classes.begin(), other.classes.end());
+}
+
+auto CompiledStyleTable::MatchKeyHash::operator()(const MatchKey& key) const -> std::size_t
+{
+  std::size_t hash = std::hash<bwAtom>()(key.type);
+  const auto combine = [&hash](std::size_t value) {
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  };
+
+  combine(std::hash<bwAtom>()(key.id));
+  for (const bwAtom class_name : key.classes) {
+    combine(std::hash<bwAtom>()(class_name));
+  }
+  combine(std::size_t(key.state));
+
+  return hash;
+}
+
+auto CompiledStyleTable::AncestorMatchesHash::operator()(const AncestorMatches& matches) const
+    -> std::size_t
+{
+  std::size_t hash = matches.size();
+  for (const std::uint32_t index : matches) {
+    hash ^= index + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+CompiledStyleTable::CompiledStyleTable(const StyleRuleSet& rule_set) : rule_set(rule_set)
+{
+}
+
+CompiledStyleTable::~CompiledStyleTable() = default;
+
+auto CompiledStyleTable::createEntry(const bwWidget& widget) const -> std::unique_ptr<MatchEntry>
+{
+  auto entry = std::make_unique<MatchEntry>();
+
+  rule_set.collectCandidates(widget, entry->candidates);
+
+  /* How many candidates require each name. */
+  std::unordered_map<std::uint32_t, int> hash_counts;
+  for (const StyleRule* rule : entry->candidates) {
+    for (const std::uint32_t hash : rule->selector.getAncestorHashes()) {
+      if (hash) {
+        hash_counts[hash]++;
+      }
+    }
+  }
+
+  for (std::uint32_t i = 0; i < entry->candidates.size(); i++) {
+    const StyleSelector& selector = entry->candidates[i]->selector;
+    if (!selector.hasAncestorCompounds()) {
+      continue;
+    }
+    entry->has_ancestor_candidates = true;
+
+    /* Index by the least common name, e.g. `.section3` rather than `.group` for
+     * `.section3 .group bwLabel`. Names common to many candidates are likely to be present. */
+    std::uint32_t index_hash = 0;
+    for (const std::uint32_t hash : selector.getAncestorHashes()) {
+      if (hash && (!index_hash || (hash_counts[hash] < hash_counts[index_hash]))) {
+        index_hash = hash;
+      }
+    }
+
+    if (index_hash) {
+      entry->ancestor_candidates_by_hash[index_hash].push_back(i);
+    }
+    else {
+      entry->unhashed_ancestor_candidates.push_back(i);
+    }
+  }
+
+  return entry;
+}
+
+auto CompiledStyleTable::ensureEntry(const bwWidget& widget) -> MatchEntry&
+{
+  if ((widget.getStyleID() == bwAtom()) && widget.getStyleClasses().empty()) {
+    const std::size_t index = widget.getTypeIdentifier().getIndex() *
+                                  std::size_t(bwWidget::State::STATE_TOT) +
+                              std::size_t(widget.getState());
+    if (index >= simple_entries.size()) {
+      simple_entries.resize(bwAtom::count() * std::size_t(bwWidget::State::STATE_TOT));
+    }
+
+    std::unique_ptr<MatchEntry>& entry = simple_entries[index];
+    if (!entry) {
+      entry = createEntry(widget);
+    }
+    return *entry;
+  }
+
+  MatchKey key{widget.getTypeIdentifier(), widget.getStyleID(), {}, widget.getState()};
+  /* Insertion sort, there are only a few. */
+  for (const bwAtom class_name : widget.getStyleClasses()) {
+    key.classes.push_back(class_name);
+    for (std::size_t i = key.classes.size() - 1;
+         (i > 0) && (key.classes[i].getIndex() < key.classes[i - 1].getIndex());
+         i--) {
+      std::swap(key.classes[i], key.classes[i - 1]);
+    }
+  }
+
+  std::unique_ptr<MatchEntry>& entry = entries[key];
+  if (!entry) {
+    entry = createEntry(widget);
+  }
+  return *entry;
+}
+
+auto CompiledStyleTable::candidateMatches(const MatchEntry& entry,
+                                          const AncestorMatches& ancestor_matches,
+                                          const std::size_t index) -> bool
+{
+  return !entry.candidates[index]->selector.hasAncestorCompounds() ||
+         std::binary_search(ancestor_matches.begin(), ancestor_matches.end(), index);
+}
+
+auto CompiledStyleTable::resolve(const MatchEntry& entry,
+                                 const AncestorMatches& ancestor_matches,
+                                 const bwWidget& widget) -> ResolvedValues
+{
+  ResolvedValues resolved;
+  resolved.property_count = widget_property_count(widget);
+  resolved.values.reserve(resolved.property_count);
+
+  for (const auto& property : widget.style_properties) {
+    const bwStyleProperty* value = nullptr;
+
+    /* The last matching rule in cascade order that declares the property wins. */
+    for (std::size_t i = entry.candidates.size(); i > 0; i--) {
+      if (!candidateMatches(entry, ancestor_matches, i - 1)) {
+        continue;
+      }
+      if ((value = entry.candidates[i - 1]->declarations.lookup(property.getIdentifier()))) {
+        break;
+      }
+    }
+    resolved.values.push_back(value);
+  }
+
+  return resolved;
+}
+
+void CompiledStyleTable::apply(const ResolvedValues& resolved, bwWidget& widget)
+{
+  const bwStyleProperty* const* values = resolved.values.data();
+
+  for (auto& property : widget.style_properties) {
+    if (*values) {
+      property.setValue(**values);
+    }
+    else {
+      property.setValueToDefault();
+    }
+    values++;
+  }
+}
+
+/**
+ * Set #ancestor_matches for \a widget, only checking the candidates of \a entry indexed by
+ * names its ancestors have.
+ */
+void CompiledStyleTable::matchAncestorCandidates(const MatchEntry& entry,
+                                                 const bwWidget& widget,
+                                                 const AncestorFilter& ancestor_filter)
+{
+  const auto check_candidate = [&](const std::uint32_t index) {
+    const StyleSelector& selector = entry.candidates[index]->selector;
+    if (ancestor_filter.mayMatch(selector) && selector.matchesAncestors(widget)) {
+      ancestor_matches.push_back(index);
+    }
+  };
+
+  for (const std::uint32_t index : entry.unhashed_ancestor_candidates) {
+    check_candidate(index);
+  }
+  for (const std::uint32_t hash : ancestor_filter.getHashes()) {
+    const auto iterator = entry.ancestor_candidates_by_hash.find(hash);
+    if (iterator == entry.ancestor_candidates_by_hash.end()) {
+      continue;
+    }
+    for (const std::uint32_t index : iterator->second) {
+      check_candidate(index);
+    }
+  }
+
+  std::sort(ancestor_matches.begin(), ancestor_matches.end());
+  /* A candidate is reached again through each ancestor with the name it's indexed by. */
+  ancestor_matches.erase(std::unique(ancestor_matches.begin(), ancestor_matches.end()),
+                         ancestor_matches.end());
+}
+
+void CompiledStyleTable::polish(bwWidget& widget, const AncestorFilter& ancestor_filter)
+{
+  MatchEntry& entry = ensureEntry(widget);
+
+  ancestor_matches.clear();
+  if (entry.has_ancestor_candidates) {
+    matchAncestorCandidates(entry, widget, ancestor_filter);
+  }
+
+  auto iterator = entry.resolved.find(ancestor_matches);
+  if (iterator == entry.resolved.end()) {
+    iterator = entry.resolved
+                   .emplace(ancestor_matches, resolve(entry, ancestor_matches, widget))
+                   .first;
+  }
+
+  if (iterator->second.property_count != widget_property_count(widget)) {
+    apply(resolve(entry, ancestor_matches, widget), widget);
+    return;
+  }
+
+  apply(iterator->second, widget);
+}
+
+}  // namespace bWidgetsDemo
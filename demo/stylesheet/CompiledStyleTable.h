@@ -0,0 +1,138 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "bwSmallVector.h"
+#include "bwWidget.h"
+
+namespace bWidgetsDemo {
+
+class AncestorFilter;
+class StyleRuleSet;
+struct StyleRule;
+
+/**
+ * \brief The values of a \ref StyleRuleSet, resolved for the widgets it was used for.
+ *
+ * Which rules may match a widget only depends on its type, ID, classes and state (plus its
+ * ancestors, for rules with ancestor compounds). So the candidate rules are collected once per
+ * such combination. Which values win only depends on which of the candidates actually match, so
+ * the values are resolved once per combination of matching candidates, in the order the widget's
+ * style properties are registered in. Polishing a widget then mostly is a hash lookup and copying
+ * the precomputed values in order.
+ *
+ * Candidates with ancestor compounds are indexed by a name one of the ancestors must have (see
+ * \ref StyleSelector::getAncestorHashes()). Only the ones indexed by a name the widget's
+ * ancestors actually have are checked, first against the \ref AncestorFilter for their other
+ * names, then by walking up the screen-graph. So the cost doesn't grow with the number of rules
+ * about ancestors that aren't there, e.g. rules for other parts of the application.
+ *
+ * Widgets without ID and classes, the common case, are looked up by the index of their type
+ * identifier atom and their state rather than by hash.
+ *
+ * This relies on all widgets with the same type identifier registering the same style properties
+ * in the same order, which they do since the widget class registers them. Widgets registering a
+ * different number of properties are resolved without caching the values.
+ *
+ * Only valid as long as the rule set it was compiled from.
+ */
+class CompiledStyleTable {
+ public:
+  explicit CompiledStyleTable(const StyleRuleSet& rule_set);
+  ~CompiledStyleTable();
+
+  /**
+   * Set all style properties of \a widget to the values for its type, ID, classes, state and
+   * ancestors.
+   * \param ancestor_filter: Prepared for \a widget (see \ref AncestorFilter::prepareFor()).
+   */
+  void polish(bWidgets::bwWidget& widget, const AncestorFilter& ancestor_filter);
+
+ private:
+  using ClassList = bWidgets::bwSmallVector<bWidgets::bwAtom, 4>;
+
+  struct MatchKey {
+    bWidgets::bwAtom type;
+    bWidgets::bwAtom id;
+    /** Sorted by atom index, the order classes were added in doesn't matter. */
+    ClassList classes;
+    bWidgets::bwWidget::State state;
+
+    auto operator==(const MatchKey& other) const -> bool;
+  };
+  struct MatchKeyHash {
+    auto operator()(const MatchKey& key) const -> std::size_t;
+  };
+
+  /** Indices of the candidates with ancestor compounds that match a widget, ascending. */
+  using AncestorMatches = std::vector<std::uint32_t>;
+  struct AncestorMatchesHash {
+    auto operator()(const AncestorMatches& matches) const -> std::size_t;
+  };
+
+  struct ResolvedValues {
+    std::size_t property_count;
+    /** The property of the rule set to copy the value from, or null to reset the value to its
+     * default. In the order of the widget's style properties. */
+    std::vector<const bWidgets::bwStyleProperty*> values;
+  };
+
+  struct MatchEntry {
+    /** In cascade order. */
+    std::vector<const StyleRule*> candidates;
+    bool has_ancestor_candidates{false};
+    /** Indices of the #candidates with ancestor compounds, by one of their ancestor hashes. */
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> ancestor_candidates_by_hash;
+    /** Indices of the #candidates with ancestor compounds, but no ancestor hashes (ancestor
+     * compounds only matching the state or anything). Always checked. */
+    std::vector<std::uint32_t> unhashed_ancestor_candidates;
+    /** By which of the #candidates with ancestor compounds match, the others always do. */
+    std::unordered_map<AncestorMatches, ResolvedValues, AncestorMatchesHash> resolved;
+  };
+
+  auto ensureEntry(const bWidgets::bwWidget& widget) -> MatchEntry&;
+  void matchAncestorCandidates(const MatchEntry& entry,
+                               const bWidgets::bwWidget& widget,
+                               const AncestorFilter& ancestor_filter);
+  static auto candidateMatches(const MatchEntry& entry,
+                               const AncestorMatches& ancestor_matches,
+                               std::size_t index) -> bool;
+  auto createEntry(const bWidgets::bwWidget& widget) const -> std::unique_ptr<MatchEntry>;
+  static auto resolve(const MatchEntry& entry,
+                      const AncestorMatches& ancestor_matches,
+                      const bWidgets::bwWidget& widget) -> ResolvedValues;
+  static void apply(const ResolvedValues& resolved, bWidgets::bwWidget& widget);
+
+  const StyleRuleSet& rule_set;
+  /** Widgets without ID and classes, indexed by `type.getIndex() * STATE_TOT + state`. */
+  std::vector<std::unique_ptr<MatchEntry>> simple_entries;
+  std::unordered_map<MatchKey, std::unique_ptr<MatchEntry>, MatchKeyHash> entries;
+  /** Reused for each widget, to avoid allocating. */
+  AncestorMatches ancestor_matches;
+};
+
+}  // namespace bWidgetsDemo
@@ -0,0 +1,239 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+
+#ifdef __linux__
+#  include <poll.h>
+#  include <sys/eventfd.h>
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#endif
+
+#include "FileWatcher.h"
+
+namespace fs = std::filesystem;
+
+namespace bWidgetsDemo {
+
+namespace {
+
+struct FileStamp {
+  bool exists{false};
+  fs::file_time_type modification_time;
+  std::uintmax_t size{0};
+
+  auto operator==(const FileStamp& other) const -> bool
+  {
+    return (exists == other.exists) && (modification_time == other.modification_time) &&
+           (size == other.size);
+  }
+  auto operator!=(const FileStamp& other) const -> bool
+  {
+    return !(*this == other);
+  }
+};
+
+}  // namespace
+
+static auto file_stamp_get(const std::string& filepath) -> FileStamp
+{
+  std::error_code error;
+  FileStamp stamp;
+
+  stamp.modification_time = fs::last_write_time(filepath, error);
+  if (error) {
+    return {};
+  }
+  stamp.size = fs::file_size(filepath, error);
+  stamp.exists = !error;
+
+  return stamp;
+}
+
+static auto file_exists(const std::string& filepath) -> bool
+{
+  std::error_code error;
+  return fs::exists(filepath, error);
+}
+
+static auto stop_fd_create() -> int
+{
+#ifdef __linux__
+  return eventfd(0, EFD_CLOEXEC);
+#else
+  return -1;
+#endif
+}
+
+FileWatcher::FileWatcher(std::string filepath, ChangedFn changed_fn)
+    : filepath(std::move(filepath)),
+      changed_fn(std::move(changed_fn)),
+      stop_fd(stop_fd_create()),
+      thread(&FileWatcher::run, this)
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(stop_mutex);
+    stop_requested = true;
+  }
+  stop_condition.notify_all();
+
+#ifdef __linux__
+  if (stop_fd >= 0) {
+    const std::uint64_t value = 1;
+    [[maybe_unused]] const ssize_t written = write(stop_fd, &value, sizeof(value));
+  }
+#endif
+
+  thread.join();
+
+#ifdef __linux__
+  if (stop_fd >= 0) {
+    close(stop_fd);
+  }
+#endif
+}
+
+void FileWatcher::run()
+{
+  if (!runInotify()) {
+    runPolling();
+  }
+}
+
+auto FileWatcher::sleepUnlessStopped(std::chrono::milliseconds duration) -> bool
+{
+  std::unique_lock<std::mutex> lock(stop_mutex);
+  return stop_condition.wait_for(lock, duration, [this]() { return stop_requested.load(); });
+}
+
+#ifdef __linux__
+/**
+ * Read all pending events from \a inotify_fd.
+ * \return True if any of them was about \a filename.
+ */
+static auto inotify_events_read(int inotify_fd, const std::string& filename) -> bool
+{
+  alignas(inotify_event) char buffer[4096];
+  bool found = false;
+  ssize_t length;
+
+  while ((length = read(inotify_fd, buffer, sizeof(buffer))) > 0) {
+    for (const char* iter = buffer; iter < (buffer + length);) {
+      const auto* event = reinterpret_cast<const inotify_event*>(iter);
+      if ((event->len > 0) && (filename == event->name)) {
+        found = true;
+      }
+      iter += sizeof(inotify_event) + event->len;
+    }
+  }
+
+  return found;
+}
+#endif
+
+auto FileWatcher::runInotify() -> bool
+{
+#ifdef __linux__
+  const fs::path path(filepath);
+  const std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+  const std::string filename = path.filename().string();
+
+  if (stop_fd < 0) {
+    return false;
+  }
+  const int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd < 0) {
+    return false;
+  }
+  if (inotify_add_watch(inotify_fd,
+                        directory.c_str(),
+                        IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE) < 0) {
+    close(inotify_fd);
+    return false;
+  }
+
+  pollfd poll_fds[] = {{inotify_fd, POLLIN, 0}, {stop_fd, POLLIN, 0}};
+  bool changed = false;
+  bool ok = true;
+
+  while (!stop_requested) {
+    /* Once changed, wait until nothing happened for a moment. */
+    const int timeout = changed ? int(DEBOUNCE_DURATION.count()) : -1;
+    const int ready_count = poll(poll_fds, 2, timeout);
+
+    if (ready_count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ok = false;
+      break;
+    }
+    if (ready_count == 0) {
+      changed = false;
+      /* Might be in the middle of being replaced. */
+      if (file_exists(filepath)) {
+        changed_fn();
+      }
+      continue;
+    }
+    if (poll_fds[0].revents & POLLIN) {
+      changed |= inotify_events_read(inotify_fd, filename);
+    }
+  }
+
+  close(inotify_fd);
+  return ok;
+#else
+  return false;
+#endif
+}
+
+void FileWatcher::runPolling()
+{
+  FileStamp last_stamp = file_stamp_get(filepath);
+
+  while (!sleepUnlessStopped(POLL_INTERVAL)) {
+    const FileStamp stamp = file_stamp_get(filepath);
+    if (!stamp.exists || (stamp == last_stamp)) {
+      continue;
+    }
+
+    /* Only once it stopped changing. */
+    if (sleepUnlessStopped(DEBOUNCE_DURATION)) {
+      break;
+    }
+    if (file_stamp_get(filepath) != stamp) {
+      continue;
+    }
+
+    last_stamp = stamp;
+    changed_fn();
+  }
+}
+
+}  // namespace bWidgetsDemo
@@ -0,0 +1,78 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace bWidgetsDemo {
+
+/**
+ * \brief Calls a function on a background thread whenever a file changed.
+ *
+ * Uses inotify where available. It watches the directory, not the file itself, since editors
+ * often save by writing a new file and renaming it over the old one. Elsewhere (or if inotify
+ * fails), the modification time and size of the file are polled.
+ *
+ * Changes are debounced: editors may write a file in multiple steps, the function is only called
+ * once the file didn't change for a moment. Stopped and joined on destruction.
+ */
+class FileWatcher {
+ public:
+  using ChangedFn = std::function<void()>;
+
+  FileWatcher(std::string filepath, ChangedFn changed_fn);
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  auto operator=(const FileWatcher&) -> FileWatcher& = delete;
+
+ private:
+  static constexpr std::chrono::milliseconds DEBOUNCE_DURATION{50};
+  static constexpr std::chrono::milliseconds POLL_INTERVAL{500};
+
+  void run();
+  /** \return False if inotify isn't available, so the caller should fall back to polling. */
+  auto runInotify() -> bool;
+  void runPolling();
+  /** Sleep for \a duration, or until stopped. \return True if stopped. */
+  auto sleepUnlessStopped(std::chrono::milliseconds duration) -> bool;
+
+  const std::string filepath;
+  const ChangedFn changed_fn;
+
+  std::atomic<bool> stop_requested{false};
+  /** Event file descriptor waking up the inotify loop when stopping. -1 if not supported. */
+  const int stop_fd;
+  std::mutex stop_mutex;
+  std::condition_variable stop_condition;
+
+  /* Last, so all members are initialized before the thread starts. */
+  std::thread thread;
+};
+
+}  // namespace bWidgetsDemo
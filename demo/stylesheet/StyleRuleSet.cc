@@ -0,0 +1,131 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#include <algorithm>
+
+#include "StyleRuleSet.h"
+
+using namespace bWidgets;
+
+namespace bWidgetsDemo {
+
+auto StyleRuleSet::addRule(StyleSelector selector) -> bwStyleProperties&
+{
+  rules.push_back(
+      std::make_unique<StyleRule>(StyleRule{std::move(selector), unsigned(rules.size())}));
+  const StyleRule* rule = rules.back().get();
+  const CompoundSelector& subject = rule->selector.getSubject();
+
+  if (subject.id != bwAtom()) {
+    rules_by_id[subject.id].push_back(rule);
+  }
+  else if (!subject.classes.empty()) {
+    rules_by_class[subject.classes.front()].push_back(rule);
+  }
+  else if (subject.type != bwAtom()) {
+    rules_by_type[subject.type].push_back(rule);
+  }
+  else {
+    universal_rules.push_back(rule);
+  }
+
+  return rules.back()->declarations;
+}
+
+static auto rule_bucket_find(const std::unordered_map<bwAtom, std::vector<const StyleRule*>>& map,
+                             const bwAtom key) -> const std::vector<const StyleRule*>*
+{
+  const auto iterator = map.find(key);
+  return (iterator != map.end()) ? &iterator->second : nullptr;
+}
+
+void StyleRuleSet::collectMatchingSubjects(const RuleList* rules,
+                                           const bwWidget& widget,
+                                           std::vector<const StyleRule*>& r_rules)
+{
+  if (!rules) {
+    return;
+  }
+  for (const StyleRule* rule : *rules) {
+    if (rule->selector.getSubject().matches(widget)) {
+      r_rules.push_back(rule);
+    }
+  }
+}
+
+void StyleRuleSet::collectCandidates(const bwWidget& widget,
+                                     std::vector<const StyleRule*>& r_rules) const
+{
+  const std::size_t first_index = r_rules.size();
+
+  /* Each rule is in a single bucket, so it's never collected twice. */
+  if (widget.getStyleID() != bwAtom()) {
+    collectMatchingSubjects(rule_bucket_find(rules_by_id, widget.getStyleID()), widget, r_rules);
+  }
+  for (const bwAtom class_name : widget.getStyleClasses()) {
+    collectMatchingSubjects(rule_bucket_find(rules_by_class, class_name), widget, r_rules);
+  }
+  collectMatchingSubjects(
+      rule_bucket_find(rules_by_type, widget.getTypeIdentifier()), widget, r_rules);
+  collectMatchingSubjects(&universal_rules, widget, r_rules);
+
+  std::sort(r_rules.begin() + first_index,
+            r_rules.end(),
+            [](const StyleRule* a, const StyleRule* b) { return a->cascadesBefore(*b); });
+}
+
+auto StyleRuleSet::resolveProperty(const bwAtom type_identifier,
+                                   const bwAtom property_name,
+                                   const bwWidget::State state) const -> const bwStyleProperty*
+{
+  const StyleRule* winning_rule = nullptr;
+  const bwStyleProperty* value = nullptr;
+
+  for (const RuleList* rule_list :
+       {rule_bucket_find(rules_by_type, type_identifier), &universal_rules}) {
+    if (!rule_list) {
+      continue;
+    }
+    for (const StyleRule* rule : *rule_list) {
+      const CompoundSelector& subject = rule->selector.getSubject();
+      if (rule->selector.hasAncestorCompounds() || !subject.classes.empty() ||
+          (subject.id != bwAtom()) || !subject.matches(type_identifier, state)) {
+        continue;
+      }
+      if (winning_rule && rule->cascadesBefore(*winning_rule)) {
+        continue;
+      }
+      if (const bwStyleProperty* declaration = rule->declarations.lookup(property_name)) {
+        winning_rule = rule;
+        value = declaration;
+      }
+    }
+  }
+
+  return value;
+}
+
+auto StyleRuleSet::getRules() const -> const std::vector<std::unique_ptr<StyleRule>>&
+{
+  return rules;
+}
+
+}  // namespace bWidgetsDemo
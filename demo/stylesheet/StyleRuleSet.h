@@ -0,0 +1,98 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "bwStyleProperties.h"
+
+#include "StyleSelector.h"
+
+namespace bWidgetsDemo {
+
+struct StyleRule {
+  StyleSelector selector;
+  /** Position in the style sheet, decides between rules of the same specificity. */
+  unsigned int source_order;
+  bWidgets::bwStyleProperties declarations;
+
+  /** Rules later in cascade order override the values of earlier ones. */
+  auto cascadesBefore(const StyleRule& other) const -> bool
+  {
+    const unsigned int specificity = selector.getSpecificity();
+    const unsigned int other_specificity = other.selector.getSpecificity();
+    return (specificity != other_specificity) ? (specificity < other_specificity) :
+                                                (source_order < other.source_order);
+  }
+};
+
+/**
+ * \brief The rules of a style sheet, indexed by their subject (rightmost compound selector).
+ *
+ * Like in browsers, each rule is stored in a single bucket: by the ID of its subject if it has
+ * one, otherwise by a class, otherwise by the type. The rules that may match a widget are then
+ * found in the buckets for the widget's ID, classes and type, plus the rules without any of
+ * these. So the number of rules checked per widget doesn't grow with the size of the style sheet,
+ * only with the number of rules that are about the widget.
+ */
+class StyleRuleSet {
+ public:
+  /** Add a rule, which overrides the ones added before of the same specificity. Fill in its
+   * declarations with the returned properties. */
+  auto addRule(StyleSelector selector) -> bWidgets::bwStyleProperties&;
+
+  /**
+   * Collect the rules whose subject matches \a widget, in cascade order. Ancestors are not
+   * checked.
+   */
+  void collectCandidates(const bWidgets::bwWidget& widget,
+                         std::vector<const StyleRule*>& r_rules) const;
+
+  /**
+   * Resolve a value for something that isn't a widget, but is styled with a type name (e.g. the
+   * stage background). Only rules without classes, ID and ancestors can match.
+   */
+  auto resolveProperty(bWidgets::bwAtom type_identifier,
+                       bWidgets::bwAtom property_name,
+                       bWidgets::bwWidget::State state) const -> const bWidgets::bwStyleProperty*;
+
+  /** In source order. */
+  auto getRules() const -> const std::vector<std::unique_ptr<StyleRule>>&;
+
+ private:
+  using RuleList = std::vector<const StyleRule*>;
+
+  static void collectMatchingSubjects(const RuleList* rules,
+                                      const bWidgets::bwWidget& widget,
+                                      std::vector<const StyleRule*>& r_rules);
+
+  std::vector<std::unique_ptr<StyleRule>> rules;
+
+  std::unordered_map<bWidgets::bwAtom, RuleList> rules_by_id;
+  std::unordered_map<bWidgets::bwAtom, RuleList> rules_by_class;
+  std::unordered_map<bWidgets::bwAtom, RuleList> rules_by_type;
+  RuleList universal_rules;
+};
+
+}  // namespace bWidgetsDemo
@@ -0,0 +1,320 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#include "bwSmallVector.h"
+
+#include "StyleSelector.h"
+
+using namespace bWidgets;
+
+namespace bWidgetsDemo {
+
+// --------------------------------------------------------------------
+/**
+ * \name Matching
+ * \{
+ */
+
+static auto compound_classes_match(const CompoundSelector& compound, const bwWidget& widget)
+    -> bool
+{
+  for (const bwAtom class_name : compound.classes) {
+    if (!widget.hasStyleClass(class_name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto CompoundSelector::matches(const bwWidget& widget) const -> bool
+{
+  if (!matches(widget.getTypeIdentifier(), widget.getState())) {
+    return false;
+  }
+  if ((id != bwAtom()) && (id != widget.getStyleID())) {
+    return false;
+  }
+  return compound_classes_match(*this, widget);
+}
+
+auto CompoundSelector::matches(const bwAtom type_identifier, const bwWidget::State state) const
+    -> bool
+{
+  if ((type != bwAtom()) && (type != type_identifier)) {
+    return false;
+  }
+  if (this->state && (*this->state != state)) {
+    return false;
+  }
+  return true;
+}
+
+auto StyleSelector::matches(const bwWidget& widget) const -> bool
+{
+  return getSubject().matches(widget) && matchesAncestors(widget);
+}
+
+auto StyleSelector::matchesAncestors(const bwWidget& widget) const -> bool
+{
+  return (components.size() < 2) || matchesAncestorsFrom(1, widget);
+}
+
+/**
+ * Find ancestors of \a widget matching the components from \a component_index on. Backtracks
+ * if a descendant combinator's compound matches an ancestor, but the rest doesn't.
+ */
+auto StyleSelector::matchesAncestorsFrom(std::size_t component_index, const bwWidget& widget) const
+    -> bool
+{
+  const Component& component = components[component_index];
+  const bool is_last = (component_index + 1) == components.size();
+
+  for (const bwWidget* ancestor = widget.getParentWidget(); ancestor;
+       ancestor = ancestor->getParentWidget()) {
+    if (component.compound.matches(*ancestor) &&
+        (is_last || matchesAncestorsFrom(component_index + 1, *ancestor))) {
+      return true;
+    }
+    if (component.combinator == Combinator::CHILD) {
+      break;
+    }
+  }
+
+  return false;
+}
+
+/** \} */
+
+// --------------------------------------------------------------------
+/**
+ * \name Construction
+ * \{
+ */
+
+enum class NameKind {
+  TYPE = 1,
+  ID,
+  CLASS,
+};
+
+/** Same name of different kind gives a different hash. Zero is never returned. */
+static auto name_hash(const NameKind kind, const bwAtom name) -> std::uint32_t
+{
+  /* Multiplicative hashing, the atom index is already well distributed but small. */
+  const std::uint32_t hash = (name.getIndex() * 4 + std::uint32_t(kind)) * 2654435761u;
+  return hash ? hash : 1;
+}
+
+void StyleSelector::addAncestorHash(const std::uint32_t hash)
+{
+  for (std::uint32_t& slot : ancestor_hashes) {
+    if (slot == hash) {
+      return;
+    }
+    if (slot == 0) {
+      slot = hash;
+      return;
+    }
+  }
+  /* Full, the ones added are enough to reject most selectors. */
+}
+
+void StyleSelector::addCompound(CompoundSelector compound, const Combinator combinator)
+{
+  const bool is_subject = components.empty();
+
+  specificity += ((compound.id != bwAtom()) ? 1 : 0) << 20;
+  specificity += (compound.classes.size() + (compound.state ? 1 : 0)) << 10;
+  specificity += (compound.type != bwAtom()) ? 1 : 0;
+
+  if (!is_subject) {
+    if (compound.id != bwAtom()) {
+      addAncestorHash(name_hash(NameKind::ID, compound.id));
+    }
+    for (const bwAtom class_name : compound.classes) {
+      addAncestorHash(name_hash(NameKind::CLASS, class_name));
+    }
+    if (compound.type != bwAtom()) {
+      addAncestorHash(name_hash(NameKind::TYPE, compound.type));
+    }
+  }
+
+  components.push_back({std::move(compound), combinator});
+}
+
+auto StyleSelector::getSubject() const -> const CompoundSelector&
+{
+  return components.front().compound;
+}
+
+auto StyleSelector::hasAncestorCompounds() const -> bool
+{
+  return components.size() > 1;
+}
+
+auto StyleSelector::getCompoundCount() const -> std::size_t
+{
+  return components.size();
+}
+
+auto StyleSelector::getCompound(const std::size_t index) const -> const CompoundSelector&
+{
+  return components[index].compound;
+}
+
+auto StyleSelector::getCombinator(const std::size_t index) const -> Combinator
+{
+  return components[index].combinator;
+}
+
+auto StyleSelector::getSpecificity() const -> unsigned int
+{
+  return specificity;
+}
+
+auto StyleSelector::getAncestorHashes() const -> const AncestorHashes&
+{
+  return ancestor_hashes;
+}
+
+/** \} */
+
+// --------------------------------------------------------------------
+/**
+ * \name Ancestor Filter
+ * \{
+ */
+
+/** The two counters of a hash, from its higher bits (the lower ones are less random). */
+static auto filter_index1(const std::uint32_t hash, const int bits) -> std::uint32_t
+{
+  return hash >> (32 - bits);
+}
+static auto filter_index2(const std::uint32_t hash, const int bits) -> std::uint32_t
+{
+  return (hash >> (32 - 2 * bits)) & ((1u << bits) - 1);
+}
+
+static void filter_counter_increment(std::uint8_t& counter)
+{
+  if (counter != UINT8_MAX) {
+    counter++;
+  }
+}
+static void filter_counter_decrement(std::uint8_t& counter)
+{
+  if (counter != UINT8_MAX) {
+    counter--;
+  }
+}
+
+void AncestorFilter::prepareFor(const bwWidget& widget)
+{
+  /* Ancestors not on the stack yet, innermost first. */
+  bwSmallVector<const bwWidget*, 8> missing;
+  const bwWidget* ancestor = widget.getParentWidget();
+
+  while (ancestor && !contains(ancestor)) {
+    missing.push_back(ancestor);
+    ancestor = ancestor->getParentWidget();
+  }
+  /* Drop what isn't an ancestor. */
+  while (!stack.empty() && (stack.back().widget != ancestor)) {
+    pop();
+  }
+  for (std::size_t i = missing.size(); i > 0; i--) {
+    push(*missing[i - 1]);
+  }
+}
+
+void AncestorFilter::clear()
+{
+  stack.clear();
+  hashes.clear();
+  counters.fill(0);
+}
+
+auto AncestorFilter::mayMatch(const StyleSelector& selector) const -> bool
+{
+  for (const std::uint32_t hash : selector.getAncestorHashes()) {
+    if (hash == 0) {
+      break;
+    }
+    if (!containsHash(hash)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto AncestorFilter::getHashes() const -> const std::vector<std::uint32_t>&
+{
+  return hashes;
+}
+
+/** Searches from the top of the stack, where the ancestor usually is. */
+auto AncestorFilter::contains(const bwWidget* widget) const -> bool
+{
+  for (auto iter = stack.rbegin(); iter != stack.rend(); ++iter) {
+    if (iter->widget == widget) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AncestorFilter::push(const bwWidget& widget)
+{
+  const std::size_t first_hash_index = hashes.size();
+
+  hashes.push_back(name_hash(NameKind::TYPE, widget.getTypeIdentifier()));
+  if (widget.getStyleID() != bwAtom()) {
+    hashes.push_back(name_hash(NameKind::ID, widget.getStyleID()));
+  }
+  for (const bwAtom class_name : widget.getStyleClasses()) {
+    hashes.push_back(name_hash(NameKind::CLASS, class_name));
+  }
+
+  for (std::size_t i = first_hash_index; i < hashes.size(); i++) {
+    filter_counter_increment(counters[filter_index1(hashes[i], BITS)]);
+    filter_counter_increment(counters[filter_index2(hashes[i], BITS)]);
+  }
+  stack.push_back({&widget, hashes.size() - first_hash_index});
+}
+
+void AncestorFilter::pop()
+{
+  for (std::size_t i = hashes.size() - stack.back().hash_count; i < hashes.size(); i++) {
+    filter_counter_decrement(counters[filter_index1(hashes[i], BITS)]);
+    filter_counter_decrement(counters[filter_index2(hashes[i], BITS)]);
+  }
+  hashes.resize(hashes.size() - stack.back().hash_count);
+  stack.pop_back();
+}
+
+auto AncestorFilter::containsHash(const std::uint32_t hash) const -> bool
+{
+  return counters[filter_index1(hash, BITS)] && counters[filter_index2(hash, BITS)];
+}
+
+/** \} */
+
+}  // namespace bWidgetsDemo
@@ -0,0 +1,150 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "bwWidget.h"
+
+namespace bWidgetsDemo {
+
+/**
+ * \brief A compound selector, e.g. `bwPushButton.primary:hover`: all the conditions a single
+ * widget has to meet. Empty parts match any widget.
+ */
+struct CompoundSelector {
+  /** Empty atom for `*` or no type. */
+  bWidgets::bwAtom type;
+  bWidgets::bwAtom id;
+  std::vector<bWidgets::bwAtom> classes;
+  /** `:hover` and `:active`. */
+  std::optional<bWidgets::bwWidget::State> state;
+
+  auto matches(const bWidgets::bwWidget& widget) const -> bool;
+  /** Match something that isn't a widget, but is styled like one (e.g. the stage background). */
+  auto matches(bWidgets::bwAtom type_identifier, bWidgets::bwWidget::State state) const -> bool;
+};
+
+/**
+ * \brief A complex selector, e.g. `bwPanel > .toolbar bwPushButton:hover`: compound selectors
+ * joined by descendant or child combinators.
+ *
+ * Like in browsers, the compounds are stored and matched right to left. The rightmost one (the
+ * subject) is checked against the widget itself, the others against its ancestors.
+ */
+class StyleSelector {
+ public:
+  enum class Combinator {
+    DESCENDANT,
+    CHILD,
+  };
+
+  /** Hashes of type, ID and class names the ancestors must have, see \ref AncestorFilter. */
+  static constexpr int MAX_ANCESTOR_HASHES = 4;
+  using AncestorHashes = std::array<std::uint32_t, MAX_ANCESTOR_HASHES>;
+
+  /**
+   * Compounds are added right to left, starting with the subject.
+   * \param combinator: How the compound relates to the one added before it (the one to its
+   *                    right). Ignored for the subject.
+   */
+  void addCompound(CompoundSelector compound, Combinator combinator = Combinator::DESCENDANT);
+
+  auto getSubject() const -> const CompoundSelector&;
+  auto hasAncestorCompounds() const -> bool;
+  /** Number of compounds, the subject is at index 0. */
+  auto getCompoundCount() const -> std::size_t;
+  auto getCompound(std::size_t index) const -> const CompoundSelector&;
+  /** How the compound at \a index relates to the one at `index - 1`. */
+  auto getCombinator(std::size_t index) const -> Combinator;
+  /** `(ids << 20) | (classes << 10) | types`, compared like in CSS. */
+  auto getSpecificity() const -> unsigned int;
+  /** Zero terminated if there are less than #MAX_ANCESTOR_HASHES. */
+  auto getAncestorHashes() const -> const AncestorHashes&;
+
+  auto matches(const bWidgets::bwWidget& widget) const -> bool;
+  /** Only check the compounds for the ancestors, the subject is expected to match already. */
+  auto matchesAncestors(const bWidgets::bwWidget& widget) const -> bool;
+
+ private:
+  struct Component {
+    CompoundSelector compound;
+    /** Relation to the previous component. */
+    Combinator combinator;
+  };
+
+  auto matchesAncestorsFrom(std::size_t component_index, const bWidgets::bwWidget& widget) const
+      -> bool;
+  void addAncestorHash(std::uint32_t hash);
+
+  /** The subject first. */
+  std::vector<Component> components;
+  unsigned int specificity{0};
+  AncestorHashes ancestor_hashes{};
+};
+
+/**
+ * \brief Counting Bloom filter of the type, ID and class names of the ancestors of a widget.
+ *
+ * Lets selectors that can't match because of their ancestor compounds be rejected without
+ * walking up the screen-graph: if one of the names a selector requires isn't in the filter, no
+ * ancestor has it (false positives are possible, false negatives aren't).
+ *
+ * Keeps a stack of the ancestors it contains. Widgets are styled in drawing order (depth first),
+ * so moving to the next widget is mostly pushing or popping a single ancestor.
+ */
+class AncestorFilter {
+ public:
+  /** Make the filter contain exactly the ancestors of \a widget. */
+  void prepareFor(const bWidgets::bwWidget& widget);
+  /** Forget all ancestors. Needed before the widgets on the stack may be freed. */
+  void clear();
+
+  auto mayMatch(const StyleSelector& selector) const -> bool;
+  /** The exact hashes of the names of all ancestors, the ones the filter is built from. */
+  auto getHashes() const -> const std::vector<std::uint32_t>&;
+
+ private:
+  static constexpr int BITS = 12;
+
+  struct Entry {
+    const bWidgets::bwWidget* widget;
+    /** Number of #hashes added for the widget. Stored, in case its names change while it's on
+     * the stack. */
+    std::size_t hash_count;
+  };
+
+  auto contains(const bWidgets::bwWidget* widget) const -> bool;
+  void push(const bWidgets::bwWidget& widget);
+  void pop();
+  auto containsHash(std::uint32_t hash) const -> bool;
+
+  std::vector<Entry> stack;
+  std::vector<std::uint32_t> hashes;
+  /** Counters saturate at their maximum, they are never decremented from there. */
+  std::array<std::uint8_t, 1 << BITS> counters{};
+};
+
+}  // namespace bWidgetsDemo
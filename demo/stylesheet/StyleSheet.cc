@@ -19,13 +19,12 @@
  * ***** END GPL LICENSE BLOCK *****
  */
 
-#include <cassert>
-#include <fstream>
-#include <iostream>
-
+#include "BuiltinStyleSheets.h"
+#include "CompiledStyleTable.h"
 #include "File.h"
-#include "PropertyParser.h"
-#include "StyleSheetTree.h"
+#include "FileWatcher.h"
+#include "StyleRuleSet.h"
+#include "StyleSheetParser.h"
 
 #include "StyleSheet.h"
 
@@ -43,133 +42,92 @@ StyleSheet::~StyleSheet()
   unload();
 }
 
-// TODO Right now the type of properties in the style sheet is decided based on
-// the value they have set. E.g. "border-width: rgba(...)" would add a bwColor
-// property to the tree. Instead we should have a global map of property types
-// with the property identifier as key. Then we can check if the CSS rule is
-// valid for the property.
-
-static bwStyleProperty::Type stylesheet_property_type_get_from_katana(const KatanaValue& value)
+/**
+ * Style sheets shipped with the application are compiled into tables at build time (see
+ * \ref BuiltinStyleSheet), so they don't have to be parsed. Any other content, e.g. a shipped
+ * style sheet edited after building, is parsed.
+ */
+static auto stylesheet_rule_set_from_file(const std::string& filepath)
+    -> std::unique_ptr<StyleRuleSet>
 {
-  switch (value.unit) {
-    case KATANA_VALUE_PARSER_FUNCTION: {
-      std::string function_name{value.function->name};
-      if ((function_name == "rgb(") || (function_name == "rgba(")) {
-        return bwStyleProperty::Type::COLOR;
-      }
-      break;
-    }
-    case KATANA_VALUE_PX:
-      return bwStyleProperty::Type::FLOAT;
-    case KATANA_VALUE_IDENT: {
-      // Customization to support booleans in CSS.
-      const std::string ident_value{value.string};
-      assert(ident_value == "true" || ident_value == "false");
-      return bwStyleProperty::Type::BOOL;
-    }
-    default:
-      return bwStyleProperty::Type::INTEGER;
-  }
+  File file{filepath};
+  const std::string file_contents = file.readIntoString();
 
-  return bwStyleProperty::Type::INTEGER;
+  if (const BuiltinStyleSheet* builtin = findBuiltinStyleSheet(file_contents)) {
+    return ruleSetFromBuiltinStyleSheet(*builtin);
+  }
+  return parseStyleSheet(file_contents);
 }
 
-static void stylesheet_set_value_from_katana_value(bwStyleProperty& property,
-                                                   const KatanaValue& value)
+void StyleSheet::load()
 {
-  std::unique_ptr<PropertyParser> parser(PropertyParser::newFromPropertyType(property.getType()));
-  parser->parseIntoProperty(property, value);
+  compiled_table = nullptr;
+  ancestor_filter.clear();
+  rule_set = stylesheet_rule_set_from_file(filepath);
 }
 
-static bwWidget::State stylesheet_property_state_from_katana(const KatanaSelector& selector)
+void StyleSheet::unload()
 {
-  KatanaPseudoType pseudo_type = selector.tagHistory ? selector.tagHistory->pseudo :
-                                                       KatanaPseudoEmpty;
-
-  switch (pseudo_type) {
-    case KatanaPseudoHover:
-      return bwWidget::State::HIGHLIGHTED;
-    case KatanaPseudoActive:
-      return bwWidget::State::SUNKEN;
-    case KatanaPseudoEmpty:
-    default:
-      return bwWidget::State::NORMAL;
-  }
+  // Nothing right now.
 }
 
-static void stylesheet_tree_property_ensure_from_katana(StyleSheetTree& tree,
-                                                        const KatanaSelector& selector,
-                                                        const KatanaDeclaration& declaration,
-                                                        const KatanaValue& value)
+void StyleSheet::reload()
 {
-  bwStyleProperty& property = tree.ensureNodeWithProperty(
-      selector.tag->local,
-      stylesheet_property_state_from_katana(selector),
-      declaration.property,
-      stylesheet_property_type_get_from_katana(value));
-  stylesheet_set_value_from_katana_value(property, value);
+  unload();
+  load();
 }
 
-static void stylesheet_tree_node_fill_from_katana(StyleSheetTree& tree,
-                                                  const KatanaStyleRule& rule,
-                                                  const KatanaSelector& selector)
+void StyleSheet::watch(std::function<void()> changed_fn)
 {
-  for (unsigned int declaration_idx = 0; declaration_idx < rule.declarations->length;
-       declaration_idx++) {
-    auto* declaration = (KatanaDeclaration*)rule.declarations->data[declaration_idx];
-
-    for (unsigned int value_idx = 0; value_idx < declaration->values->length; value_idx++) {
-      auto* value = (KatanaValue*)declaration->values->data[value_idx];
-      stylesheet_tree_property_ensure_from_katana(tree, selector, *declaration, *value);
+  watcher = std::make_unique<FileWatcher>(filepath, [this, changed_fn = std::move(changed_fn)]() {
+    /* Parse without the lock, only the swap has to be synchronized. */
+    std::unique_ptr<StyleRuleSet> new_rule_set = stylesheet_rule_set_from_file(filepath);
+    {
+      std::lock_guard<std::mutex> lock(pending_rule_set_mutex);
+      pending_rule_set = std::move(new_rule_set);
+      has_pending_rule_set = true;
     }
-  }
-}
-
-static void stylesheet_tree_fill_from_katana(StyleSheetTree& tree,
-                                             const KatanaOutput& katana_output)
-{
-  for (unsigned int rule_idx = 0; rule_idx < katana_output.stylesheet->rules.length; rule_idx++) {
-    const auto* rule = (KatanaStyleRule*)katana_output.stylesheet->rules.data[rule_idx];
-
-    for (unsigned int selector_idx = 0; selector_idx < rule->selectors->length; selector_idx++) {
-      auto* selector = (KatanaSelector*)rule->selectors->data[selector_idx];
-      stylesheet_tree_node_fill_from_katana(tree, *rule, *selector);
+    if (changed_fn) {
+      changed_fn();
     }
-  }
+  });
 }
 
-void StyleSheet::load()
+auto StyleSheet::update() -> bool
 {
-  File file{filepath};
-  std::string file_contents = file.readIntoString();
-  KatanaOutput* katana_output = katana_parse(
-      file_contents.c_str(), file_contents.length(), KatanaParserModeStylesheet);
+  /* Widgets of the last frame may be gone. */
+  ancestor_filter.clear();
 
-  tree = std::make_unique<StyleSheetTree>();
-  stylesheet_tree_fill_from_katana(*tree, *katana_output);
-  katana_destroy_output(katana_output);
-}
+  if (!has_pending_rule_set) {
+    return false;
+  }
 
-void StyleSheet::unload()
-{
-  // Nothing right now.
+  std::unique_ptr<StyleRuleSet> old_rule_set;
+  {
+    std::lock_guard<std::mutex> lock(pending_rule_set_mutex);
+    compiled_table = nullptr;
+    old_rule_set = std::move(rule_set);
+    rule_set = std::move(pending_rule_set);
+    has_pending_rule_set = false;
+  }
+  /* old_rule_set is freed here, outside of the lock. */
+  return true;
 }
 
-void StyleSheet::reload()
+auto StyleSheet::hasPendingUpdate() const -> bool
 {
-  unload();
-  load();
+  return has_pending_rule_set;
 }
 
-void StyleSheet::resolveValue(const std::string_view& class_name,
+void StyleSheet::resolveValue(const bwAtom class_name,
                               const bwWidget::State state,
                               bwStyleProperty& property)
 {
-  const bwStyleProperty* property_from_tree = tree->resolveProperty(
+  const bwStyleProperty* property_from_rules = rule_set->resolveProperty(
       class_name, property.getIdentifier(), state);
 
-  if (property_from_tree) {
-    property.setValue(*property_from_tree);
+  if (property_from_rules) {
+    property.setValue(*property_from_rules);
   }
   else {
     property.setValueToDefault();
@@ -180,6 +138,15 @@ void StyleSheet::resolveValue(const std::string_view& class_name,
   }
 }
 
+void StyleSheet::polishWidget(bwWidget& widget)
+{
+  if (!compiled_table) {
+    compiled_table = std::make_unique<CompiledStyleTable>(*rule_set);
+  }
+  ancestor_filter.prepareFor(widget);
+  compiled_table->polish(widget, ancestor_filter);
+}
+
 const std::string& StyleSheet::getFilepath() const
 {
   return filepath;
@@ -21,9 +21,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include "bwUtil.h"
 
-#include "katana.h"
+#include "StyleSelector.h"
 
 namespace bWidgets {
 class bwStyleProperty;
@@ -38,9 +44,31 @@ class StyleSheet {
 
   void reload();
 
-  void resolveValue(const std::string_view& class_name,
+  /**
+   * Reparse the file on a background thread whenever it changes (see \ref FileWatcher).
+   * \param changed_fn: Called from the background thread once a new version is parsed, e.g. to
+   *                    wake up the application so it calls #update().
+   */
+  void watch(std::function<void()> changed_fn);
+  /**
+   * Swap in the version parsed in the background, if any. Call it from the thread resolving
+   * values, between frames, so a frame never mixes two versions. Also needed for widgets freed
+   * since the last frame to be forgotten.
+   * \return True if a new version was swapped in.
+   */
+  auto update() -> bool;
+  /** A new version was parsed in the background, but not swapped in yet. */
+  auto hasPendingUpdate() const -> bool;
+
+  void resolveValue(bWidgets::bwAtom class_name,
                     bWidgets::bwWidget::State state,
                     bWidgets::bwStyleProperty& property);
+  /**
+   * Set all style properties of \a widget to the values of the rules matching it. Widgets are
+   * expected to be polished in drawing order (parents before children), then matching rules by
+   * the widget's ancestors is cheap, see \ref AncestorFilter and \ref CompiledStyleTable.
+   */
+  void polishWidget(bWidgets::bwWidget& widget);
 
   const std::string& getFilepath() const;
 
@@ -49,7 +77,19 @@ class StyleSheet {
   void unload();
 
   std::string filepath;
-  std::unique_ptr<class StyleSheetTree> tree;
+  std::unique_ptr<class StyleRuleSet> rule_set;
+  /** Compiled from #rule_set, lazily. */
+  std::unique_ptr<class CompiledStyleTable> compiled_table;
+  /** Ancestors of the widget polished last. */
+  AncestorFilter ancestor_filter;
+
+  /** Written by the watcher thread, swapped into #rule_set by #update(). */
+  std::unique_ptr<class StyleRuleSet> pending_rule_set;
+  std::mutex pending_rule_set_mutex;
+  std::atomic<bool> has_pending_rule_set{false};
+
+  /* Last, so it's stopped before the members it uses are destructed. */
+  std::unique_ptr<class FileWatcher> watcher;
 };
 
 }  // namespace bWidgetsDemo
@@ -0,0 +1,273 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/**
+ * \file
+ * Build tool compiling CSS files into constant tables of \ref BuiltinStyleSheet, so the style
+ * sheets shipped with the application don't have to be parsed at runtime.
+ *
+ * Usage: `bwd_style_sheet_compiler <output.cc> <input.css>...`
+ *
+ * The CSS is parsed with the same code as at runtime (\ref parseStyleSheet()), and the resulting
+ * \ref StyleRuleSet is written out. So the tables resolve to exactly what parsing would.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bwColor.h"
+
+#include "BuiltinStyleSheets.h"
+#include "File.h"
+#include "StyleRuleSet.h"
+#include "StyleSheetParser.h"
+
+using namespace bWidgets;
+using namespace bWidgetsDemo;
+
+namespace {
+
+auto quoted(const std::string_view string) -> std::string
+{
+  std::string result = "\"";
+  for (const char c : string) {
+    if ((c == '"') || (c == '\\')) {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result + '"';
+}
+
+/** Shortest literal reading back as exactly \a value. */
+auto float_literal(const float value) -> std::string
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+
+  std::string literal = buffer;
+  if (literal.find_first_of(".e") == std::string::npos) {
+    literal += ".0";
+  }
+  return literal + 'f';
+}
+
+auto state_literal(const bwWidget::State state) -> const char*
+{
+  switch (state) {
+    case bwWidget::State::NORMAL:
+      return "bwWidget::State::NORMAL";
+    case bwWidget::State::HIGHLIGHTED:
+      return "bwWidget::State::HIGHLIGHTED";
+    case bwWidget::State::SUNKEN:
+      return "bwWidget::State::SUNKEN";
+    case bwWidget::State::STATE_TOT:
+      break;
+  }
+  return "bwWidget::State::NORMAL";
+}
+
+auto type_literal(const bwStyleProperty::Type type) -> const char*
+{
+  switch (type) {
+    case bwStyleProperty::Type::BOOL:
+      return "bwStyleProperty::Type::BOOL";
+    case bwStyleProperty::Type::INTEGER:
+      return "bwStyleProperty::Type::INTEGER";
+    case bwStyleProperty::Type::FLOAT:
+      return "bwStyleProperty::Type::FLOAT";
+    case bwStyleProperty::Type::COLOR:
+      return "bwStyleProperty::Type::COLOR";
+  }
+  return "bwStyleProperty::Type::INTEGER";
+}
+
+void write_compounds(std::ostream& out, const std::string& prefix, const StyleSelector& selector)
+{
+  for (std::size_t i = 0; i < selector.getCompoundCount(); i++) {
+    const CompoundSelector& compound = selector.getCompound(i);
+    if (compound.classes.empty()) {
+      continue;
+    }
+    out << "constexpr const char* " << prefix << "_compound" << i << "_classes[] = {";
+    for (const bwAtom class_name : compound.classes) {
+      out << quoted(class_name.str()) << ", ";
+    }
+    out << "};\n";
+  }
+
+  out << "constexpr BuiltinCompoundSelector " << prefix << "_compounds[] = {\n";
+  for (std::size_t i = 0; i < selector.getCompoundCount(); i++) {
+    const CompoundSelector& compound = selector.getCompound(i);
+    const char* combinator = (selector.getCombinator(i) == StyleSelector::Combinator::CHILD) ?
+                                 "StyleSelector::Combinator::CHILD" :
+                                 "StyleSelector::Combinator::DESCENDANT";
+
+    out << "    {" << quoted(compound.type.str()) << ", " << quoted(compound.id.str()) << ", ";
+    if (compound.classes.empty()) {
+      out << "nullptr, 0, ";
+    }
+    else {
+      out << prefix << "_compound" << i << "_classes, " << compound.classes.size() << ", ";
+    }
+    out << (compound.state ? "true, " : "false, ")
+        << state_literal(compound.state.value_or(bwWidget::State::NORMAL)) << ", " << combinator
+        << "},\n";
+  }
+  out << "};\n";
+}
+
+void write_declarations(std::ostream& out,
+                        const std::string& prefix,
+                        const bwStyleProperties& declarations)
+{
+  out << "constexpr BuiltinDeclaration " << prefix << "_declarations[] = {\n";
+  for (const bwStyleProperty& property : declarations) {
+    const bwStyleProperty::Type type = property.getType();
+    const float* color = (type == bwStyleProperty::Type::COLOR) ?
+                             property.getValue<bwColor>().getColor() :
+                             nullptr;
+
+    out << "    {" << quoted(property.getIdentifier().str()) << ", " << type_literal(type) << ", "
+        << ((type == bwStyleProperty::Type::BOOL) && property.getValue<bool>() ? "true" : "false")
+        << ", " << ((type == bwStyleProperty::Type::INTEGER) ? property.getValue<int>() : 0)
+        << ", "
+        << float_literal((type == bwStyleProperty::Type::FLOAT) ? property.getValue<float>() :
+                                                                  0.0f)
+        << ", {";
+    for (int i = 0; i < 4; i++) {
+      out << float_literal(color ? color[i] : 0.0f) << ((i < 3) ? ", " : "");
+    }
+    out << "}},\n";
+  }
+  out << "};\n";
+}
+
+void write_style_sheet(std::ostream& out, const std::string& prefix, const StyleRuleSet& rule_set)
+{
+  const auto& rules = rule_set.getRules();
+
+  for (std::size_t i = 0; i < rules.size(); i++) {
+    const std::string rule_prefix = prefix + "_rule" + std::to_string(i);
+    write_compounds(out, rule_prefix, rules[i]->selector);
+    if (rules[i]->declarations.begin() != rules[i]->declarations.end()) {
+      write_declarations(out, rule_prefix, rules[i]->declarations);
+    }
+  }
+
+  out << "constexpr BuiltinStyleRule " << prefix << "_rules[] = {\n";
+  for (std::size_t i = 0; i < rules.size(); i++) {
+    const std::string rule_prefix = prefix + "_rule" + std::to_string(i);
+    const bwStyleProperties& declarations = rules[i]->declarations;
+    const auto declaration_count = std::distance(declarations.begin(), declarations.end());
+
+    out << "    {" << rule_prefix << "_compounds, " << rules[i]->selector.getCompoundCount()
+        << ", ";
+    if (declaration_count) {
+      out << rule_prefix << "_declarations, " << declaration_count;
+    }
+    else {
+      out << "nullptr, 0";
+    }
+    out << "},\n";
+  }
+  out << "};\n\n";
+}
+
+auto file_name(const std::string& path) -> std::string
+{
+  const std::size_t separator = path.find_last_of("/\\");
+  return (separator == std::string::npos) ? path : path.substr(separator + 1);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <output.cc> <input.css>..." << std::endl;
+    return 1;
+  }
+
+  std::ostringstream out;
+  out << "/* Generated by bwd_style_sheet_compiler, do not edit. */\n\n"
+      << "#include \"BuiltinStyleSheets.h\"\n\n"
+      << "using namespace bWidgets;\n\n"
+      << "namespace bWidgetsDemo {\n\n"
+      << "namespace {\n\n";
+
+  struct SheetInfo {
+    std::string name;
+    std::uint64_t source_hash;
+    std::size_t source_length;
+    std::size_t rule_count;
+  };
+  std::vector<SheetInfo> sheets;
+
+  for (int i = 2; i < argc; i++) {
+    const std::string path = argv[i];
+    if (!std::ifstream(path).is_open()) {
+      std::cerr << "Error: Can't open style sheet \"" << path << "\"" << std::endl;
+      return 1;
+    }
+
+    /* Read it like the application does, so the hash matches. */
+    File file{path};
+    const std::string source = file.readIntoString();
+    const std::unique_ptr<StyleRuleSet> rule_set = parseStyleSheet(source);
+
+    write_style_sheet(out, "sheet" + std::to_string(sheets.size()), *rule_set);
+    sheets.push_back({file_name(path),
+                      styleSheetSourceHash(source),
+                      source.length(),
+                      rule_set->getRules().size()});
+  }
+
+  out << "}  // namespace\n\n";
+  out << "extern const BuiltinStyleSheet builtin_style_sheets[] = {\n";
+  for (std::size_t i = 0; i < sheets.size(); i++) {
+    const std::string prefix = "sheet" + std::to_string(i);
+    out << "    {" << quoted(sheets[i].name) << ", " << sheets[i].source_hash << "ull, "
+        << sheets[i].source_length << ", " << prefix << "_rules, " << sheets[i].rule_count
+        << "},\n";
+  }
+  if (sheets.empty()) {
+    /* Arrays can't be empty. */
+    out << "    {\"\", 0, 0, nullptr, 0},\n";
+  }
+  out << "};\n"
+      << "extern const std::size_t builtin_style_sheet_count = " << sheets.size() << ";\n\n"
+      << "}  // namespace bWidgetsDemo\n";
+
+  const std::string output_path = argv[1];
+  std::ofstream output(output_path);
+  output << out.str();
+  if (!output) {
+    std::cerr << "Error: Can't write \"" << output_path << "\"" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
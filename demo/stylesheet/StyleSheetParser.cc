@@ -0,0 +1,207 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#include <cassert>
+#include <memory>
+#include <optional>
+
+#include "PropertyParser.h"
+#include "StyleRuleSet.h"
+
+#include "katana.h"
+
+#include "StyleSheetParser.h"
+
+using namespace bWidgets;
+
+namespace bWidgetsDemo {
+
+// TODO Right now the type of properties in the style sheet is decided based on
+// the value they have set. E.g. "border-width: rgba(...)" would add a bwColor
+// property to the rule set. Instead we should have a global map of property types
+// with the property identifier as key. Then we can check if the CSS rule is
+// valid for the property.
+
+static bwStyleProperty::Type stylesheet_property_type_get_from_katana(const KatanaValue& value)
+{
+  switch (value.unit) {
+    case KATANA_VALUE_PARSER_FUNCTION: {
+      std::string function_name{value.function->name};
+      if ((function_name == "rgb(") || (function_name == "rgba(")) {
+        return bwStyleProperty::Type::COLOR;
+      }
+      break;
+    }
+    case KATANA_VALUE_PX:
+      return bwStyleProperty::Type::FLOAT;
+    case KATANA_VALUE_IDENT: {
+      // Customization to support booleans in CSS.
+      const std::string ident_value{value.string};
+      assert(ident_value == "true" || ident_value == "false");
+      return bwStyleProperty::Type::BOOL;
+    }
+    default:
+      return bwStyleProperty::Type::INTEGER;
+  }
+
+  return bwStyleProperty::Type::INTEGER;
+}
+
+static void stylesheet_set_value_from_katana_value(bwStyleProperty& property,
+                                                   const KatanaValue& value)
+{
+  std::unique_ptr<PropertyParser> parser(PropertyParser::newFromPropertyType(property.getType()));
+  parser->parseIntoProperty(property, value);
+}
+
+static auto stylesheet_state_from_katana_pseudo(const KatanaPseudoType pseudo_type)
+    -> std::optional<bwWidget::State>
+{
+  switch (pseudo_type) {
+    case KatanaPseudoHover:
+      return bwWidget::State::HIGHLIGHTED;
+    case KatanaPseudoActive:
+      return bwWidget::State::SUNKEN;
+    default:
+      return std::nullopt;
+  }
+}
+
+/**
+ * Katana stores the simple selectors of a complex selector right to left, linked through
+ * `tagHistory`. The last simple selector of each compound has the combinator relating it to the
+ * next compound (to its left) as `relation`.
+ *
+ * \return Nothing if the selector uses features not supported for widgets (attribute selectors,
+ *         sibling combinators, other pseudo-classes, ...).
+ */
+static auto stylesheet_selector_from_katana(const KatanaSelector& katana_selector)
+    -> std::optional<StyleSelector>
+{
+  StyleSelector selector;
+  CompoundSelector compound;
+  StyleSelector::Combinator combinator = StyleSelector::Combinator::DESCENDANT;
+
+  for (const KatanaSelector* simple = &katana_selector; simple; simple = simple->tagHistory) {
+    switch (simple->match) {
+      case KatanaSelectorMatchTag:
+        if (std::string_view(simple->tag->local) != "*") {
+          compound.type = bwAtom(simple->tag->local);
+        }
+        break;
+      case KatanaSelectorMatchId:
+        compound.id = bwAtom(simple->data->value);
+        break;
+      case KatanaSelectorMatchClass:
+        compound.classes.emplace_back(simple->data->value);
+        break;
+      case KatanaSelectorMatchPseudoClass:
+        compound.state = stylesheet_state_from_katana_pseudo(simple->pseudo);
+        if (!compound.state) {
+          return std::nullopt;
+        }
+        break;
+      default:
+        return std::nullopt;
+    }
+
+    if (simple->relation == KatanaSelectorRelationSubSelector) {
+      continue;
+    }
+    /* End of a compound. */
+    selector.addCompound(std::move(compound), combinator);
+    compound = {};
+    switch (simple->relation) {
+      case KatanaSelectorRelationDescendant:
+        combinator = StyleSelector::Combinator::DESCENDANT;
+        break;
+      case KatanaSelectorRelationChild:
+        combinator = StyleSelector::Combinator::CHILD;
+        break;
+      default:
+        return std::nullopt;
+    }
+  }
+  selector.addCompound(std::move(compound), combinator);
+
+  return selector;
+}
+
+static auto stylesheet_declaration_ensure(bwStyleProperties& declarations,
+                                          const std::string_view& identifier,
+                                          const bwStyleProperty::Type type) -> bwStyleProperty&
+{
+  for (auto& declaration : declarations) {
+    if (declaration.getIdentifier().str() == identifier) {
+      return declaration;
+    }
+  }
+
+  return declarations.addProperty(identifier, type);
+}
+
+static void stylesheet_declarations_fill_from_katana(bwStyleProperties& declarations,
+                                                     const KatanaStyleRule& rule)
+{
+  for (unsigned int declaration_idx = 0; declaration_idx < rule.declarations->length;
+       declaration_idx++) {
+    auto* declaration = (KatanaDeclaration*)rule.declarations->data[declaration_idx];
+
+    for (unsigned int value_idx = 0; value_idx < declaration->values->length; value_idx++) {
+      auto* value = (KatanaValue*)declaration->values->data[value_idx];
+      bwStyleProperty& property = stylesheet_declaration_ensure(
+          declarations, declaration->property, stylesheet_property_type_get_from_katana(*value));
+      stylesheet_set_value_from_katana_value(property, *value);
+    }
+  }
+}
+
+static void stylesheet_rule_set_fill_from_katana(StyleRuleSet& rule_set,
+                                                 const KatanaOutput& katana_output)
+{
+  for (unsigned int rule_idx = 0; rule_idx < katana_output.stylesheet->rules.length; rule_idx++) {
+    const auto* rule = (KatanaStyleRule*)katana_output.stylesheet->rules.data[rule_idx];
+
+    /* `a, b {...}` is the same as `a {...} b {...}`. */
+    for (unsigned int selector_idx = 0; selector_idx < rule->selectors->length; selector_idx++) {
+      auto* katana_selector = (KatanaSelector*)rule->selectors->data[selector_idx];
+
+      if (std::optional<StyleSelector> selector = stylesheet_selector_from_katana(
+              *katana_selector)) {
+        stylesheet_declarations_fill_from_katana(rule_set.addRule(std::move(*selector)), *rule);
+      }
+    }
+  }
+}
+
+auto parseStyleSheet(const std::string_view source) -> std::unique_ptr<StyleRuleSet>
+{
+  KatanaOutput* katana_output = katana_parse(
+      source.data(), source.length(), KatanaParserModeStylesheet);
+
+  auto rule_set = std::make_unique<StyleRuleSet>();
+  stylesheet_rule_set_fill_from_katana(*rule_set, *katana_output);
+  katana_destroy_output(katana_output);
+
+  return rule_set;
+}
+
+}  // namespace bWidgetsDemo
@@ -0,0 +1,97 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace bWidgetsDemo {
+
+/**
+ * \brief Bounded, lock-free queue for exactly one producer and one consumer thread.
+ *
+ * Ring buffer where the producer only writes the tail index and the consumer only writes the
+ * head index, so neither ever has to wait for a lock held by the other. Useful to pass input
+ * from the platform thread to the UI thread, without either blocking the other.
+ */
+template<typename _Type, std::size_t _Capacity> class SPSCQueue {
+  static_assert((_Capacity & (_Capacity - 1)) == 0, "Capacity must be a power of two");
+
+ public:
+  /**
+   * Only to be called from the producer thread.
+   * \return False if the queue is full, in which case nothing is added.
+   */
+  auto tryPush(_Type value) -> bool
+  {
+    const std::size_t tail = tail_index.load(std::memory_order_relaxed);
+
+    if ((tail - head_index.load(std::memory_order_acquire)) == _Capacity) {
+      return false;
+    }
+
+    slots[tail & (_Capacity - 1)] = std::move(value);
+    /* Publish the slot to the consumer only after it was written. */
+    tail_index.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Only to be called from the consumer thread.
+   * \return The oldest value in the queue, or nothing if the queue is empty.
+   */
+  auto tryPop() -> std::optional<_Type>
+  {
+    const std::size_t head = head_index.load(std::memory_order_relaxed);
+
+    if (head == tail_index.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+
+    std::optional<_Type>& slot = slots[head & (_Capacity - 1)];
+    std::optional<_Type> value = std::move(slot);
+    slot.reset();
+    /* Give the slot back to the producer only after it was read. */
+    head_index.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  /** May be called from either thread, the result may be outdated when returned. */
+  auto isEmpty() const -> bool
+  {
+    return head_index.load(std::memory_order_acquire) ==
+           tail_index.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::array<std::optional<_Type>, _Capacity> slots;
+  /* Indices only ever grow (wrapping around is fine with unsigned arithmetic), they are mapped
+   * into the ring on access. Separate cache lines, so the threads don't invalidate each other's
+   * cache. */
+  alignas(64) std::atomic<std::size_t> head_index{0};
+  alignas(64) std::atomic<std::size_t> tail_index{0};
+};
+
+}  // namespace bWidgetsDemo
@@ -25,7 +25,15 @@
 
 namespace bWidgetsDemo {
 
-bWidgets::bwPoint MouseEvent::location{};
+Event::Event() : timestamp(std::chrono::steady_clock::now())
+{
+}
+
+auto Event::getTimestamp() const -> Timestamp
+{
+  return timestamp;
+}
+
 bWidgets::bwPoint MouseEvent::last_down_location{};
 MouseEvent::Button MouseEvent::last_down_button = Button::UNKNOWN;
 
@@ -65,9 +73,18 @@ auto MouseEvent::getType() const -> Type
   return type;
 }
 
-auto MouseEvent::getMouseLocation() -> const bWidgets::bwPoint&
+auto MouseEvent::getMouseLocation() const -> const bWidgets::bwPoint&
 {
   return location;
 }
 
+ResizeEvent::ResizeEvent(int width, int height) : width(width), height(height)
+{
+}
+
+ContentScaleEvent::ContentScaleEvent(float scale_x, float scale_y)
+    : scale_x(scale_x), scale_y(scale_y)
+{
+}
+
 }  // namespace bWidgetsDemo
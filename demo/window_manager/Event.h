@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <variant>
+
 #include "bwDistance.h"
 #include "bwEvent.h"
 #include "bwWidget.h"
@@ -30,11 +33,20 @@ namespace bWidgetsDemo {
 class Event {
   friend class EventManager;
 
+ public:
+  using Timestamp = std::chrono::steady_clock::time_point;
+
+  /** The time the event was received from the platform. */
+  auto getTimestamp() const -> Timestamp;
+
  protected:
-  Event() = default;
+  Event();
+
+ private:
+  Timestamp timestamp;
 };
 
-class MouseEvent : Event {
+class MouseEvent : public Event {
  public:
   enum class Type {
     PRESS,
@@ -55,16 +67,35 @@ class MouseEvent : Event {
   auto getButton() const -> Button;
   auto getType() const -> Type;
 
-  static auto getMouseLocation() -> const bWidgets::bwPoint&;
+  auto getMouseLocation() const -> const bWidgets::bwPoint&;
 
  private:
   Type type;
   Button button;
+  /* Stored per event, since events may be handled later on a different thread (see
+   * \ref UIThread). */
+  bWidgets::bwPoint location;
 
-  static bWidgets::bwPoint location;
   // Location during previous mouse button press.
   static bWidgets::bwPoint last_down_location;
   static Button last_down_button;
 };
 
+class ResizeEvent : public Event {
+ public:
+  ResizeEvent(int width, int height);
+
+  int width, height;
+};
+
+class ContentScaleEvent : public Event {
+ public:
+  ContentScaleEvent(float scale_x, float scale_y);
+
+  float scale_x, scale_y;
+};
+
+/** Any event a window can receive. */
+using WindowEvent = std::variant<MouseEvent, ResizeEvent, ContentScaleEvent>;
+
 }  // namespace bWidgetsDemo
@@ -25,6 +25,7 @@
 
 #include "GPU.h"
 #include "Stage.h"
+#include "UIThread.h"
 
 #include "EventManager.h"
 
@@ -38,9 +39,20 @@ EventManager& EventManager::ensureEventManager()
   return instance;
 }
 
-void EventManager::waitEvents()
+void EventManager::waitEvents(std::optional<std::chrono::steady_clock::time_point> timeout_time)
 {
-  glfwWaitEvents();
+  if (!timeout_time) {
+    glfwWaitEvents();
+    return;
+  }
+
+  const std::chrono::duration<double> timeout = *timeout_time - std::chrono::steady_clock::now();
+  if (timeout.count() > 0.0) {
+    glfwWaitEventsTimeout(timeout.count());
+  }
+  else {
+    glfwPollEvents();
+  }
 }
 
 bool EventManager::processEvents(WindowManager::WindowList& windows)
@@ -64,6 +76,21 @@ bool EventManager::processEvents(WindowManager::WindowList& windows)
   return true;
 }
 
+void EventManager::setUIThread(UIThread* _ui_thread)
+{
+  ui_thread = _ui_thread;
+}
+
+void EventManager::handleEvent(Window& win, WindowEvent event)
+{
+  if (UIThread* ui_thread = ensureEventManager().ui_thread) {
+    ui_thread->pushEvent(win, std::move(event));
+  }
+  else {
+    win.handleEvent(event);
+  }
+}
+
 void EventManager::setupWindowHandlers(Window& window)
 {
   GLFWwindow& glfw_window = window.getGlfwWindow();
@@ -79,7 +106,7 @@ void EventManager::setupWindowHandlers(Window& window)
 void EventManager::handleWindowResizeEvent(GLFWwindow* glfw_win, int new_win_x, int new_win_y)
 {
   auto* win = (Window*)glfwGetWindowUserPointer(glfw_win);
-  win->handleResizeEvent(new_win_x, new_win_y);
+  handleEvent(*win, ResizeEvent(new_win_x, new_win_y));
 }
 
 void EventManager::handleWindowContentScaleEvent(GLFWwindow* glfw_win,
@@ -87,7 +114,7 @@ void EventManager::handleWindowContentScaleEvent(GLFWwindow* glfw_win,
                                                  float new_scale_y)
 {
   auto* win = (Window*)glfwGetWindowUserPointer(glfw_win);
-  win->handleContentScaleEvent(new_scale_x, new_scale_y);
+  handleEvent(*win, ContentScaleEvent(new_scale_x, new_scale_y));
 }
 
 bwMouseButtonEvent::Button EventManager::convertGlfwMouseButton(int glfw_button)
@@ -116,11 +143,11 @@ MouseEvent::Type EventManager::convertGlfwMouseButtonAction(int glfw_action)
 
 void EventManager::handleMouseMovementEvent(GLFWwindow* glfw_win, double /*x*/, double /*y*/)
 {
-  const Window* win = (Window*)glfwGetWindowUserPointer(glfw_win);
+  auto* win = (Window*)glfwGetWindowUserPointer(glfw_win);
   const bwPoint& position = win->getCursorPosition();
   MouseEvent event(MouseEvent::Type::MOVE, bwMouseButtonEvent::Button::UNKNOWN, position);
 
-  win->stage->handleMouseMovementEvent(event);
+  handleEvent(*win, event);
 }
 
 void EventManager::handleMouseButtonEvent(GLFWwindow* glfw_win,
@@ -128,13 +155,13 @@ void EventManager::handleMouseButtonEvent(GLFWwindow* glfw_win,
                                           int glfw_action,
                                           int /*glfw_mods*/)
 {
-  const Window* win = (Window*)glfwGetWindowUserPointer(glfw_win);
+  auto* win = (Window*)glfwGetWindowUserPointer(glfw_win);
   const bwPoint& position = win->getCursorPosition();
   const MouseEvent::Type action_type = convertGlfwMouseButtonAction(glfw_action);
   const bwMouseButtonEvent::Button mouse_button = convertGlfwMouseButton(glfw_button);
   MouseEvent event(action_type, mouse_button, position);
 
-  win->stage->handleMouseButtonEvent(event);
+  handleEvent(*win, event);
 }
 
 void EventManager::handleMouseScrollEvent(GLFWwindow* glfw_win, double /*value_x*/, double value_y)
@@ -143,15 +170,13 @@ void EventManager::handleMouseScrollEvent(GLFWwindow* glfw_win, double /*value_x
     return;
   }
 
-  const Window* win = (Window*)glfwGetWindowUserPointer(glfw_win);
+  auto* win = (Window*)glfwGetWindowUserPointer(glfw_win);
   const MouseEvent::Type event_type = (value_y > 0) ? MouseEvent::Type::SCROLL_UP :
                                                       MouseEvent::Type::SCROLL_DOWN;
   const bwPoint& position = win->getCursorPosition();
   MouseEvent event(event_type, bwMouseButtonEvent::Button::WHEEL, position);
-  bwMouseWheelEvent::Direction dir = (value_y > 0) ? bwMouseWheelEvent::Direction::UP :
-                                                     bwMouseWheelEvent::Direction::DOWN;
 
-  win->stage->handleMouseScrollEvent(event, dir);
+  handleEvent(*win, event);
 }
 
 }  // namespace bWidgetsDemo
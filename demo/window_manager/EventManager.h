@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <optional>
+
 #include "bwWidget.h"
 
 #include "WindowManager.h"
@@ -37,9 +40,13 @@ class EventManager {
   static auto ensureEventManager() -> EventManager&;
   static void setupWindowHandlers(Window& window);
 
-  void waitEvents();
+  /** Wait until there are platform events to handle, or until \a timeout_time if set. */
+  void waitEvents(std::optional<std::chrono::steady_clock::time_point> timeout_time = {});
   auto processEvents(WindowManager::WindowList& windows) -> bool;
 
+  /** While set, events are passed to \a ui_thread, instead of being handled right away. */
+  void setUIThread(class UIThread* ui_thread);
+
   auto isClickEvent() -> bool;
 
  private:
@@ -49,6 +56,8 @@ class EventManager {
 
   void operator=(EventManager const&) = delete;
 
+  static void handleEvent(Window& win, WindowEvent event);
+
   static void handleWindowResizeEvent(GLFWwindow* glfw_win, int new_win_x, int new_win_y);
   static void handleWindowContentScaleEvent(GLFWwindow* glfw_win,
                                             float new_scale_x,
@@ -61,6 +70,8 @@ class EventManager {
   static void handleMouseScrollEvent(GLFWwindow* glfw_win, double value_x, double value_y);
   static auto convertGlfwMouseButton(int glfw_button) -> bWidgets::bwMouseButtonEvent::Button;
   static auto convertGlfwMouseButtonAction(int glfw_action) -> MouseEvent::Type;
+
+  class UIThread* ui_thread{nullptr};
 };
 
 }  // namespace bWidgetsDemo
@@ -0,0 +1,143 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+#include <algorithm>
+
+#include "Window.h"
+
+#include "UIThread.h"
+
+namespace bWidgetsDemo {
+
+UIThread::UIThread(std::list<Window>& windows, bWidgets::bwFrameScheduler& frame_scheduler)
+    : windows(windows), frame_scheduler(frame_scheduler), thread(&UIThread::run, this)
+{
+}
+
+UIThread::~UIThread()
+{
+  stop_requested = true;
+  wakeUp();
+  thread.join();
+}
+
+void UIThread::pushEvent(Window& win, WindowEvent event)
+{
+  QueuedEvent queued_event{&win, std::move(event)};
+
+  while (!event_queue.tryPush(queued_event)) {
+    /* Full, the UI thread is busy with a slow frame. Wait for it rather than dropping input. */
+    wakeUp();
+    std::this_thread::yield();
+  }
+}
+
+void UIThread::submitEvents()
+{
+  events_submitted = true;
+  wakeUp();
+}
+
+auto UIThread::getMaxInputLatency() const -> std::chrono::microseconds
+{
+  return std::chrono::microseconds(max_input_latency.load());
+}
+
+void UIThread::wakeUp()
+{
+  {
+    /* Lock so the notification can't get lost between the UI thread checking for work and
+     * starting to wait. */
+    std::lock_guard<std::mutex> lock(wakeup_mutex);
+  }
+  wakeup_condition.notify_one();
+}
+
+void UIThread::waitForWork()
+{
+  std::unique_lock<std::mutex> lock(wakeup_mutex);
+  auto has_work = [this]() {
+    return stop_requested || events_submitted || !event_queue.isEmpty();
+  };
+
+  /* Also wake up for the next frame, if one was requested. */
+  const auto next_frame_time = frame_scheduler.getNextFrameTime();
+  if (next_frame_time) {
+    wakeup_condition.wait_until(lock, *next_frame_time, has_work);
+  }
+  else {
+    wakeup_condition.wait(lock, has_work);
+  }
+}
+
+void UIThread::handleQueuedEvents()
+{
+  while (std::optional<QueuedEvent> queued_event = event_queue.tryPop()) {
+    const Event::Timestamp timestamp = std::visit(
+        [](const Event& event) { return event.getTimestamp(); }, queued_event->event);
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - timestamp);
+
+    /* Only this thread writes it. */
+    if (latency.count() > max_input_latency) {
+      max_input_latency = latency.count();
+    }
+
+    queued_event->window->handleEvent(queued_event->event);
+  }
+}
+
+void UIThread::run()
+{
+  while (true) {
+    waitForWork();
+    if (stop_requested) {
+      break;
+    }
+
+    events_submitted = false;
+    handleQueuedEvents();
+
+    for (Window& win : windows) {
+      if (win.needsFrame()) {
+        frame_scheduler.requestFrame();
+      }
+    }
+    if (!frame_scheduler.beginFrame()) {
+      continue;
+    }
+
+    for (Window& win : windows) {
+      win.acquireContext();
+      /* Closing is handled by the platform thread. */
+      if (win.processEvents() == Window::WINDOW_ACTION_CONTINUE) {
+        win.drawFrame();
+      }
+    }
+    /* Keep waking up for running animations, even without events. */
+    frame_scheduler.endFrame(std::any_of(
+        windows.begin(), windows.end(), [](const Window& win) { return win.needsFrame(); }));
+  }
+
+  Window::releaseContext();
+}
+
+}  // namespace bWidgetsDemo
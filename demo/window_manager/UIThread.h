@@ -0,0 +1,103 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Original work Copyright (c) 2018 Julian Eisel
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#include "bwFrameScheduler.h"
+
+#include "SPSCQueue.h"
+
+#include "Event.h"
+
+namespace bWidgetsDemo {
+
+class Window;
+
+/**
+ * \brief Thread running the stages of all windows: event handling, layout and drawing.
+ *
+ * Keeps the platform (GLFW) thread responsive during slow frames, and slow event handling from
+ * delaying frames. The platform thread pushes events into a lock-free queue, the UI thread
+ * handles all queued events at the beginning of each frame. Events are never dropped: if the
+ * queue is full, the platform thread waits for the UI thread to catch up. Frames are paced by a
+ * \ref bWidgets::bwFrameScheduler, which is only used by the UI thread while it runs.
+ *
+ * The UI thread makes the GL contexts of the windows current on itself, so they have to be
+ * released by the platform thread before. Stopped and joined on destruction.
+ */
+class UIThread {
+ public:
+  UIThread(std::list<Window>& windows, bWidgets::bwFrameScheduler& frame_scheduler);
+  ~UIThread();
+
+  /** \name Platform thread functions
+   * \{ */
+
+  void pushEvent(Window& win, WindowEvent event);
+  /** Let the UI thread handle all events pushed until now. It only draws if they changed
+   * anything. */
+  void submitEvents();
+
+  /** \} */
+
+  /** Longest time an event was waiting to be handled by the UI thread. */
+  auto getMaxInputLatency() const -> std::chrono::microseconds;
+
+ private:
+  /** 1024 events are more than the platform sends within a single frame, even at 1000 Hz. */
+  static constexpr std::size_t QUEUE_CAPACITY = 1024;
+
+  struct QueuedEvent {
+    Window* window;
+    WindowEvent event;
+  };
+
+  void run();
+  void waitForWork();
+  void wakeUp();
+  void handleQueuedEvents();
+
+  std::list<Window>& windows;
+  bWidgets::bwFrameScheduler& frame_scheduler;
+
+  SPSCQueue<QueuedEvent, QUEUE_CAPACITY> event_queue;
+  std::atomic<bool> events_submitted{true};
+  std::atomic<bool> stop_requested{false};
+  /* Only used to let the UI thread sleep while there's nothing to do. Never held while handling
+   * events or drawing. */
+  std::mutex wakeup_mutex;
+  std::condition_variable wakeup_condition;
+
+  std::atomic<std::chrono::microseconds::rep> max_input_latency{0};
+
+  /* Last, so all members are initialized before the thread starts. */
+  std::thread thread;
+};
+
+}  // namespace bWidgetsDemo
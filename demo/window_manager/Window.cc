@@ -73,6 +73,8 @@ Window::Window(const std::string& name, unsigned int size_x, unsigned int size_y
 
 Window::~Window()
 {
+  acquireContext();
+
   /* Let stage destruct shaders first. */
   stage = nullptr;
 
@@ -97,15 +99,46 @@ void Window::draw()
   glfwSwapBuffers(glfw_window);
 }
 
+void Window::acquireContext()
+{
+  glfwMakeContextCurrent(glfw_window);
+}
+
+void Window::releaseContext()
+{
+  GWN_context_active_set(nullptr);
+  glfwMakeContextCurrent(nullptr);
+}
+
 auto Window::processEvents() -> Window::WindowAction
 {
-  if (glfwWindowShouldClose(glfw_window)) {
+  if (shouldClose()) {
     return WINDOW_ACTION_CLOSE;
   }
 
   return WINDOW_ACTION_CONTINUE;
 }
 
+auto Window::needsFrame() const -> bool
+{
+  return stage->needsFrame();
+}
+
+void Window::drawFrame()
+{
+  /* Platform callbacks only queue events, handle them once per frame. */
+  stage->flushEvents();
+
+  if (stage->needsRedraw()) {
+    draw();
+  }
+}
+
+auto Window::shouldClose() const -> bool
+{
+  return glfwWindowShouldClose(glfw_window);
+}
+
 auto Window::getCursorPosition() const -> bWidgets::bwPoint
 {
   int win_size_y;
@@ -128,6 +161,40 @@ auto Window::getCursorPosition() const -> bWidgets::bwPoint
   return position;
 }
 
+void Window::handleEvent(const WindowEvent& event)
+{
+  if (const auto* mouse_event = std::get_if<MouseEvent>(&event)) {
+    handleMouseEvent(*mouse_event);
+  }
+  else if (const auto* resize_event = std::get_if<ResizeEvent>(&event)) {
+    handleResizeEvent(resize_event->width, resize_event->height);
+  }
+  else if (const auto* scale_event = std::get_if<ContentScaleEvent>(&event)) {
+    handleContentScaleEvent(scale_event->scale_x, scale_event->scale_y);
+  }
+}
+
+void Window::handleMouseEvent(const MouseEvent& event)
+{
+  switch (event.getType()) {
+    case MouseEvent::Type::MOVE:
+      stage->handleMouseMovementEvent(event);
+      break;
+    case MouseEvent::Type::PRESS:
+    case MouseEvent::Type::RELEASE:
+      stage->handleMouseButtonEvent(event);
+      break;
+    case MouseEvent::Type::SCROLL_UP:
+      stage->handleMouseScrollEvent(event, bwMouseWheelEvent::Direction::UP);
+      break;
+    case MouseEvent::Type::SCROLL_DOWN:
+      stage->handleMouseScrollEvent(event, bwMouseWheelEvent::Direction::DOWN);
+      break;
+    case MouseEvent::Type::UNKNOWN:
+      break;
+  }
+}
+
 void Window::handleResizeEvent(const int new_win_x, const int new_win_y)
 {
   width = new_win_x;
@@ -140,6 +207,11 @@ void Window::handleContentScaleEvent(const float new_scale_x, const float new_sc
   stage->setContentScale(new_scale_x, new_scale_y);
 }
 
+auto Window::startEventRecording(const std::string& filepath) -> bool
+{
+  return stage->startEventRecording(filepath);
+}
+
 auto Window::getGlfwWindow() const -> GLFWwindow&
 {
   return *glfw_window;
@@ -26,6 +26,8 @@
 
 #include "bwUtil.h"
 
+#include "Event.h"
+
 struct GLFWwindow;
 struct Gwn_Context;
 
@@ -45,11 +47,24 @@ class Window {
     WINDOW_ACTION_CLOSE,
   };
   auto processEvents() -> WindowAction;
+  auto shouldClose() const -> bool;
   void draw();
+  /** See \ref Stage::needsFrame(). */
+  auto needsFrame() const -> bool;
+  /** Handle the events queued since the last frame, then redraw if anything changed. */
+  void drawFrame();
+
+  /** Make the GL context of this window current on the calling thread. */
+  void acquireContext();
+  /** Release whichever GL context is current on the calling thread. */
+  static void releaseContext();
 
   auto getCursorPosition() const -> bWidgets::bwPoint;
+  void handleEvent(const WindowEvent& event);
   void handleResizeEvent(const int new_win_x, const int new_win_y);
   void handleContentScaleEvent(const float new_scale_x, const float new_scale_y);
+  /** See \ref Stage::startEventRecording(). */
+  auto startEventRecording(const std::string& filepath) -> bool;
 
   std::unique_ptr<class Stage> stage;
 
@@ -70,6 +85,8 @@ class Window {
   }
 
  private:
+  void handleMouseEvent(const MouseEvent& event);
+
   GLFWwindow* glfw_window;
   Gwn_Context* gwn_context;
   unsigned int VertexArrayID = 0;
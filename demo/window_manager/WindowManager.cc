@@ -19,11 +19,13 @@
  * ***** END GPL LICENSE BLOCK *****
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include "GPU.h"
 
 #include "EventManager.h"
+#include "UIThread.h"
 
 #include "WindowManager.h"
 
@@ -58,7 +60,8 @@ WindowManager::~WindowManager()
 
 WindowManager::WindowManagerAction WindowManager::processEvents()
 {
-  event_manager.waitEvents();
+  /* Sleep until there are platform events, or until the next frame is due. */
+  event_manager.waitEvents(frame_scheduler.getNextFrameTime());
   if (!event_manager.processEvents(windows)) {
     return WM_ACTION_CLOSE;
   }
@@ -66,20 +69,93 @@ WindowManager::WindowManagerAction WindowManager::processEvents()
   return WM_ACTION_CONTINUE;
 }
 
+/**
+ * Produce a frame if any window needs one and the frame rate allows it. Events that don't change
+ * anything are handled without redrawing.
+ */
 void WindowManager::drawWindows()
 {
   for (Window& win : windows) {
-    win.draw();
+    if (win.needsFrame()) {
+      frame_scheduler.requestFrame();
+    }
+  }
+  if (!frame_scheduler.beginFrame()) {
+    return;
+  }
+
+  for (Window& win : windows) {
+    win.drawFrame();
+  }
+  /* Keep waking up for running animations, even without platform events. */
+  frame_scheduler.endFrame(std::any_of(
+      windows.begin(), windows.end(), [](const Window& win) { return win.needsFrame(); }));
+}
+
+/**
+ * Pace frames to the refresh rate of the monitor, more would never be visible.
+ */
+void WindowManager::updateTargetFrameRate()
+{
+  GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+  const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+
+  if (mode && (mode->refreshRate > 0)) {
+    frame_scheduler.setTargetFrameRate(mode->refreshRate);
   }
 }
 
 void WindowManager::mainLoop()
 {
+  updateTargetFrameRate();
+
+  if (use_ui_thread) {
+    mainLoopUIThread();
+    return;
+  }
+
   while (processEvents() == WM_ACTION_CONTINUE) {
     drawWindows();
   }
 }
 
+/**
+ * Only wait for platform events here and pass them on, the UI thread does everything else.
+ */
+void WindowManager::mainLoopUIThread()
+{
+  /* The UI thread draws, so it needs the GL contexts. */
+  Window::releaseContext();
+
+  {
+    UIThread ui_thread(windows, frame_scheduler);
+    event_manager.setUIThread(&ui_thread);
+
+    while (std::none_of(windows.begin(), windows.end(), [](const Window& win) {
+      return win.shouldClose();
+    })) {
+      event_manager.waitEvents();
+      ui_thread.submitEvents();
+    }
+
+    event_manager.setUIThread(nullptr);
+    if (print_input_latency) {
+      std::cout << "Longest input latency on UI thread: "
+                << ui_thread.getMaxInputLatency().count() / 1000.0f << " ms" << std::endl;
+    }
+  }
+}
+
+void WindowManager::setUseUIThread(bool value)
+{
+  use_ui_thread = value;
+}
+
+void WindowManager::setPrintInputLatency(bool value)
+{
+  print_input_latency = value;
+}
+
 Window& WindowManager::addWindow(std::string name)
 {
   windows.emplace_back(name);
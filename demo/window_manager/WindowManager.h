@@ -25,6 +25,7 @@
 #include <memory>
 #include <optional>
 
+#include "bwFrameScheduler.h"
 #include "bwUtil.h"
 
 #include "Window.h"
@@ -38,6 +39,10 @@ class WindowManager {
   ~WindowManager();
 
   void mainLoop();
+  /** Run the stages on a separate thread, see \ref UIThread. Set before calling #mainLoop(). */
+  void setUseUIThread(bool value);
+  /** Only measured when using the UI thread. */
+  void setPrintInputLatency(bool value);
   auto addWindow(std::string name) -> Window&;
   auto isMainWindow(const Window& win) const -> bool;
 
@@ -56,10 +61,16 @@ class WindowManager {
   };
   auto processEvents() -> WindowManagerAction;
   void drawWindows();
+  void updateTargetFrameRate();
+  void mainLoopUIThread();
 
   class EventManager& event_manager;
+  /** Frames are only produced when a window needs one, see \ref bWidgets::bwFrameScheduler. */
+  bWidgets::bwFrameScheduler frame_scheduler;
   WindowList windows;
   Window* main_win;
+  bool use_ui_thread{false};
+  bool print_input_latency{false};
 };
 
 }  // namespace bWidgetsDemo
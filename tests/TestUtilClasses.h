@@ -1,6 +1,10 @@
 #pragma once
 
 #include <cassert>
+#include <string>
+#include <utility>
+
+#include "bwLayoutInterface.h"
 
 namespace TestUtilClasses {
 
@@ -215,4 +219,27 @@ class CustomSwap {
   int _value;
 };
 
+/**
+ * Layout for building screen graphs in tests. Its rectangle is fixed (but can be changed), the
+ * label helps telling nodes apart.
+ */
+class DummyLayout : public bWidgets::bwLayoutInterface {
+ public:
+  explicit DummyLayout(std::string label = "", bWidgets::bwRectanglePixel rect = {})
+      : label(std::move(label)), rect(rect)
+  {
+  }
+  explicit DummyLayout(bWidgets::bwRectanglePixel rect) : rect(rect)
+  {
+  }
+
+  auto getRectangle() -> bWidgets::bwRectanglePixel override
+  {
+    return rect;
+  }
+
+  std::string label;
+  bWidgets::bwRectanglePixel rect;
+};
+
 }  // namespace TestUtilClasses
@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwAnimator.h"
+#include "bwFrameScheduler.h"
+#include "bwLabel.h"
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/Mutator.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using namespace std::chrono_literals;
+using TestUtilClasses::DummyLayout;
+
+/** A row of labels, each 10 pixels wide. */
+class bwAnimatorTest : public ::testing::Test {
+ protected:
+  ScreenGraph screen_graph;
+  bwAnimator& animator;
+  std::vector<Node*> label_nodes;
+  bwAnimator::Clock::time_point start;
+
+  bwAnimatorTest() : screen_graph(std::make_unique<LayoutNode>()), animator(screen_graph.animator)
+  {
+    Builder::setLayout(screen_graph.Root(),
+                       std::make_unique<DummyLayout>(bwRectanglePixel{0, 1000, 0, 1000}));
+    Builder builder(screen_graph.Root());
+
+    for (int i = 0; i < 4; i++) {
+      bwLabel& label = builder.addWidget<bwLabel>("Label");
+      label.rectangle = {i * 10, i * 10 + 10, 0, 10};
+      label_nodes.push_back(screen_graph.Root().Children()->back().get());
+    }
+
+    start = animator.getTime();
+    screen_graph.Root().Layout()->clearDirty();
+    screen_graph.damage.clear();
+  }
+};
+
+TEST(bwInterpolationTest, interpolate)
+{
+  EXPECT_EQ(bwInterpolate(0, 10, 0.26f), 3);
+  EXPECT_EQ(bwInterpolate(10, 0, 1.0f), 0);
+  EXPECT_FLOAT_EQ(bwInterpolate(1.0f, 2.0f, 0.5f), 1.5f);
+
+  const bwRectanglePixel rect = bwInterpolate(
+      bwRectanglePixel{0, 10, 0, 10}, bwRectanglePixel{10, 30, 0, 0}, 0.5f);
+  EXPECT_EQ(rect.xmin, 5);
+  EXPECT_EQ(rect.xmax, 20);
+  EXPECT_EQ(rect.ymax, 5);
+
+  EXPECT_EQ(bwInterpolate(bwColor(0.0f, 0.0f), bwColor(1.0f, 1.0f), 0.5f), bwColor(0.5f, 0.5f));
+
+  for (bwEasing easing : {bwEasing::LINEAR, bwEasing::EASE_OUT, bwEasing::EASE_IN_OUT}) {
+    EXPECT_FLOAT_EQ(bwEase(easing, 0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(bwEase(easing, 1.0f), 1.0f);
+  }
+}
+
+TEST_F(bwAnimatorTest, animate)
+{
+  int value = 0;
+  animator.animate(
+      *label_nodes[0], &value, 0, 100, 100ms, bwEasing::LINEAR, [&value](int v) { value = v; });
+  EXPECT_TRUE(animator.isActive());
+
+  animator.advanceTo(start + 50ms);
+  EXPECT_EQ(value, 50);
+  EXPECT_TRUE(animator.isActive());
+
+  /* Ends exactly at the target value, even if the frame comes late. */
+  animator.advanceTo(start + 130ms);
+  EXPECT_EQ(value, 100);
+  EXPECT_FALSE(animator.isActive());
+
+  /* Nothing to do anymore. */
+  value = 0;
+  animator.advanceTo(start + 200ms);
+  EXPECT_EQ(value, 0);
+}
+
+/** Like the event loop of an application without any input events: only produce frames the
+ * scheduler asks for. */
+TEST_F(bwAnimatorTest, schedules_frames_while_active)
+{
+  bwFrameScheduler scheduler{100.0f};
+  int value = 0;
+  animator.animate(
+      *label_nodes[0], &value, 0, 100, 20ms, bwEasing::LINEAR, [&value](int v) { value = v; });
+
+  auto produceFrame = [&]() {
+    ASSERT_TRUE(scheduler.getNextFrameTime());
+    const bwFrameScheduler::Clock::time_point frame_time = *scheduler.getNextFrameTime();
+    ASSERT_TRUE(scheduler.beginFrame(frame_time));
+    animator.advanceTo(frame_time);
+    scheduler.endFrame(animator.isActive());
+  };
+
+  scheduler.requestFrame();
+  scheduler.beginFrame(start);
+  scheduler.endFrame(animator.isActive());
+
+  /* The next frame is due one interval later, without anything requesting it. */
+  ASSERT_TRUE(scheduler.getNextFrameTime());
+  EXPECT_EQ(*scheduler.getNextFrameTime(), start + 10ms);
+  produceFrame();
+  EXPECT_EQ(value, 50);
+  produceFrame();
+  EXPECT_EQ(value, 100);
+
+  /* Done, so the application can sleep until the next event. */
+  EXPECT_FALSE(animator.isActive());
+  EXPECT_TRUE(scheduler.isIdle());
+  EXPECT_EQ(scheduler.getFrameCount(), 3);
+}
+
+TEST_F(bwAnimatorTest, only_animated_nodes_redraw)
+{
+  bwColor color;
+  animator.animate(*label_nodes[1],
+                   &color,
+                   bwColor(0.0f),
+                   bwColor(1.0f),
+                   100ms,
+                   bwEasing::EASE_OUT,
+                   [&color](const bwColor& c) { color = c; });
+  EXPECT_FALSE(screen_graph.needsRedraw());
+
+  animator.advanceTo(start + 10ms);
+  EXPECT_TRUE(screen_graph.needsRedraw());
+  const bwRectanglePixel bounds = screen_graph.damage.getBounds();
+  EXPECT_EQ(bounds.xmin, 10);
+  EXPECT_EQ(bounds.xmax, 20);
+}
+
+TEST_F(bwAnimatorTest, replace_running)
+{
+  int value = 0;
+  auto setter = [&value](int v) { value = v; };
+
+  animator.animate(*label_nodes[0], &value, 0, 100, 100ms, bwEasing::LINEAR, setter);
+  animator.advanceTo(start + 50ms);
+  ASSERT_EQ(value, 50);
+
+  /* Same node and key, continue from the current value. */
+  animator.animate(*label_nodes[0], &value, value, 0, 100ms, bwEasing::LINEAR, setter);
+  EXPECT_EQ(animator.getAnimationCount(), 1);
+  animator.advanceTo(start + 100ms);
+  EXPECT_EQ(value, 25);
+
+  /* A different key is a separate animation. */
+  int other_value = 0;
+  animator.animate(*label_nodes[0],
+                   &other_value,
+                   0,
+                   10,
+                   10ms,
+                   bwEasing::LINEAR,
+                   [&other_value](int v) { other_value = v; });
+  EXPECT_EQ(animator.getAnimationCount(), 2);
+  EXPECT_TRUE(animator.isAnimating(*label_nodes[0], &other_value));
+
+  animator.cancel(*label_nodes[0], &value);
+  EXPECT_FALSE(animator.isAnimating(*label_nodes[0], &value));
+  EXPECT_EQ(animator.getAnimationCount(), 1);
+}
+
+TEST_F(bwAnimatorTest, removal_cancels)
+{
+  int values[4] = {};
+  for (int i = 0; i < 4; i++) {
+    animator.animate(*label_nodes[i],
+                     &values[i],
+                     0,
+                     100,
+                     100ms,
+                     bwEasing::LINEAR,
+                     [&values, i](int v) { values[i] = v; });
+  }
+
+  Mutator mutator(screen_graph);
+  mutator.remove(*label_nodes[2]);
+  EXPECT_EQ(animator.getAnimationCount(), 3);
+
+  animator.advanceTo(start + 100ms);
+  EXPECT_EQ(values[1], 100);
+  EXPECT_EQ(values[2], 0);
+}
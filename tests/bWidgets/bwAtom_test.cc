@@ -0,0 +1,81 @@
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "bwAtom.h"
+
+using namespace bWidgets;
+
+TEST(bwAtomTest, equal_strings_give_equal_atoms)
+{
+  const bwAtom a("bwAtomTest.same");
+  const bwAtom b(std::string("bwAtomTest.") + "same");
+  const bwAtom other("bwAtomTest.other");
+
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.getIndex(), b.getIndex());
+  EXPECT_NE(a, other);
+  EXPECT_NE(a.getIndex(), other.getIndex());
+  EXPECT_EQ(a.str(), "bwAtomTest.same");
+  /* Same storage, not just equal characters. */
+  EXPECT_EQ(a.str().data(), b.str().data());
+}
+
+TEST(bwAtomTest, empty)
+{
+  EXPECT_EQ(bwAtom(), bwAtom(""));
+  EXPECT_EQ(bwAtom().str(), "");
+  EXPECT_EQ(bwAtom().getIndex(), 0u);
+}
+
+TEST(bwAtomTest, index_is_dense)
+{
+  const unsigned int count_before = bwAtom::count();
+  const bwAtom atom("bwAtomTest.index_is_dense");
+
+  EXPECT_EQ(atom.getIndex(), count_before);
+  EXPECT_EQ(bwAtom::count(), count_before + 1);
+  /* Interning again doesn't add anything. */
+  EXPECT_EQ(bwAtom("bwAtomTest.index_is_dense").getIndex(), count_before);
+  EXPECT_EQ(bwAtom::count(), count_before + 1);
+}
+
+TEST(bwAtomTest, hash_map_key)
+{
+  std::unordered_map<bwAtom, int> map;
+  map[bwAtom("bwAtomTest.key1")] = 1;
+  map[bwAtom("bwAtomTest.key2")] = 2;
+
+  EXPECT_EQ(map.at(bwAtom("bwAtomTest.key1")), 1);
+  EXPECT_EQ(map.at(bwAtom("bwAtomTest.key2")), 2);
+  EXPECT_EQ(map.count(bwAtom("bwAtomTest.key3")), 0u);
+}
+
+TEST(bwAtomTest, concurrent_interning)
+{
+  constexpr int THREAD_COUNT = 8;
+  constexpr int STRING_COUNT = 500;
+  std::vector<std::vector<bwAtom>> atoms_by_thread(THREAD_COUNT);
+  std::vector<std::thread> threads;
+
+  for (int thread_index = 0; thread_index < THREAD_COUNT; thread_index++) {
+    threads.emplace_back([thread_index, &atoms_by_thread]() {
+      for (int i = 0; i < STRING_COUNT; i++) {
+        atoms_by_thread[thread_index].emplace_back("bwAtomTest.concurrent" + std::to_string(i));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < STRING_COUNT; i++) {
+    for (int thread_index = 1; thread_index < THREAD_COUNT; thread_index++) {
+      EXPECT_EQ(atoms_by_thread[thread_index][i], atoms_by_thread[0][i]);
+    }
+    EXPECT_EQ(atoms_by_thread[0][i].str(), "bwAtomTest.concurrent" + std::to_string(i));
+  }
+}
@@ -0,0 +1,128 @@
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "bwColor.h"
+#include "bwColorBatch.h"
+#include "bwInterpolation.h"
+
+using namespace bWidgets;
+
+namespace {
+
+/** Colors in and out of range, count not a multiple of any vector width. */
+auto test_colors() -> std::vector<bwColor>
+{
+  std::vector<bwColor> colors;
+  for (int i = 0; i < 37; i++) {
+    colors.emplace_back(i / 36.0f, 1.0f - i / 36.0f, (i % 5) * 0.3f - 0.2f, (i % 7) / 6.0f);
+  }
+  return colors;
+}
+
+void expect_colors_eq(const bwColor& a, const bwColor& b)
+{
+  for (int i = 0; i < 4; i++) {
+    EXPECT_FLOAT_EQ(a.getColor()[i], b.getColor()[i]);
+  }
+}
+
+}  // namespace
+
+TEST(bwColorRGBA8, round_trip_exact)
+{
+  for (unsigned int value = 0; value < 256; value++) {
+    const bwColorRGBA8 packed(value, 255 - value, value, value);
+    EXPECT_EQ(bwColorRGBA8(bwColor(packed)), packed);
+    /* Same as the constructor taking byte values. */
+    EXPECT_TRUE(bwColor(packed) == bwColor(value, 255 - value, value, value));
+    EXPECT_EQ(bwColorRGBA8::fromPacked(packed.getPacked()), packed);
+  }
+}
+
+TEST(bwColorRGBA8, from_float)
+{
+  const bwColorRGBA8 packed(bwColor(-0.5f, 1.5f, 0.5f, 1.0f / 255.0f));
+  EXPECT_EQ(packed, bwColorRGBA8(0, 255, 128, 1));
+
+  /* Rounded to the nearest value. */
+  EXPECT_EQ(bwColorRGBA8::componentFromFloat(10.4f / 255.0f), 10);
+  EXPECT_EQ(bwColorRGBA8::componentFromFloat(10.6f / 255.0f), 11);
+}
+
+TEST(bwColorBatch, shade)
+{
+  std::vector<bwColor> colors = test_colors();
+  const std::vector<bwColor> expected_colors = colors;
+
+  bwColorsShade(colors.data(), colors.size(), 0.3f, -0.2f);
+  for (std::size_t i = 0; i < colors.size(); i++) {
+    bwColor expected = expected_colors[i];
+    expect_colors_eq(colors[i], expected.shade(0.3f, -0.2f));
+  }
+}
+
+TEST(bwColorBatch, premultiply)
+{
+  std::vector<bwColor> colors = test_colors();
+  const std::vector<bwColor> original_colors = colors;
+
+  bwColorsPremultiply(colors.data(), colors.size());
+  for (std::size_t i = 0; i < colors.size(); i++) {
+    const float* rgba = original_colors[i].getColor();
+    expect_colors_eq(colors[i],
+                     bwColor(rgba[0] * rgba[3], rgba[1] * rgba[3], rgba[2] * rgba[3], rgba[3]));
+  }
+}
+
+TEST(bwColorBatch, interpolate)
+{
+  const bwColor from(0.1f, 0.2f, 0.9f, 1.0f);
+  const bwColor to(0.8f, 0.4f, 0.0f, 0.5f);
+  std::vector<float> facs;
+  for (int i = 0; i <= 20; i++) {
+    facs.push_back(i / 20.0f);
+  }
+  std::vector<bwColor> colors(facs.size());
+
+  bwColorsInterpolate(from, to, facs.data(), facs.size(), colors.data());
+  for (std::size_t i = 0; i < colors.size(); i++) {
+    expect_colors_eq(colors[i], bwInterpolate(from, to, facs[i]));
+  }
+}
+
+TEST(bwColorBatch, sample_lut)
+{
+  const bwColor lut[] = {bwColor(0.0f), bwColor(1.0f, 0.0f), bwColor(0.5f, 0.5f, 1.0f, 0.0f)};
+  const float positions[] = {0.0f, 0.25f, 0.5f, 0.75f, 1.0f, -1.0f, 2.0f, std::nanf("")};
+  const std::size_t count = std::size(positions);
+  bwColor colors[count];
+
+  bwColorsSampleLUT(lut, std::size(lut), positions, count, colors);
+  expect_colors_eq(colors[0], lut[0]);
+  expect_colors_eq(colors[1], bwInterpolate(lut[0], lut[1], 0.5f));
+  expect_colors_eq(colors[2], lut[1]);
+  expect_colors_eq(colors[3], bwInterpolate(lut[1], lut[2], 0.5f));
+  expect_colors_eq(colors[4], lut[2]);
+  /* Out of range positions are clamped. */
+  expect_colors_eq(colors[5], lut[0]);
+  expect_colors_eq(colors[6], lut[2]);
+  expect_colors_eq(colors[7], lut[0]);
+}
+
+TEST(bwColorBatch, convert_rgba8)
+{
+  const std::vector<bwColor> colors = test_colors();
+  std::vector<bwColorRGBA8> packed(colors.size());
+  std::vector<bwColor> unpacked(colors.size());
+
+  bwColorsToRGBA8(colors.data(), colors.size(), packed.data());
+  bwColorsFromRGBA8(packed.data(), packed.size(), unpacked.data());
+  for (std::size_t i = 0; i < colors.size(); i++) {
+    EXPECT_EQ(packed[i], bwColorRGBA8(colors[i]));
+    /* Exactly, not just close. */
+    EXPECT_TRUE(unpacked[i] == bwColor(packed[i]));
+  }
+}
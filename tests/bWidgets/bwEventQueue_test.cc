@@ -0,0 +1,114 @@
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwCheckbox.h"
+#include "bwEventQueue.h"
+
+#include "screen_graph/Builder.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+using EventType = bwEventQueue::EventType;
+
+/** Two checkboxes next to each other, left one at x 0-100, right one at x 100-200. */
+class bwEventQueueTest : public ::testing::Test {
+ protected:
+  ScreenGraph screen_graph;
+  bwEventQueue queue;
+  bwCheckbox* left_checkbox;
+  bwCheckbox* right_checkbox;
+
+  bwEventQueueTest()
+      : screen_graph(std::make_unique<LayoutNode>()), queue(screen_graph.event_dispatcher)
+  {
+    Builder::setLayout(screen_graph.Root(),
+                       std::make_unique<DummyLayout>(bwRectanglePixel{0, 200, 0, 100}));
+    Builder builder(screen_graph.Root());
+
+    left_checkbox = &builder.addWidget<bwCheckbox>("Left");
+    left_checkbox->rectangle = {0, 100, 0, 100};
+    right_checkbox = &builder.addWidget<bwCheckbox>("Right");
+    right_checkbox->rectangle = {100, 200, 0, 100};
+  }
+
+  auto hoveredWidget() const -> const bwWidget*
+  {
+    const Node* hovered = screen_graph.context.hovered;
+    return hovered ? hovered->Widget() : nullptr;
+  }
+};
+
+TEST_F(bwEventQueueTest, coalesce_movements)
+{
+  for (int i = 0; i < 100; i++) {
+    queue.pushMouseMovement({float(i % 2 ? 50 : 150), 50});
+  }
+  EXPECT_EQ(hoveredWidget(), nullptr);
+
+  queue.flush();
+  EXPECT_TRUE(queue.isEmpty());
+  /* Only the last movement matters. */
+  EXPECT_EQ(hoveredWidget(), left_checkbox);
+
+  const bwEventQueue::Statistics& statistics = queue.getStatistics();
+  EXPECT_EQ(statistics.raw_count[int(EventType::MOUSE_MOVE)], 100);
+  EXPECT_EQ(statistics.dispatched_count[int(EventType::MOUSE_MOVE)], 1);
+}
+
+TEST_F(bwEventQueueTest, keep_order)
+{
+  /* Press the right checkbox, then move over the left one, all within one frame. */
+  queue.pushMouseMovement({10, 50});
+  queue.pushMouseMovement({150, 50});
+  queue.pushMouseButtonPress(bwMouseButtonEvent::Button::LEFT, {150, 50});
+  queue.pushMouseButtonRelease(bwMouseButtonEvent::Button::LEFT, {150, 50});
+  queue.pushMouseMovement({60, 50});
+  queue.pushMouseMovement({50, 50});
+  queue.flush();
+
+  EXPECT_FALSE(left_checkbox->isChecked());
+  EXPECT_TRUE(right_checkbox->isChecked());
+  EXPECT_EQ(hoveredWidget(), left_checkbox);
+
+  const bwEventQueue::Statistics& statistics = queue.getStatistics();
+  EXPECT_EQ(statistics.totalRawCount(), 6);
+  EXPECT_EQ(statistics.totalDispatchedCount(), 4);
+}
+
+TEST_F(bwEventQueueTest, wheel_not_coalesced)
+{
+  queue.pushMouseMovement({50, 50});
+  for (int i = 0; i < 5; i++) {
+    queue.pushMouseWheel(bwMouseWheelEvent::Direction::DOWN, {50, 50});
+  }
+  queue.flush();
+
+  const bwEventQueue::Statistics& statistics = queue.getStatistics();
+  EXPECT_EQ(statistics.dispatched_count[int(EventType::MOUSE_WHEEL)], 5);
+
+  queue.resetStatistics();
+  EXPECT_EQ(queue.getStatistics().totalRawCount(), 0);
+}
+
+TEST_F(bwEventQueueTest, coalesce_resizes)
+{
+  std::vector<std::pair<int, int>> sizes;
+  queue.resize_handler = [&sizes](int width, int height) { sizes.emplace_back(width, height); };
+
+  queue.pushResize(300, 200);
+  queue.pushResize(310, 210);
+  /* Movements and resizes don't depend on each other, so a movement doesn't stop coalescing. */
+  queue.pushMouseMovement({50, 50});
+  queue.pushResize(320, 220);
+  queue.flush();
+
+  ASSERT_EQ(sizes.size(), 1);
+  EXPECT_EQ(sizes.front(), std::make_pair(320, 220));
+  EXPECT_EQ(hoveredWidget(), left_checkbox);
+}
@@ -0,0 +1,128 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwEventRecording.h"
+#include "screen_graph/Builder.h"
+
+using namespace bWidgets;
+using TestUtilClasses::DummyLayout;
+
+using EventType = bwEventQueue::EventType;
+
+class bwEventRecordingTest : public ::testing::Test {
+ protected:
+  bwScreenGraph::ScreenGraph screen_graph{std::make_unique<bwScreenGraph::LayoutNode>()};
+  bwEventQueue queue{screen_graph.event_dispatcher};
+
+  bwEventRecordingTest()
+  {
+    bwScreenGraph::Builder::setLayout(
+        screen_graph.Root(), std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}));
+  }
+
+  /** Push a few events over two frames, with \a recorder attached to the queue. */
+  void recordEvents(bwEventRecorder& recorder)
+  {
+    queue.setRecorder(&recorder);
+
+    queue.pushMouseMovement({1.5f, 2});
+    queue.pushMouseMovement({3, 4.25f});
+    queue.pushMouseButtonPress(bwMouseButtonEvent::Button::LEFT, {3, 4.25f});
+    queue.flush();
+
+    queue.pushResize(800, 600);
+    queue.pushMouseWheel(bwMouseWheelEvent::Direction::DOWN, {-10, 1000});
+    queue.pushMouseButtonRelease(bwMouseButtonEvent::Button::RIGHT, {5, 6});
+    queue.flush();
+
+    /* Not flushed, so not part of the recording. */
+    queue.pushMouseMovement({7, 8});
+    queue.setRecorder(nullptr);
+  }
+};
+
+TEST_F(bwEventRecordingTest, round_trip)
+{
+  std::stringstream stream;
+  bwEventRecorder recorder(stream);
+  recordEvents(recorder);
+
+  const std::optional<bwEventRecording> recording = bwEventRecording::read(stream);
+  ASSERT_TRUE(recording);
+  ASSERT_EQ(recording->frames.size(), 2);
+
+  const auto& first_events = recording->frames[0].events;
+  ASSERT_EQ(first_events.size(), 3);
+  EXPECT_EQ(first_events[0].event.type, EventType::MOUSE_MOVE);
+  EXPECT_EQ(first_events[0].event.location, bwPoint(1.5f, 2));
+  EXPECT_EQ(first_events[1].event.location, bwPoint(3, 4.25f));
+  EXPECT_EQ(first_events[2].event.type, EventType::MOUSE_BUTTON_PRESS);
+  EXPECT_EQ(first_events[2].event.button, bwMouseButtonEvent::Button::LEFT);
+
+  const auto& second_events = recording->frames[1].events;
+  ASSERT_EQ(second_events.size(), 3);
+  EXPECT_EQ(second_events[0].event.type, EventType::RESIZE);
+  EXPECT_EQ(second_events[0].event.width, 800);
+  EXPECT_EQ(second_events[0].event.height, 600);
+  EXPECT_EQ(second_events[1].event.type, EventType::MOUSE_WHEEL);
+  EXPECT_EQ(second_events[1].event.direction, bwMouseWheelEvent::Direction::DOWN);
+  EXPECT_EQ(second_events[1].event.location, bwPoint(-10, 1000));
+  EXPECT_EQ(second_events[2].event.type, EventType::MOUSE_BUTTON_RELEASE);
+  EXPECT_EQ(second_events[2].event.button, bwMouseButtonEvent::Button::RIGHT);
+
+  /* Timestamps never go backwards. */
+  EXPECT_LE(first_events.back().time, recording->frames[0].flush_time);
+  EXPECT_LE(recording->frames[0].flush_time, second_events.front().time);
+}
+
+TEST_F(bwEventRecordingTest, compact)
+{
+  std::stringstream stream;
+  bwEventRecorder recorder(stream);
+  queue.setRecorder(&recorder);
+
+  const std::streamoff header_size = stream.str().size();
+  queue.pushMouseMovement({100, 200});
+
+  /* Type, time delta (one byte unless the machine is very slow) and two floats. */
+  EXPECT_LE(stream.str().size() - header_size, 10);
+}
+
+TEST_F(bwEventRecordingTest, replay)
+{
+  std::stringstream stream;
+  bwEventRecorder recorder(stream);
+  recordEvents(recorder);
+  queue.resetStatistics();
+
+  const std::optional<bwEventRecording> recording = bwEventRecording::read(stream);
+  ASSERT_TRUE(recording);
+  for (const bwEventRecording::Frame& frame : recording->frames) {
+    bwEventRecording::replayFrame(frame, queue);
+  }
+
+  /* The two movements in the first frame are coalesced again. */
+  EXPECT_EQ(queue.getStatistics().totalRawCount(), 6);
+  EXPECT_EQ(queue.getStatistics().totalDispatchedCount(), 5);
+}
+
+TEST_F(bwEventRecordingTest, invalid_input)
+{
+  std::stringstream empty_stream;
+  EXPECT_FALSE(bwEventRecording::read(empty_stream));
+
+  std::stringstream wrong_magic("abcd\x01");
+  EXPECT_FALSE(bwEventRecording::read(wrong_magic));
+
+  std::stringstream stream;
+  bwEventRecorder recorder(stream);
+  recordEvents(recorder);
+  /* Cut off in the middle of the last event. */
+  std::string data = stream.str();
+  data.resize(data.size() - 3);
+  std::stringstream truncated(data);
+  EXPECT_FALSE(bwEventRecording::read(truncated));
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include "bwFrameScheduler.h"
+
+using namespace bWidgets;
+using namespace std::chrono_literals;
+
+class FrameSchedulerTest : public ::testing::Test {
+ protected:
+  /* 100 FPS, so a frame interval of 10 ms. */
+  bwFrameScheduler scheduler{100.0f};
+  const bwFrameScheduler::Clock::time_point start{};
+};
+
+TEST_F(FrameSchedulerTest, idle_without_requests)
+{
+  EXPECT_TRUE(scheduler.isIdle());
+  EXPECT_FALSE(scheduler.getNextFrameTime());
+  EXPECT_FALSE(scheduler.beginFrame(start));
+  EXPECT_EQ(scheduler.getFrameCount(), 0);
+}
+
+TEST_F(FrameSchedulerTest, first_request_is_immediate)
+{
+  scheduler.requestFrame();
+  EXPECT_FALSE(scheduler.isIdle());
+  EXPECT_TRUE(scheduler.beginFrame(start));
+
+  /* The request is consumed by the frame. */
+  EXPECT_TRUE(scheduler.isIdle());
+  EXPECT_FALSE(scheduler.beginFrame(start + 1s));
+  EXPECT_EQ(scheduler.getFrameCount(), 1);
+}
+
+TEST_F(FrameSchedulerTest, paced_to_frame_rate)
+{
+  scheduler.requestFrame();
+  ASSERT_TRUE(scheduler.beginFrame(start));
+
+  /* Many requests within one frame interval result in a single frame. */
+  for (int i = 0; i < 10; i++) {
+    scheduler.requestFrame();
+    EXPECT_FALSE(scheduler.beginFrame(start + 1ms * i));
+  }
+  ASSERT_TRUE(scheduler.getNextFrameTime());
+  EXPECT_EQ(*scheduler.getNextFrameTime(), start + scheduler.getFrameInterval());
+  EXPECT_TRUE(scheduler.beginFrame(start + 10ms));
+  EXPECT_EQ(scheduler.getFrameCount(), 2);
+
+  /* After being idle for longer than the interval, frames are immediate again. */
+  scheduler.requestFrame();
+  EXPECT_TRUE(scheduler.beginFrame(start + 1s));
+}
+
+TEST_F(FrameSchedulerTest, request_at_time)
+{
+  scheduler.requestFrameAt(start + 50ms);
+  EXPECT_FALSE(scheduler.beginFrame(start + 49ms));
+
+  /* Earlier requests win. */
+  scheduler.requestFrameAt(start + 20ms);
+  scheduler.requestFrameAt(start + 80ms);
+  EXPECT_EQ(*scheduler.getNextFrameTime(), start + 20ms);
+  EXPECT_TRUE(scheduler.beginFrame(start + 25ms));
+
+  /* Requests within the frame interval are delayed. */
+  scheduler.requestFrameAt(start + 30ms);
+  EXPECT_EQ(*scheduler.getNextFrameTime(), start + 35ms);
+}
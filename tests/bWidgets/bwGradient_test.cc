@@ -0,0 +1,140 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "bwColorBatch.h"
+#include "bwGradient.h"
+#include "bwPoint.h"
+
+using namespace bWidgets;
+
+namespace {
+
+/* y points up, ymax is the top. */
+const bwRectanglePixel box{10, 50, 0, 20};
+const bwColor red{1.0f, 0.0f, 0.0f};
+const bwColor green{0.0f, 1.0f, 0.0f};
+const bwColor blue{0.0f, 0.0f, 1.0f};
+
+void expect_colors_near(const bwColor& a, const bwColor& b, float tolerance = 1e-5f)
+{
+  for (int i = 0; i < 4; i++) {
+    EXPECT_NEAR(a.getColor()[i], b.getColor()[i], tolerance);
+  }
+}
+
+auto point_position(const bwGradient& gradient, const bwPoint& point) -> float
+{
+  float position;
+  gradient.calcPointPositions(&point, 1, box, &position);
+  return position;
+}
+
+}  // namespace
+
+TEST(bwGradient, shaded_two_stops)
+{
+  const bwColor base{0.5f};
+  const bwGradient top_bottom{base, 0.2f, -0.2f};
+  const bwGradient left_right{base, 0.2f, -0.2f, bwGradient::Direction::LEFT_RIGHT};
+
+  expect_colors_near(top_bottom.calcPointColor({30, 20}, box), bwColor(0.7f));
+  expect_colors_near(top_bottom.calcPointColor({30, 10}, box), bwColor(0.5f));
+  expect_colors_near(top_bottom.calcPointColor({30, 0}, box), bwColor(0.3f));
+
+  expect_colors_near(left_right.calcPointColor({10, 5}, box), bwColor(0.7f));
+  expect_colors_near(left_right.calcPointColor({50, 5}, box), bwColor(0.3f));
+  EXPECT_FALSE(left_right.isSingleColor());
+  EXPECT_TRUE(bwGradient(base, 0.1f, 0.1f).isSingleColor());
+}
+
+TEST(bwGradient, stops_sorted)
+{
+  bwGradient gradient{{1.0f, blue}, {0.0f, red}};
+  gradient.addStop(0.5f, green);
+
+  ASSERT_EQ(gradient.getStopCount(), 3);
+  EXPECT_EQ(gradient.getStop(0).position, 0.0f);
+  EXPECT_EQ(gradient.getStop(1).position, 0.5f);
+  EXPECT_EQ(gradient.getStop(2).position, 1.0f);
+}
+
+TEST(bwGradient, color_at)
+{
+  const bwGradient gradient{{0.2f, red}, {0.5f, green}, {0.8f, blue}};
+
+  /* Outside of the stops, the closest one. */
+  expect_colors_near(gradient.calcColorAt(0.0f), red);
+  expect_colors_near(gradient.calcColorAt(1.0f), blue);
+
+  expect_colors_near(gradient.calcColorAt(0.5f), green);
+  expect_colors_near(gradient.calcColorAt(0.35f), bwColor(0.5f, 0.5f, 0.0f));
+  expect_colors_near(gradient.calcColorAt(0.65f), bwColor(0.0f, 0.5f, 0.5f));
+}
+
+TEST(bwGradient, hard_stop)
+{
+  const bwGradient gradient{{0.5f, red}, {0.5f, blue}};
+
+  expect_colors_near(gradient.calcColorAt(0.49f), red);
+  expect_colors_near(gradient.calcColorAt(0.5f), blue);
+}
+
+TEST(bwGradient, linear_angles)
+{
+  const bwGradient up{{}, 0.0f};
+  const bwGradient right{{}, 90.0f};
+  const bwGradient down{{}, 180.0f};
+  const bwGradient diagonal{{}, 45.0f};
+
+  EXPECT_FLOAT_EQ(point_position(up, {30, 0}), 0.0f);
+  EXPECT_FLOAT_EQ(point_position(up, {30, 15}), 0.75f);
+  EXPECT_FLOAT_EQ(point_position(right, {20, 5}), 0.25f);
+  EXPECT_FLOAT_EQ(point_position(down, {30, 15}), 0.25f);
+
+  /* The corners are at the ends, whatever the angle. */
+  EXPECT_NEAR(point_position(diagonal, {10, 0}), 0.0f, 1e-6f);
+  EXPECT_NEAR(point_position(diagonal, {50, 20}), 1.0f, 1e-6f);
+  EXPECT_NEAR(point_position(diagonal, {30, 10}), 0.5f, 1e-6f);
+}
+
+TEST(bwGradient, radial)
+{
+  const bwGradient gradient = bwGradient::radial({{0.0f, red}, {1.0f, blue}});
+
+  EXPECT_EQ(gradient.getShape(), bwGradient::Shape::RADIAL);
+  EXPECT_FLOAT_EQ(point_position(gradient, {30, 10}), 0.0f);
+  EXPECT_NEAR(point_position(gradient, {10, 0}), 1.0f, 1e-6f);
+  EXPECT_NEAR(point_position(gradient, {50, 20}), 1.0f, 1e-6f);
+  /* Same distance along either axis, relative to the size of the box. */
+  EXPECT_FLOAT_EQ(point_position(gradient, {40, 10}), point_position(gradient, {30, 15}));
+}
+
+TEST(bwGradient, positions_clamped)
+{
+  const bwGradient gradient{{}, 180.0f};
+
+  EXPECT_EQ(point_position(gradient, {30, 25}), 0.0f);
+  EXPECT_EQ(point_position(gradient, {30, -5}), 1.0f);
+}
+
+TEST(bwGradient, lut)
+{
+  const bwGradient gradient{{0.1f, red}, {0.3f, green}, {0.7f, blue}, {0.9f, bwColor(1.0f)}};
+  const bwGradient::LUT& lut = gradient.getLUT();
+
+  for (std::size_t i = 0; i < lut.size(); i++) {
+    expect_colors_near(lut[i], gradient.calcColorAt(float(i) / (lut.size() - 1)));
+  }
+
+  /* Sampling it is close to the exact colors. */
+  std::vector<float> positions;
+  for (int i = 0; i <= 100; i++) {
+    positions.push_back(i / 100.0f);
+  }
+  std::vector<bwColor> colors(positions.size());
+  bwColorsSampleLUT(lut.data(), lut.size(), positions.data(), positions.size(), colors.data());
+  for (std::size_t i = 0; i < positions.size(); i++) {
+    expect_colors_near(colors[i], gradient.calcColorAt(positions[i]), 0.1f);
+  }
+}
@@ -0,0 +1,88 @@
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "bwInlineFunction.h"
+#include "bwSmallVector.h"
+
+using namespace bWidgets;
+
+TEST(bwSmallVector, inline_then_heap)
+{
+  bwSmallVector<std::string, 2> vec;
+
+  vec.push_back("a");
+  vec.emplace_back("b");
+  EXPECT_TRUE(vec.isInline());
+
+  vec.push_back("c");
+  EXPECT_FALSE(vec.isInline());
+  ASSERT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec[1], "b");
+  EXPECT_EQ(vec[2], "c");
+}
+
+TEST(bwSmallVector, copy_and_move)
+{
+  bwSmallVector<std::string, 2> inline_vec;
+  inline_vec.push_back("a");
+  bwSmallVector<std::string, 2> heap_vec;
+  for (const char* value : {"a", "b", "c"}) {
+    heap_vec.push_back(value);
+  }
+
+  bwSmallVector<std::string, 2> copy = heap_vec;
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_EQ(heap_vec.size(), 3);
+
+  bwSmallVector<std::string, 2> moved_inline = std::move(inline_vec);
+  ASSERT_EQ(moved_inline.size(), 1);
+  EXPECT_EQ(moved_inline[0], "a");
+  EXPECT_TRUE(inline_vec.empty());
+
+  moved_inline = std::move(heap_vec);
+  ASSERT_EQ(moved_inline.size(), 3);
+  EXPECT_EQ(moved_inline[2], "c");
+  EXPECT_TRUE(heap_vec.empty());
+  EXPECT_TRUE(heap_vec.isInline());
+}
+
+TEST(bwSmallVector, remove_unordered)
+{
+  bwSmallVector<std::unique_ptr<int>, 4> vec;
+  for (int i = 0; i < 3; i++) {
+    vec.push_back(std::make_unique<int>(i));
+  }
+
+  vec.removeUnordered(0);
+  ASSERT_EQ(vec.size(), 2);
+  EXPECT_EQ(*vec[0], 2);
+  EXPECT_EQ(*vec[1], 1);
+
+  vec.removeUnordered(1);
+  ASSERT_EQ(vec.size(), 1);
+  EXPECT_EQ(*vec[0], 2);
+}
+
+TEST(bwInlineFunction, call_copy_move)
+{
+  auto counter = std::make_shared<int>(0);
+  bwInlineFunction<int(int)> func = [counter](int value) { return (*counter += value); };
+
+  EXPECT_EQ(func(2), 2);
+
+  bwInlineFunction<int(int)> copy = func;
+  EXPECT_EQ(copy(3), 5);
+  EXPECT_EQ(counter.use_count(), 3);
+
+  bwInlineFunction<int(int)> moved = std::move(func);
+  EXPECT_FALSE(func);
+  EXPECT_EQ(moved(1), 6);
+  EXPECT_EQ(counter.use_count(), 3);
+
+  moved = bwInlineFunction<int(int)>();
+  copy = bwInlineFunction<int(int)>();
+  EXPECT_EQ(counter.use_count(), 1);
+}
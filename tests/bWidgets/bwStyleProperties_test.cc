@@ -136,8 +136,8 @@ TEST(bwStyleProperties, iterate)
   properties.addColor("test_color");
 
   for (const auto& property : properties) {
-    const bwStyleProperty::Type property_type = property->getType();
-    const std::string_view identifier = property->getIdentifier();
+    const bwStyleProperty::Type property_type = property.getType();
+    const std::string_view identifier = property.getIdentifier().str();
 
     switch (property_type) {
       case bwStyleProperty::Type::BOOL:
@@ -309,3 +309,37 @@ TEST(bwStyleProperty, setDefaultValue_color_reference)
   property.setValueToDefault();
   EXPECT_EQ(test_color, 0.3f);
 }
+TEST(bwStyleProperty, setDefaultValue_only_affects_property)
+{
+  bwStyleProperties properties_a;
+  bwStyleProperties properties_b;
+  int test_integer_a = 42;
+  int test_integer_b = 42;
+
+  /* Same identifier, type and default, so they share their descriptor. */
+  properties_a.addInteger("test_integer", test_integer_a).setDefaultValue(123);
+  properties_b.addInteger("test_integer", test_integer_b);
+
+  for (auto& property : properties_a) {
+    property.setValueToDefault();
+  }
+  for (auto& property : properties_b) {
+    property.setValueToDefault();
+  }
+  EXPECT_EQ(test_integer_a, 123);
+  EXPECT_EQ(test_integer_b, 0);
+}
+
+TEST(bwStyleProperty, setValue_float_from_integer)
+{
+  bwStyleProperties properties;
+  float test_float = 0.0f;
+  int test_integer = 42;
+
+  properties.addFloat("test_float", test_float);
+  properties.addInteger("test_integer", test_integer);
+
+  bwStyleProperty& property_float = *properties.begin();
+  property_float.setValue(*properties.lookup("test_integer"));
+  EXPECT_EQ(test_float, 42.0f);
+}
@@ -0,0 +1,229 @@
+#include <numeric>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "bwTaskPool.h"
+
+using namespace bWidgets;
+
+/** Counts the tasks passed through it, running them on the calling thread. */
+class CountingExecutor : public bwExecutor {
+ public:
+  int executed_count = 0;
+
+  void execute(Task task) override
+  {
+    executed_count++;
+    task();
+  }
+  auto getConcurrency() const -> unsigned int override
+  {
+    return 4;
+  }
+};
+
+TEST(bwTaskPoolTest, parallel_for_covers_range)
+{
+  bwTaskPool pool(4);
+  std::vector<int> visited(100000, 0);
+
+  bwParallelFor(
+      0,
+      visited.size(),
+      64,
+      [&visited](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          visited[i]++;
+        }
+      },
+      pool);
+
+  /* Each index exactly once, and the results are visible right after returning. */
+  for (int count : visited) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+TEST(bwTaskPoolTest, parallel_for_small_range)
+{
+  bwTaskPool pool(2);
+  int calls = 0;
+
+  /* Below the grain size, runs on the calling thread in one go. */
+  auto count_call = [&calls](size_t begin, size_t end) { calls += (begin == 5) && (end == 10); };
+  bwParallelFor(5, 10, 64, count_call, pool);
+  EXPECT_EQ(calls, 1);
+
+  /* Empty range. */
+  bwParallelFor(10, 10, 1, count_call, pool);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(bwTaskPoolTest, nested_groups)
+{
+  bwTaskPool pool(3);
+  std::vector<long> sums(64, 0);
+
+  bwTaskGroup outer(pool);
+  for (size_t i = 0; i < sums.size(); i++) {
+    outer.run([&pool, &sums, i]() {
+      std::vector<long> parts(16, 0);
+      bwTaskGroup inner(pool);
+      for (size_t j = 0; j < parts.size(); j++) {
+        inner.run([&parts, i, j]() { parts[j] = i * j; });
+      }
+      inner.wait();
+      sums[i] = std::accumulate(parts.begin(), parts.end(), 0L);
+    });
+  }
+  outer.wait();
+
+  for (size_t i = 0; i < sums.size(); i++) {
+    EXPECT_EQ(sums[i], long(i) * 120);
+  }
+}
+
+TEST(bwTaskPoolTest, exception_reaches_waiting_thread)
+{
+  bwTaskPool pool(2);
+  std::atomic<int> finished{0};
+
+  bwTaskGroup group(pool);
+  for (int i = 0; i < 32; i++) {
+    group.run([&finished, i]() {
+      if (i == 7) {
+        throw std::runtime_error("task failed");
+      }
+      finished++;
+    });
+  }
+  EXPECT_THROW(group.wait(), std::runtime_error);
+  /* The other tasks still ran. */
+  EXPECT_EQ(finished, 31);
+
+  /* Rethrown only once. */
+  EXPECT_NO_THROW(group.wait());
+}
+
+TEST(bwTaskPoolTest, without_worker_threads)
+{
+  /* Tasks only run while waiting for them, so everything runs on this thread. */
+  bwTaskPool pool(0);
+  const std::thread::id this_thread = std::this_thread::get_id();
+  int on_this_thread = 0;
+
+  bwTaskGroup group(pool);
+  for (int i = 0; i < 10; i++) {
+    group.run([&]() { on_this_thread += (std::this_thread::get_id() == this_thread); });
+  }
+  group.wait();
+  EXPECT_EQ(on_this_thread, 10);
+}
+
+TEST(bwTaskPoolTest, application_executor)
+{
+  CountingExecutor executor;
+  bwExecutor::setGlobal(&executor);
+
+  std::vector<int> values(1000, 0);
+  bwParallelFor(0, values.size(), 10, [&values](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      values[i] = i;
+    }
+  });
+  bwExecutor::setGlobal(nullptr);
+
+  /* 16 chunks (4 per thread), one runs on the calling thread. */
+  EXPECT_EQ(executor.executed_count, 15);
+  EXPECT_EQ(values[999], 999);
+  EXPECT_NE(&bwExecutor::getGlobal(), &executor);
+}
+
+TEST(bwTaskPoolTest, destruction_runs_queued_tasks)
+{
+  std::atomic<int> executed{0};
+  {
+    bwTaskPool pool(2);
+    for (int i = 0; i < 1000; i++) {
+      pool.execute([&executed]() { executed++; });
+    }
+  }
+  EXPECT_EQ(executed, 1000);
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Stress Tests
+ * \{ */
+
+TEST(bwTaskPoolStressTest, many_tiny_tasks)
+{
+  bwTaskPool pool(4);
+
+  for (int round = 0; round < 20; round++) {
+    std::atomic<long> sum{0};
+    bwTaskGroup group(pool);
+    for (int i = 0; i < 5000; i++) {
+      group.run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); });
+    }
+    group.wait();
+    ASSERT_EQ(sum, 5000L * 4999 / 2);
+  }
+}
+
+TEST(bwTaskPoolStressTest, concurrent_submitters)
+{
+  bwTaskPool pool(4);
+  std::vector<std::thread> submitters;
+  std::vector<long> results(8, 0);
+
+  /* Several threads share the pool, each waiting for its own groups only. */
+  for (size_t t = 0; t < results.size(); t++) {
+    submitters.emplace_back([&pool, &results, t]() {
+      for (int round = 0; round < 50; round++) {
+        std::vector<long> values(256, 0);
+        bwParallelFor(
+            0,
+            values.size(),
+            4,
+            [&values, t](size_t begin, size_t end) {
+              for (size_t i = begin; i < end; i++) {
+                values[i] = i + t;
+              }
+            },
+            pool);
+        results[t] += std::accumulate(values.begin(), values.end(), 0L);
+      }
+    });
+  }
+  for (std::thread& submitter : submitters) {
+    submitter.join();
+  }
+
+  for (size_t t = 0; t < results.size(); t++) {
+    EXPECT_EQ(results[t], 50 * (256L * 255 / 2 + 256L * t));
+  }
+}
+
+TEST(bwTaskPoolStressTest, deep_nesting)
+{
+  bwTaskPool pool(2);
+  std::atomic<int> leaves{0};
+
+  /* Recursive splitting, with more waiting tasks than worker threads. */
+  std::function<void(int)> split = [&](int depth) {
+    if (depth == 0) {
+      leaves++;
+      return;
+    }
+    bwTaskGroup group(pool);
+    group.run([&split, depth]() { split(depth - 1); });
+    group.run([&split, depth]() { split(depth - 1); });
+    group.wait();
+  };
+  split(10);
+
+  EXPECT_EQ(leaves, 1024);
+}
+
+/** \} */
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include "builtin_widgets.h"
+#include "bwStyleManager.h"
+#include "bwWidgetBaseStyleTable.h"
+#include "screen_graph/Node.h"
+
+using namespace bWidgets;
+
+namespace {
+
+int build_count = 0;
+
+void build_button_base_style(const bwWidget::State state, bwWidgetBaseStyle& r_base_style)
+{
+  build_count++;
+  r_base_style.corner_radius = 3.0f;
+  r_base_style.shade_top = (state == bwWidget::State::SUNKEN) ? -10 : 10;
+}
+
+void build_container_base_style(bwWidget::State, bwWidgetBaseStyle& r_base_style)
+{
+  build_count++;
+  r_base_style.background_color = 114u;
+}
+
+auto build_funcs() -> const bwWidgetTypeMap<bwWidgetBaseStyleTable::BuildFunc>&
+{
+  static const bwWidgetTypeMap<bwWidgetBaseStyleTable::BuildFunc> funcs = []() {
+    bwWidgetTypeMap<bwWidgetBaseStyleTable::BuildFunc> funcs;
+    funcs.add<bwAbstractButton>(build_button_base_style);
+    funcs.add<bwContainerWidget>(build_container_base_style);
+    return funcs;
+  }();
+  return funcs;
+}
+
+}  // namespace
+
+TEST(bwWidgetBaseStyleTable, block_per_type_and_state)
+{
+  bwWidgetBaseStyleTable table(build_funcs());
+  bwPushButton button_a("A");
+  bwPushButton button_b("B");
+  bwCheckbox checkbox;
+
+  build_count = 0;
+  const bwWidgetBaseStyleTable::Block* block = table.lookup(button_a, 1.0f);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(block->base_style.corner_radius, 3.0f);
+  EXPECT_EQ(block->base_style.shade_top, 10);
+  EXPECT_FALSE(block->has_other_properties);
+
+  /* Same type and state, reused. */
+  EXPECT_EQ(table.lookup(button_b, 1.0f), block);
+  EXPECT_EQ(build_count, 1);
+
+  /* Build function inherited, but own block. */
+  EXPECT_NE(table.lookup(checkbox, 1.0f), block);
+
+  button_b.setState(bwWidget::State::SUNKEN);
+  const bwWidgetBaseStyleTable::Block* sunken_block = table.lookup(button_b, 1.0f);
+  ASSERT_NE(sunken_block, nullptr);
+  EXPECT_NE(sunken_block, block);
+  EXPECT_EQ(sunken_block->base_style.shade_top, -10);
+  EXPECT_EQ(build_count, 3);
+}
+
+TEST(bwWidgetBaseStyleTable, no_build_func)
+{
+  bwWidgetBaseStyleTable table(build_funcs());
+  bwLabel label("Label");
+
+  EXPECT_EQ(table.lookup(label, 1.0f), nullptr);
+}
+
+TEST(bwWidgetBaseStyleTable, other_properties)
+{
+  bwWidgetBaseStyleTable table(build_funcs());
+  bwScreenGraph::ContainerNode node;
+  bwPanel panel(node, "Panel");
+  bwScrollView scroll_view(node);
+
+  /* bwPanel adds "draw-separator". */
+  ASSERT_NE(table.lookup(panel, 1.0f), nullptr);
+  EXPECT_TRUE(table.lookup(panel, 1.0f)->has_other_properties);
+  ASSERT_NE(table.lookup(scroll_view, 1.0f), nullptr);
+  EXPECT_FALSE(table.lookup(scroll_view, 1.0f)->has_other_properties);
+}
+
+TEST(bwWidgetBaseStyleTable, rebuild)
+{
+  bwWidgetBaseStyleTable table(build_funcs());
+  bwPushButton button("Button");
+
+  table.lookup(button, 1.0f);
+  build_count = 0;
+
+  table.lookup(button, 1.0f);
+  EXPECT_EQ(build_count, 0);
+
+  table.lookup(button, 2.0f);
+  EXPECT_EQ(build_count, 1);
+
+  bwStyleManager::getStyleManager().bumpStyleGeneration();
+  table.lookup(button, 2.0f);
+  EXPECT_EQ(build_count, 2);
+}
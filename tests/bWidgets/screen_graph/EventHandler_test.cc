@@ -0,0 +1,141 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwContainerWidget.h"
+#include "bwEvent.h"
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/EventHandler.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+/** Records calls of its onFoo() handlers. */
+class RecordingHandler : public EventHandler {
+ public:
+  RecordingHandler(std::vector<std::string>& log, std::string name) : log(log), name(name)
+  {
+  }
+
+  void onMousePress(bwMouseButtonEvent&) override
+  {
+    log.push_back(name + " onMousePress");
+  }
+
+  std::vector<std::string>& log;
+  std::string name;
+};
+
+class RecordingContainer : public bwContainerWidget {
+ public:
+  RecordingContainer(const ContainerNode& node, std::vector<std::string>& log, std::string name)
+      : bwContainerWidget(node), log(log), name(name)
+  {
+    rectangle = {0, 100, 0, 100};
+  }
+
+  auto getTypeIdentifier() const -> bwAtom override
+  {
+    static const bwAtom identifier("RecordingContainer");
+    return identifier;
+  }
+  void draw(bwStyle&) override
+  {
+  }
+  auto createHandler() -> std::unique_ptr<EventHandler> override
+  {
+    return std::make_unique<RecordingHandler>(log, name);
+  }
+
+  std::vector<std::string>& log;
+  std::string name;
+};
+
+class EventHandlerTest : public ::testing::Test {
+ protected:
+  std::vector<std::string> log;
+  ScreenGraph screen_graph;
+  ContainerNode* outer_node;
+  ContainerNode* inner_node;
+
+  EventHandlerTest() : screen_graph(std::make_unique<LayoutNode>())
+  {
+    Builder::setLayout(screen_graph.Root(),
+                       std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}));
+    Builder builder(screen_graph.Root());
+
+    outer_node = &builder.addContainer<RecordingContainer>(
+        std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}), log, "outer");
+    inner_node = &builder.addContainer<RecordingContainer>(
+        std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}), log, "inner");
+  }
+
+  auto listenerLogging(const char* message) -> EventListener
+  {
+    return [this, message](Node&, bwEvent&) { log.push_back(message); };
+  }
+
+  void press()
+  {
+    bwMouseButtonEvent event(bwMouseButtonEvent::Button::LEFT, {50, 50});
+    screen_graph.event_dispatcher.dispatchMouseButtonPress(event);
+  }
+};
+
+TEST_F(EventHandlerTest, listeners_bubble_with_handlers)
+{
+  outer_node->eventHandler()->addEventListener(EventHandler::MOUSE_PRESS,
+                                               listenerLogging("outer listener"));
+  inner_node->eventHandler()->addEventListener(EventHandler::MOUSE_PRESS,
+                                               listenerLogging("inner listener"));
+  /* Other event type, not expected to be called. */
+  inner_node->eventHandler()->addEventListener(EventHandler::MOUSE_RELEASE,
+                                               listenerLogging("inner release listener"));
+
+  press();
+
+  const std::vector<std::string> expected{
+      "inner onMousePress", "inner listener", "outer onMousePress", "outer listener"};
+  EXPECT_EQ(log, expected);
+}
+
+TEST_F(EventHandlerTest, listener_swallows)
+{
+  inner_node->eventHandler()->addEventListener(
+      EventHandler::MOUSE_PRESS, [this](Node& node, bwEvent& event) {
+        EXPECT_EQ(&node, inner_node);
+        log.push_back("inner listener");
+        event.swallow();
+      });
+  inner_node->eventHandler()->addEventListener(EventHandler::MOUSE_PRESS,
+                                               listenerLogging("second inner listener"));
+
+  press();
+
+  const std::vector<std::string> expected{"inner onMousePress", "inner listener"};
+  EXPECT_EQ(log, expected);
+}
+
+TEST_F(EventHandlerTest, custom_event_type)
+{
+  static const EventHandler::EventType custom_type = EventHandler::registerEventType();
+  const EventHandler::EventType other_custom_type = EventHandler::registerEventType();
+
+  EXPECT_GE(custom_type, EventHandler::TOT_BUILTIN_EVENT_TYPES);
+  EXPECT_NE(custom_type, other_custom_type);
+
+  outer_node->eventHandler()->addEventListener(custom_type, listenerLogging("outer custom"));
+  inner_node->eventHandler()->addEventListener(other_custom_type, listenerLogging("inner other"));
+
+  bwEvent event({50, 50});
+  screen_graph.event_dispatcher.emitEvent(custom_type, *inner_node, event);
+
+  /* No onFoo() handlers are called for custom events. */
+  const std::vector<std::string> expected{"outer custom"};
+  EXPECT_EQ(log, expected);
+}
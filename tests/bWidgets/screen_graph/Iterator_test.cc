@@ -1,7 +1,7 @@
 
 #include "gtest/gtest.h"
 
-#include "bwLayoutInterface.h"
+#include "TestUtilClasses.h"
 
 #define private public  // XXX Oh the evilness!
 #include "screen_graph/Iterators.h"
@@ -9,18 +9,7 @@
 #include "screen_graph/Builder.h"
 
 using namespace bWidgets;
-
-class DummyNodeLayout : public bwLayoutInterface {
- public:
-  DummyNodeLayout(std::string label) : label(label)
-  {
-  }
-  bwRectanglePixel getRectangle() override
-  {
-    return {};
-  }
-  std::string label;
-};
+using TestUtilClasses::DummyLayout;
 
 class IteratorTest : public ::testing::Test {
  protected:
@@ -43,7 +32,7 @@ class IteratorTest : public ::testing::Test {
 
   IteratorTest()
   {
-    screen_graph.layout = std::make_unique<DummyNodeLayout>(labels[0]);
+    screen_graph.layout = std::make_unique<DummyLayout>(labels[0]);
   }
 
  public:
@@ -63,7 +52,7 @@ class IteratorTest : public ::testing::Test {
     assert(labels.size() >= expected_count);
     for (bwScreenGraph::Node& node : root_node) {
       assert(node.Layout());
-      EXPECT_EQ(static_cast<const DummyNodeLayout&>(*node.Layout()).label, labels[counter]);
+      EXPECT_EQ(static_cast<const DummyLayout&>(*node.Layout()).label, labels[counter]);
       counter++;
     }
     EXPECT_EQ(counter, expected_count);
@@ -81,7 +70,7 @@ class IteratorTest : public ::testing::Test {
 static bwScreenGraph::LayoutNode& addChildNode(bwScreenGraph::LayoutNode& node, std::string label)
 {
   bwScreenGraph::Builder builder(node);
-  return builder.addLayout<DummyNodeLayout>(label);
+  return builder.addLayout<DummyLayout>(label);
 }
 
 TEST_F(IteratorTest, no_children)
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwEvent.h"
+#include "bwLabel.h"
+#include "bwPanel.h"
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/Mutator.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+/** Builder type with some state, to check if a copy of it is used for building lazily. */
+class PrefixBuilder : public Builder {
+ public:
+  PrefixBuilder(LayoutNode& node, std::string prefix) : Builder(node), prefix(prefix)
+  {
+  }
+
+  std::string prefix;
+};
+
+class LazyBuildTest : public ::testing::Test {
+ protected:
+  ScreenGraph screen_graph;
+  Mutator mutator;
+  unsigned int build_count{0};
+
+  LazyBuildTest() : screen_graph(std::make_unique<LayoutNode>()), mutator(screen_graph)
+  {
+    Builder::setLayout(screen_graph.Root(), std::make_unique<DummyLayout>());
+  }
+
+  auto buildPanel(LayoutNode& parent, bwPanel::State state) -> ContainerNode&
+  {
+    PrefixBuilder builder(parent, "Label ");
+
+    return builder.buildContainerLazy<bwPanel, PrefixBuilder>(
+        [this](PrefixBuilder& builder) {
+          builder.addWidget<bwLabel>(builder.prefix + "A");
+          builder.addWidget<bwLabel>(builder.prefix + "B");
+          build_count++;
+        },
+        std::make_unique<DummyLayout>(),
+        "Panel",
+        20,
+        state);
+  }
+
+  static auto panelOf(ContainerNode& node) -> bwPanel&
+  {
+    return static_cast<bwPanel&>(*node.Widget());
+  }
+
+  static void openPanelByClick(ContainerNode& node)
+  {
+    bwPanel& panel = panelOf(node);
+    panel.rectangle = bwRectanglePixel{0, 100, 0, 100};
+
+    bwMouseButtonEvent event{bwMouseButtonEvent::Button::LEFT, {50, 90}};
+    node.eventHandler()->onMousePress(event);
+  }
+};
+
+TEST_F(LazyBuildTest, open_panel_builds_immediately)
+{
+  ContainerNode& node = buildPanel(screen_graph.Root(), bwPanel::State::OPEN);
+
+  EXPECT_EQ(build_count, 1);
+  ASSERT_EQ(node.Children()->size(), 2);
+  EXPECT_EQ(*node.Children()->front()->Widget()->getLabel(), "Label A");
+}
+
+TEST_F(LazyBuildTest, closed_panel_defers_build)
+{
+  ContainerNode& node = buildPanel(screen_graph.Root(), bwPanel::State::CLOSED);
+
+  EXPECT_EQ(build_count, 0);
+  EXPECT_TRUE(node.Children()->empty());
+
+  /* Can't build while the panel is closed. */
+  EXPECT_FALSE(Builder::buildLazyChildren(node));
+  EXPECT_EQ(build_count, 0);
+}
+
+TEST_F(LazyBuildTest, opening_builds)
+{
+  ContainerNode& node = buildPanel(screen_graph.Root(), bwPanel::State::CLOSED);
+
+  openPanelByClick(node);
+
+  EXPECT_EQ(panelOf(node).panel_state, bwPanel::State::OPEN);
+  EXPECT_EQ(build_count, 1);
+  ASSERT_EQ(node.Children()->size(), 2);
+  /* The builder state was kept. */
+  EXPECT_EQ(*node.Children()->back()->Widget()->getLabel(), "Label B");
+  EXPECT_EQ(node.Children()->back()->Parent(), &node);
+
+  /* Only built once. */
+  EXPECT_FALSE(Builder::buildLazyChildren(node));
+  EXPECT_EQ(build_count, 1);
+}
+
+TEST_F(LazyBuildTest, free_lazy_children)
+{
+  ContainerNode& node = buildPanel(screen_graph.Root(), bwPanel::State::OPEN);
+
+  /* Can't free visible children. */
+  EXPECT_FALSE(mutator.freeLazyChildren(node));
+  EXPECT_EQ(node.Children()->size(), 2);
+
+  panelOf(node).panel_state = bwPanel::State::CLOSED;
+  EXPECT_TRUE(mutator.freeLazyChildren(node));
+  EXPECT_TRUE(node.Children()->empty());
+
+  /* Freed children are built again when opening. */
+  openPanelByClick(node);
+  EXPECT_EQ(build_count, 2);
+  EXPECT_EQ(node.Children()->size(), 2);
+}
+
+TEST_F(LazyBuildTest, free_lazy_children_non_lazy)
+{
+  Builder builder(screen_graph.Root());
+  ContainerNode& node = builder.buildContainer<bwPanel>(
+      [](Builder& builder) { builder.addWidget<bwLabel>("A"); },
+      std::make_unique<DummyLayout>(),
+      "Panel",
+      20);
+  panelOf(node).panel_state = bwPanel::State::CLOSED;
+
+  /* The children couldn't be built again, so they must not be freed. */
+  EXPECT_FALSE(mutator.freeLazyChildren(node));
+  EXPECT_EQ(node.Children()->size(), 1);
+}
+
+TEST_F(LazyBuildTest, free_hidden_lazy_children)
+{
+  ContainerNode& open_node = buildPanel(screen_graph.Root(), bwPanel::State::OPEN);
+  ContainerNode& nested_node = buildPanel(open_node, bwPanel::State::OPEN);
+  ContainerNode& closed_node = buildPanel(screen_graph.Root(), bwPanel::State::OPEN);
+
+  panelOf(nested_node).panel_state = bwPanel::State::CLOSED;
+  panelOf(closed_node).panel_state = bwPanel::State::CLOSED;
+
+  EXPECT_EQ(mutator.freeHiddenLazyChildren(screen_graph.Root()), 2);
+  EXPECT_EQ(open_node.Children()->size(), 3);
+  EXPECT_TRUE(nested_node.Children()->empty());
+  EXPECT_TRUE(closed_node.Children()->empty());
+}
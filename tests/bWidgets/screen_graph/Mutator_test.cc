@@ -0,0 +1,258 @@
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwLabel.h"
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/Iterators.h"
+#include "screen_graph/Mutator.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+class MutatorTest : public ::testing::Test {
+ protected:
+  ScreenGraph screen_graph;
+  Mutator mutator;
+
+  MutatorTest() : screen_graph(std::make_unique<LayoutNode>()), mutator(screen_graph)
+  {
+    Builder::setLayout(screen_graph.Root(), std::make_unique<DummyLayout>("root"));
+  }
+
+  auto addChildNode(LayoutNode& parent, std::string label, bwRectanglePixel rect = {})
+      -> LayoutNode&
+  {
+    Builder builder(parent);
+    return builder.addLayout<DummyLayout>(label, rect);
+  }
+
+  static auto makeNode(std::string label, bwRectanglePixel rect = {}) -> std::unique_ptr<Node>
+  {
+    auto node = std::make_unique<LayoutNode>();
+    Builder::setLayout(*node, std::make_unique<DummyLayout>(label, rect));
+    return node;
+  }
+
+  static auto labelOf(const Node& node) -> std::string
+  {
+    return static_cast<const DummyLayout&>(*node.Layout()).label;
+  }
+
+  static auto childLabels(const Node& node) -> std::string
+  {
+    std::string result;
+    for (const auto& child : *node.Children()) {
+      result += labelOf(*child);
+    }
+    return result;
+  }
+
+  static void clearDirtyRecursive(Node& node)
+  {
+    for (Node& iter_node : node) {
+      if (bwLayoutInterface* layout = iter_node.Layout()) {
+        layout->clearDirty();
+      }
+    }
+  }
+};
+
+TEST_F(MutatorTest, insert)
+{
+  LayoutNode& root = screen_graph.Root();
+  Node& node_b = addChildNode(root, "b");
+
+  mutator.insert(root, &node_b, makeNode("a"));
+  mutator.insert(root, nullptr, makeNode("d"));
+  Node& node_c = mutator.append(root, makeNode("c"));
+  mutator.insert(root, &node_c, makeNode("x"));
+
+  EXPECT_EQ(childLabels(root), "abdxc");
+  EXPECT_EQ(node_c.Parent(), &root);
+}
+
+TEST_F(MutatorTest, remove)
+{
+  LayoutNode& root = screen_graph.Root();
+  addChildNode(root, "a");
+  Node& node_b = addChildNode(root, "b");
+  addChildNode(root, "c");
+
+  std::unique_ptr<Node> removed = mutator.remove(node_b);
+
+  EXPECT_EQ(childLabels(root), "ac");
+  EXPECT_EQ(removed.get(), &node_b);
+  EXPECT_EQ(removed->Parent(), nullptr);
+
+  /* Re-insert the removed node, iterators must have been updated correctly. */
+  mutator.append(root, std::move(removed));
+  EXPECT_EQ(childLabels(root), "acb");
+  mutator.remove(node_b);
+  EXPECT_EQ(childLabels(root), "ac");
+}
+
+TEST_F(MutatorTest, move)
+{
+  LayoutNode& root = screen_graph.Root();
+  LayoutNode& node_a = addChildNode(root, "a");
+  LayoutNode& node_b = addChildNode(root, "b");
+  Node& node_c = addChildNode(node_a, "c");
+  Node& node_d = addChildNode(node_a, "d");
+
+  mutator.move(node_d, node_a, &node_c);
+  EXPECT_EQ(childLabels(node_a), "dc");
+
+  mutator.move(node_c, node_b);
+  EXPECT_EQ(childLabels(node_a), "d");
+  EXPECT_EQ(childLabels(node_b), "c");
+  EXPECT_EQ(node_c.Parent(), &node_b);
+
+  /* Moving back to the old position should work too. */
+  mutator.move(node_c, node_a, &node_d);
+  EXPECT_EQ(childLabels(node_a), "cd");
+  EXPECT_EQ(childLabels(node_b), "");
+}
+
+TEST_F(MutatorTest, replace)
+{
+  LayoutNode& root = screen_graph.Root();
+  addChildNode(root, "a");
+  Node& node_b = addChildNode(root, "b");
+  addChildNode(root, "c");
+
+  std::unique_ptr<Node> replaced = mutator.replace(node_b, makeNode("x"));
+
+  EXPECT_EQ(childLabels(root), "axc");
+  EXPECT_EQ(replaced.get(), &node_b);
+  EXPECT_EQ(replaced->Parent(), nullptr);
+  EXPECT_EQ(root.Children()->back()->Parent(), &root);
+
+  /* The replacing node must be fully linked, so it can be removed again. */
+  Node& node_x = **std::next(root.Children()->begin());
+  mutator.remove(node_x);
+  EXPECT_EQ(childLabels(root), "ac");
+}
+
+TEST_F(MutatorTest, invalidates_ancestors_only)
+{
+  LayoutNode& root = screen_graph.Root();
+  LayoutNode& node_a = addChildNode(root, "a");
+  LayoutNode& node_b = addChildNode(node_a, "b");
+  LayoutNode& sibling = addChildNode(root, "sibling");
+  LayoutNode& sibling_child = addChildNode(sibling, "sibling_child");
+
+  clearDirtyRecursive(root);
+
+  mutator.append(node_b, makeNode("c"));
+
+  EXPECT_TRUE(node_b.Layout()->isDirty());
+  EXPECT_TRUE(node_a.Layout()->isDirty());
+  EXPECT_TRUE(root.Layout()->isDirty());
+  EXPECT_FALSE(sibling.Layout()->isDirty());
+  EXPECT_FALSE(sibling_child.Layout()->isDirty());
+}
+
+TEST_F(MutatorTest, widget_changes_invalidate)
+{
+  LayoutNode& root = screen_graph.Root();
+  LayoutNode& node_a = addChildNode(root, "a");
+  LayoutNode& sibling = addChildNode(root, "sibling");
+  bwWidget& label = Builder::emplaceWidget<bwLabel>(node_a, "Label");
+
+  clearDirtyRecursive(root);
+
+  /* No actual change, shouldn't invalidate. */
+  label.hide(false);
+  label.setWidthHint(label.width_hint);
+  EXPECT_FALSE(root.Layout()->isDirty());
+
+  label.hide();
+  EXPECT_TRUE(node_a.Layout()->isDirty());
+  EXPECT_TRUE(root.Layout()->isDirty());
+  EXPECT_FALSE(sibling.Layout()->isDirty());
+
+  clearDirtyRecursive(root);
+  label.setHeightHint(label.height_hint + 1);
+  EXPECT_TRUE(node_a.Layout()->isDirty());
+  EXPECT_TRUE(root.Layout()->isDirty());
+}
+
+TEST_F(MutatorTest, removal_resets_context)
+{
+  LayoutNode& root = screen_graph.Root();
+  LayoutNode& node_a = addChildNode(root, "a");
+  Node& node_b = addChildNode(node_a, "b");
+  Node& node_c = addChildNode(root, "c");
+
+  screen_graph.context.hovered = &node_b;
+  screen_graph.context.active = &node_b;
+  mutator.remove(node_a);
+  EXPECT_EQ(screen_graph.context.hovered, &root);
+  EXPECT_EQ(screen_graph.context.active, nullptr);
+
+  /* Removing unrelated nodes should keep the context. */
+  screen_graph.context.hovered = &root;
+  screen_graph.context.active = &root;
+  mutator.remove(node_c);
+  EXPECT_EQ(screen_graph.context.hovered, &root);
+  EXPECT_EQ(screen_graph.context.active, &root);
+}
+
+TEST_F(MutatorTest, damage)
+{
+  LayoutNode& root = screen_graph.Root();
+  LayoutNode& node_a = addChildNode(root, "a", {0, 100, 0, 100});
+  Node& node_b = addChildNode(node_a, "b", {10, 20, 10, 20});
+  addChildNode(root, "c", {0, 100, 200, 300});
+
+  EXPECT_TRUE(screen_graph.damage.isEmpty());
+
+  mutator.remove(node_b);
+  EXPECT_FALSE(screen_graph.damage.isEmpty());
+  /* The removed node is inside its parent, so the parent rectangle is enough. */
+  ASSERT_EQ(screen_graph.damage.getRectangles().size(), 1);
+  const bwRectanglePixel bounds = screen_graph.damage.getBounds();
+  EXPECT_EQ(bounds.xmin, 0);
+  EXPECT_EQ(bounds.xmax, 100);
+  EXPECT_EQ(bounds.ymin, 0);
+  EXPECT_EQ(bounds.ymax, 100);
+
+  screen_graph.damage.clear();
+  EXPECT_TRUE(screen_graph.damage.isEmpty());
+}
+
+TEST_F(MutatorTest, redraw_requests)
+{
+  LayoutNode& root = screen_graph.Root();
+  LayoutNode& node_a = addChildNode(root, "a", {0, 100, 0, 100});
+  bwWidget& label = Builder::emplaceWidget<bwLabel>(node_a, "Label");
+  label.rectangle = {10, 20, 10, 20};
+
+  clearDirtyRecursive(root);
+  EXPECT_FALSE(screen_graph.needsRedraw());
+
+  /* No actual change, shouldn't request a redraw. */
+  label.setState(label.getState());
+  EXPECT_FALSE(screen_graph.needsRedraw());
+
+  label.setState(bwWidget::State::HIGHLIGHTED);
+  EXPECT_TRUE(screen_graph.needsRedraw());
+  /* Only the widget itself needs to be redrawn. */
+  const bwRectanglePixel bounds = screen_graph.damage.getBounds();
+  EXPECT_EQ(bounds.xmin, 10);
+  EXPECT_EQ(bounds.xmax, 20);
+  EXPECT_EQ(bounds.ymin, 10);
+  EXPECT_EQ(bounds.ymax, 20);
+
+  screen_graph.damage.clear();
+  label.hide();
+  EXPECT_TRUE(screen_graph.needsRedraw());
+
+  /* Widgets outside of a screen-graph can't request redraws, but shouldn't fail either. */
+  LayoutNode detached_node;
+  Builder::emplaceWidget<bwLabel>(detached_node, "Label").setState(bwWidget::State::SUNKEN);
+}
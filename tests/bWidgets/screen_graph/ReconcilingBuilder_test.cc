@@ -0,0 +1,204 @@
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwLabel.h"
+#include "bwPanel.h"
+#include "bwPushButton.h"
+
+#include "screen_graph/ReconcilingBuilder.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+class OtherDummyLayout : public DummyLayout {
+};
+
+class ReconcilingBuilderTest : public ::testing::Test {
+ protected:
+  ScreenGraph screen_graph;
+
+  ReconcilingBuilderTest() : screen_graph(std::make_unique<LayoutNode>())
+  {
+    Builder::setLayout(screen_graph.Root(), std::make_unique<DummyLayout>());
+  }
+
+  /** Build a label for each item in \a labels, keyed by the label. */
+  auto buildLabels(const std::vector<std::string>& labels) -> ReconcilingBuilder::Statistics
+  {
+    ReconcilingBuilder builder(screen_graph);
+    for (const std::string& label : labels) {
+      builder.addWidget<bwLabel>(label, label);
+    }
+    builder.finish();
+    return builder.getStatistics();
+  }
+
+  auto childLabels() -> std::string
+  {
+    std::string result;
+    for (const auto& child : *screen_graph.Root().Children()) {
+      result += *child->Widget()->getLabel();
+    }
+    return result;
+  }
+
+  auto childAt(int index) -> Node*
+  {
+    return std::next(screen_graph.Root().Children()->begin(), index)->get();
+  }
+};
+
+TEST_F(ReconcilingBuilderTest, initial_build)
+{
+  const ReconcilingBuilder::Statistics stats = buildLabels({"a", "b", "c"});
+
+  EXPECT_EQ(childLabels(), "abc");
+  EXPECT_EQ(stats.created, 3);
+  EXPECT_EQ(stats.reused, 0);
+  EXPECT_EQ(stats.destroyed, 0);
+}
+
+TEST_F(ReconcilingBuilderTest, unchanged_rebuild)
+{
+  buildLabels({"a", "b", "c"});
+  Node* node_b = childAt(1);
+  screen_graph.Root().Layout()->clearDirty();
+
+  const ReconcilingBuilder::Statistics stats = buildLabels({"a", "b", "c"});
+
+  EXPECT_EQ(childLabels(), "abc");
+  EXPECT_EQ(childAt(1), node_b);
+  EXPECT_EQ(stats.created, 0);
+  EXPECT_EQ(stats.reused, 3);
+  EXPECT_EQ(stats.destroyed, 0);
+  /* Nothing changed, so the layout can be reused. */
+  EXPECT_FALSE(screen_graph.Root().Layout()->isDirty());
+}
+
+TEST_F(ReconcilingBuilderTest, reorder)
+{
+  buildLabels({"a", "b", "c", "d"});
+  Node* node_a = childAt(0);
+  Node* node_d = childAt(3);
+
+  const ReconcilingBuilder::Statistics stats = buildLabels({"d", "b", "c", "a"});
+
+  EXPECT_EQ(childLabels(), "dbca");
+  EXPECT_EQ(childAt(0), node_d);
+  EXPECT_EQ(childAt(3), node_a);
+  EXPECT_EQ(stats.created, 0);
+  EXPECT_EQ(stats.reused, 4);
+  EXPECT_EQ(stats.destroyed, 0);
+}
+
+TEST_F(ReconcilingBuilderTest, insert_and_remove)
+{
+  buildLabels({"a", "b", "c"});
+  Node* node_c = childAt(2);
+
+  const ReconcilingBuilder::Statistics stats = buildLabels({"x", "c", "y"});
+
+  EXPECT_EQ(childLabels(), "xcy");
+  EXPECT_EQ(childAt(1), node_c);
+  EXPECT_EQ(stats.created, 2);
+  EXPECT_EQ(stats.reused, 1);
+  EXPECT_EQ(stats.destroyed, 2);
+}
+
+TEST_F(ReconcilingBuilderTest, type_change)
+{
+  buildLabels({"a"});
+
+  ReconcilingBuilder builder(screen_graph);
+  builder.addWidget<bwPushButton>("a", "a");
+  builder.finish();
+
+  EXPECT_EQ(screen_graph.Root().Children()->size(), 1);
+  EXPECT_NE(dynamic_cast<bwPushButton*>(childAt(0)->Widget()), nullptr);
+  EXPECT_EQ(builder.getStatistics().created, 1);
+  EXPECT_EQ(builder.getStatistics().destroyed, 1);
+}
+
+TEST_F(ReconcilingBuilderTest, keeps_widget_state)
+{
+  {
+    ReconcilingBuilder builder(screen_graph);
+    builder.addWidget<bwLabel>("a", "Initial").setLabel("Changed");
+  }
+  {
+    ReconcilingBuilder builder(screen_graph);
+    bwLabel& label = builder.addWidget<bwLabel>("a", "Initial");
+    EXPECT_EQ(*label.getLabel(), "Changed");
+  }
+}
+
+TEST_F(ReconcilingBuilderTest, nested_layouts)
+{
+  auto build = [this](bool with_inner_label, bool use_other_layout) {
+    ReconcilingBuilder builder(screen_graph);
+    auto build_func = [with_inner_label](ReconcilingBuilder& builder) {
+      builder.addWidget<bwLabel>("a", "a");
+      if (with_inner_label) {
+        builder.addWidget<bwLabel>("b", "b");
+      }
+    };
+    if (use_other_layout) {
+      builder.buildLayout<OtherDummyLayout>(build_func, "layout");
+    }
+    else {
+      builder.buildLayout<DummyLayout>(build_func, "layout");
+    }
+    builder.addWidget<bwLabel>("c", "c");
+    builder.finish();
+    return builder.getStatistics();
+  };
+
+  ReconcilingBuilder::Statistics stats = build(true, false);
+  EXPECT_EQ(stats.created, 4);
+
+  stats = build(false, false);
+  EXPECT_EQ(stats.reused, 3);
+  EXPECT_EQ(stats.created, 0);
+  EXPECT_EQ(stats.destroyed, 1);
+  EXPECT_EQ(childAt(0)->Children()->size(), 1);
+
+  /* Different layout type, whole subtree has to be recreated. */
+  stats = build(false, true);
+  EXPECT_EQ(stats.reused, 1);
+  EXPECT_EQ(stats.created, 2);
+  EXPECT_EQ(stats.destroyed, 2);
+  EXPECT_EQ(screen_graph.Root().Children()->size(), 2);
+}
+
+TEST_F(ReconcilingBuilderTest, container_layout_change)
+{
+  auto build = [this](std::unique_ptr<bwLayoutInterface> layout) {
+    ReconcilingBuilder builder(screen_graph);
+    builder.buildContainer<bwPanel>(
+        [](ReconcilingBuilder& builder) { builder.addWidget<bwLabel>("a", "a"); },
+        "panel",
+        std::move(layout),
+        "Panel");
+    builder.finish();
+    return builder.getStatistics();
+  };
+
+  build(std::make_unique<DummyLayout>());
+  Node& panel_node = *childAt(0);
+  panel_node.Widget()->rectangle = {0, 100, 0, 100};
+  screen_graph.Root().Layout()->clearDirty();
+  panel_node.Layout()->clearDirty();
+  screen_graph.damage.clear();
+
+  /* The container is kept, only its layout is replaced. */
+  const ReconcilingBuilder::Statistics stats = build(std::make_unique<OtherDummyLayout>());
+  EXPECT_EQ(stats.reused, 2);
+  EXPECT_EQ(childAt(0), &panel_node);
+  EXPECT_EQ(typeid(*panel_node.Layout()), typeid(OtherDummyLayout));
+  EXPECT_TRUE(panel_node.Layout()->isDirty());
+  EXPECT_TRUE(screen_graph.Root().Layout()->isDirty());
+  EXPECT_FALSE(screen_graph.damage.isEmpty());
+}
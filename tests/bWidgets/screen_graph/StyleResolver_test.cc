@@ -0,0 +1,211 @@
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwLabel.h"
+#include "bwPanel.h"
+#include "bwStyle.h"
+#include "bwStyleManager.h"
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/Mutator.h"
+#include "screen_graph/StyleResolver.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+/** Counts the widgets it styles, and marks them by setting their width hint. */
+class CountingStyle : public bwStyle {
+ public:
+  CountingStyle(bool concurrent) : bwStyle(TypeID::CLASSIC), concurrent(concurrent)
+  {
+  }
+
+  void setWidgetStyle(bwWidget& widget) override
+  {
+    style_count++;
+    widget.width_hint = STYLED_WIDTH_HINT;
+  }
+  auto canSetWidgetStylesConcurrently() const -> bool override
+  {
+    return concurrent;
+  }
+  void prepareWidgetStyles(const std::vector<bwWidget*>& widgets) override
+  {
+    prepared_count += widgets.size();
+  }
+
+  static constexpr unsigned int STYLED_WIDTH_HINT = 1234;
+
+  const bool concurrent;
+  std::atomic<int> style_count{0};
+  std::size_t prepared_count{0};
+};
+
+/** Styles widgets depending on the state of their parent, like a `bwPanel:hover bwLabel` rule. */
+class ParentStateStyle : public bwStyle {
+ public:
+  ParentStateStyle() : bwStyle(TypeID::CLASSIC)
+  {
+  }
+
+  void setWidgetStyle(bwWidget& widget) override
+  {
+    const bwWidget* parent = widget.getParentWidget();
+    const bool is_parent_hovered = parent &&
+                                   (parent->getState() == bwWidget::State::HIGHLIGHTED);
+    widget.width_hint = is_parent_hovered ? HOVERED_PARENT_WIDTH_HINT : 0;
+  }
+
+  static constexpr unsigned int HOVERED_PARENT_WIDTH_HINT = 42;
+};
+
+class StyleResolverTest : public ::testing::Test {
+ protected:
+  ScreenGraph screen_graph;
+
+  StyleResolverTest() : screen_graph(std::make_unique<LayoutNode>())
+  {
+    Builder::setLayout(screen_graph.Root(),
+                       std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}));
+  }
+
+  auto addLabel(Builder& builder) -> bwLabel&
+  {
+    bwLabel& label = builder.addWidget<bwLabel>("Label");
+    label.rectangle = {0, 10, 0, 10};
+    return label;
+  }
+};
+
+TEST_F(StyleResolverTest, styles_changed_widgets_only)
+{
+  Builder builder(screen_graph);
+  bwLabel& label_a = addLabel(builder);
+  bwLabel& label_b = addLabel(builder);
+  CountingStyle style(false);
+
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 2);
+  EXPECT_EQ(label_a.width_hint, CountingStyle::STYLED_WIDTH_HINT);
+  EXPECT_EQ(label_b.width_hint, CountingStyle::STYLED_WIDTH_HINT);
+
+  /* Nothing changed. */
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 2);
+
+  label_a.setState(bwWidget::State::HIGHLIGHTED);
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 3);
+
+  label_b.invalidateStyle();
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 4);
+
+  bwStyleManager::getStyleManager().bumpStyleGeneration();
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 6);
+}
+
+TEST_F(StyleResolverTest, skips_widgets_not_drawn)
+{
+  Builder builder(screen_graph);
+  addLabel(builder).hide();
+  addLabel(builder).rectangle = {};
+  addLabel(builder);
+  CountingStyle style(false);
+
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 1);
+}
+
+TEST_F(StyleResolverTest, style_class_invalidates_descendants)
+{
+  Builder builder(screen_graph);
+  ContainerNode& panel_node = builder.addContainer<bwPanel>(
+      std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}), "Panel");
+  panel_node.Widget()->rectangle = {0, 100, 0, 100};
+  addLabel(builder);
+  addLabel(builder);
+  CountingStyle style(false);
+
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 3);
+
+  /* Style sheets may select the labels by the classes of the panel. */
+  panel_node.Widget()->addStyleClass("toolbar");
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, 6);
+}
+
+TEST_F(StyleResolverTest, parent_state_invalidates_descendants)
+{
+  Builder builder(screen_graph);
+  ContainerNode& panel_node = builder.addContainer<bwPanel>(
+      std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}), "Panel");
+  bwWidget& panel = *panel_node.Widget();
+  panel.rectangle = {0, 100, 0, 100};
+  bwLabel& label = addLabel(builder);
+  ParentStateStyle style;
+
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(label.width_hint, 0);
+
+  panel.setState(bwWidget::State::HIGHLIGHTED);
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(label.width_hint, ParentStateStyle::HOVERED_PARENT_WIDTH_HINT);
+
+  panel.setState(bwWidget::State::NORMAL);
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(label.width_hint, 0);
+}
+
+TEST_F(StyleResolverTest, reparenting_invalidates_subtree)
+{
+  Builder builder(screen_graph);
+  bwLabel& label = addLabel(builder);
+  Node& label_node = *screen_graph.Root().Children()->back();
+  ContainerNode& panel_node = builder.addContainer<bwPanel>(
+      std::make_unique<DummyLayout>(bwRectanglePixel{0, 100, 0, 100}), "Panel");
+  panel_node.Widget()->rectangle = {0, 100, 0, 100};
+  panel_node.Widget()->setState(bwWidget::State::HIGHLIGHTED);
+  Mutator mutator(screen_graph);
+  ParentStateStyle style;
+
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(label.width_hint, 0);
+
+  mutator.move(label_node, panel_node);
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(label.width_hint, ParentStateStyle::HOVERED_PARENT_WIDTH_HINT);
+
+  /* Inserting a removed node again. */
+  std::unique_ptr<Node> removed = mutator.remove(label_node);
+  mutator.append(screen_graph.Root(), std::move(removed));
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(label.width_hint, 0);
+}
+
+TEST_F(StyleResolverTest, concurrent)
+{
+  constexpr int label_count = 2000;
+  Builder builder(screen_graph);
+  for (int i = 0; i < label_count; i++) {
+    addLabel(builder);
+  }
+  CountingStyle style(true);
+
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.style_count, label_count);
+  EXPECT_EQ(style.prepared_count, label_count);
+  for (const auto& child : *screen_graph.Root().Children()) {
+    EXPECT_EQ(child->Widget()->width_hint, CountingStyle::STYLED_WIDTH_HINT);
+  }
+
+  /* Nothing to prepare if nothing changed. */
+  StyleResolver::resolve(screen_graph, style);
+  EXPECT_EQ(style.prepared_count, label_count);
+}
@@ -0,0 +1,186 @@
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwEvent.h"
+#include "bwLabel.h"
+#include "bwListView.h"
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/Iterators.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+class bwListViewTest : public ::testing::Test {
+ protected:
+  constexpr static unsigned int ROW_COUNT = 1000000;
+  constexpr static unsigned int ROW_HEIGHT = 10;
+  constexpr static int VIEW_SIZE = 100;
+
+  ScreenGraph screen_graph;
+  unsigned int bind_count{0};
+
+  bwListViewTest() : screen_graph(std::make_unique<ContainerNode>())
+  {
+    ContainerNode& node = static_cast<ContainerNode&>(screen_graph.Root());
+
+    Builder::setLayout(node, std::make_unique<DummyLayout>());
+    Builder::setWidget(node,
+                       std::make_unique<bwListView>(
+                           node,
+                           ROW_COUNT,
+                           ROW_HEIGHT,
+                           []() { return std::make_unique<bwLabel>(); },
+                           [this](bwWidget& row_widget, unsigned int row_index) {
+                             static_cast<bwLabel&>(row_widget).setLabel(
+                                 "Row " + std::to_string(row_index));
+                             bind_count++;
+                           }));
+    placeListView();
+  }
+
+  auto listView() -> bwListView&
+  {
+    return static_cast<bwListView&>(*screen_graph.Root().Widget());
+  }
+
+  /** Do what a layout would do to place the list view. */
+  void placeListView()
+  {
+    bwListView& list_view = listView();
+    auto& layout = static_cast<DummyLayout&>(*screen_graph.Root().Layout());
+
+    list_view.rectangle = bwRectanglePixel{0, VIEW_SIZE, 0, VIEW_SIZE};
+    layout.rect = bwRectanglePixel{
+        0, VIEW_SIZE - 10, VIEW_SIZE - list_view.getContentHeight(1.0f), VIEW_SIZE};
+    list_view.updateRows(1.0f);
+  }
+
+  void scrollDown(unsigned int steps)
+  {
+    screen_graph.event_dispatcher.dispatchMouseMovement(bwEvent({50, 50}));
+    for (unsigned int i = 0; i < steps; i++) {
+      bwMouseWheelEvent event{bwMouseWheelEvent::Direction::DOWN, {50, 50}};
+      screen_graph.event_dispatcher.dispatchMouseWheelScroll(event);
+    }
+    /* Finish the scroll animation. */
+    screen_graph.animator.advanceTo(screen_graph.animator.getTime() + std::chrono::seconds(1));
+  }
+
+  /** Labels of the rows that can be drawn or hovered, in order of their position. */
+  auto placedRowLabels() -> std::vector<std::string>
+  {
+    std::vector<std::pair<int, std::string>> rows;
+    for (const auto& child : *screen_graph.Root().Children()) {
+      if (!child->Rectangle().isEmpty()) {
+        rows.emplace_back(-child->Rectangle().ymax, *child->Widget()->getLabel());
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+
+    std::vector<std::string> labels;
+    for (const auto& row : rows) {
+      labels.push_back(row.second);
+    }
+    return labels;
+  }
+
+  auto hoveredLabel() -> std::string
+  {
+    const Node* hovered = screen_graph.context.hovered;
+    return (hovered && hovered->Widget()->getLabel()) ? *hovered->Widget()->getLabel() : "";
+  }
+};
+
+TEST_F(bwListViewTest, only_visible_rows_instantiated)
+{
+  /* 10 visible rows, 2 for partially visible ones and 2 * 2 overscan rows. */
+  EXPECT_EQ(screen_graph.Root().Children()->size(), 16);
+  /* The 10 visible rows and the overscan rows below. */
+  EXPECT_EQ(bind_count, 12);
+
+  const auto labels = placedRowLabels();
+  ASSERT_EQ(labels.size(), 12);
+  EXPECT_EQ(labels.front(), "Row 0");
+  EXPECT_EQ(labels.back(), "Row 11");
+}
+
+TEST_F(bwListViewTest, row_rectangles)
+{
+  for (const auto& child : *screen_graph.Root().Children()) {
+    const bwRectanglePixel rect = child->Rectangle();
+    if (rect.isEmpty()) {
+      continue;
+    }
+    const int row_index = std::stoi(child->Widget()->getLabel()->substr(4));
+
+    EXPECT_EQ(rect.xmin, 0);
+    EXPECT_EQ(rect.xmax, VIEW_SIZE - 10);
+    EXPECT_EQ(rect.ymax, VIEW_SIZE - row_index * int(ROW_HEIGHT));
+    EXPECT_EQ(rect.height(), ROW_HEIGHT);
+  }
+}
+
+TEST_F(bwListViewTest, scrolling_recycles_rows)
+{
+  bind_count = 0;
+
+  /* Scrolls by 4 rows. */
+  scrollDown(1);
+
+  EXPECT_EQ(screen_graph.Root().Children()->size(), 16);
+  /* Only the rows scrolled into view are bound. */
+  EXPECT_EQ(bind_count, 4);
+
+  const auto labels = placedRowLabels();
+  ASSERT_EQ(labels.size(), 14);
+  EXPECT_EQ(labels.front(), "Row 2");
+  EXPECT_EQ(labels.back(), "Row 15");
+}
+
+TEST_F(bwListViewTest, scrolled_hit_testing)
+{
+  screen_graph.event_dispatcher.dispatchMouseMovement(bwEvent({50, 55}));
+  EXPECT_EQ(hoveredLabel(), "Row 4");
+
+  scrollDown(1);
+  screen_graph.event_dispatcher.dispatchMouseMovement(bwEvent({50, 55}));
+  EXPECT_EQ(hoveredLabel(), "Row 8");
+}
+
+TEST_F(bwListViewTest, scroll_to_end)
+{
+  listView().setRowCount(25);
+  placeListView();
+
+  scrollDown(10);
+
+  const auto labels = placedRowLabels();
+  ASSERT_EQ(labels.size(), 12);
+  EXPECT_EQ(labels.front(), "Row 13");
+  EXPECT_EQ(labels.back(), "Row 24");
+}
+
+TEST_F(bwListViewTest, set_row_count_rebinds)
+{
+  bind_count = 0;
+  listView().setRowCount(5);
+  placeListView();
+
+  EXPECT_EQ(bind_count, 5);
+  EXPECT_EQ(placedRowLabels().size(), 5);
+}
+
+TEST_F(bwListViewTest, unused_rows_not_hovered)
+{
+  listView().setRowCount(5);
+  placeListView();
+
+  /* Below the rows, where the unused row widgets are collapsed to. */
+  screen_graph.event_dispatcher.dispatchMouseMovement(bwEvent({0, 0}));
+  EXPECT_EQ(screen_graph.context.hovered, &screen_graph.Root());
+}
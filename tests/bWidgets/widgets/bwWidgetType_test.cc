@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+
+#include "builtin_widgets.h"
+#include "screen_graph/Node.h"
+
+using namespace bWidgets;
+
+/** A widget type defined outside of bWidgets. */
+class CustomButton : public bwPushButton {
+ public:
+  CustomButton() : bwPushButton("Custom")
+  {
+  }
+
+  static auto staticType() -> const bwWidgetType&
+  {
+    static const bwWidgetType type{"CustomButton", &bwPushButton::staticType()};
+    return type;
+  }
+  auto getType() const -> const bwWidgetType& override
+  {
+    return staticType();
+  }
+};
+
+/** A widget type defined outside of bWidgets, that doesn't register its own type. */
+class UnregisteredLabel : public bwLabel {
+};
+
+TEST(bwWidgetType, widget_is)
+{
+  bwCheckbox checkbox;
+  bwNumberSlider slider;
+  bwScreenGraph::ContainerNode node;
+  bwScrollView scroll_view(node);
+
+  EXPECT_TRUE(widget_is<bwCheckbox>(checkbox));
+  EXPECT_TRUE(widget_is<bwAbstractButton>(checkbox));
+  EXPECT_TRUE(widget_is<bwWidget>(checkbox));
+  EXPECT_FALSE(widget_is<bwPushButton>(checkbox));
+  EXPECT_FALSE(widget_is<bwTextBox>(checkbox));
+
+  EXPECT_TRUE(widget_is<bwNumberSlider>(slider));
+  EXPECT_TRUE(widget_is<bwTextBox>(slider));
+  EXPECT_FALSE(widget_is<bwAbstractButton>(slider));
+
+  EXPECT_TRUE(widget_is<bwContainerWidget>(scroll_view));
+  EXPECT_FALSE(widget_is<bwListView>(scroll_view));
+  EXPECT_FALSE(widget_is<bwPanel>(scroll_view));
+}
+
+TEST(bwWidgetType, custom_types)
+{
+  CustomButton custom_button;
+  UnregisteredLabel unregistered_label;
+
+  EXPECT_TRUE(widget_is<CustomButton>(custom_button));
+  EXPECT_TRUE(widget_is<bwPushButton>(custom_button));
+  EXPECT_TRUE(widget_is<bwAbstractButton>(custom_button));
+  EXPECT_FALSE(widget_is<bwCheckbox>(custom_button));
+
+  /* Treated like its parent type. */
+  EXPECT_TRUE(widget_is<bwLabel>(unregistered_label));
+  EXPECT_EQ(&unregistered_label.getType(), &bwLabel::staticType());
+}
+
+TEST(bwWidgetType, unique_ids)
+{
+  EXPECT_NE(bwCheckbox::staticType().id, bwPushButton::staticType().id);
+  EXPECT_NE(bwCheckbox::staticType().id, bwAbstractButton::staticType().id);
+  EXPECT_LT(CustomButton::staticType().id, bwWidgetType::count());
+  EXPECT_EQ(bwPushButton::staticType().parent, &bwAbstractButton::staticType());
+}
+
+TEST(bwWidgetType, type_map_lookup)
+{
+  bwWidgetTypeMap<std::string> map;
+  map.add<bwAbstractButton>("button");
+  map.add<bwCheckbox>("checkbox");
+
+  EXPECT_EQ(*map.lookup(bwCheckbox::staticType()), "checkbox");
+  /* Falls back to the closest ancestor. */
+  EXPECT_EQ(*map.lookup(bwPushButton::staticType()), "button");
+  EXPECT_EQ(*map.lookup(CustomButton::staticType()), "button");
+  EXPECT_EQ(map.lookup(bwLabel::staticType()), nullptr);
+
+  /* Adding invalidates cached results. */
+  map.add<bwPushButton>("push button");
+  EXPECT_EQ(*map.lookup(CustomButton::staticType()), "push button");
+  EXPECT_EQ(*map.lookup(bwRadioButton::staticType()), "button");
+}
@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "builtin_widgets.h"
+#include "screen_graph/Builder.h"
+#include "screen_graph/ScreenGraph.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using TestUtilClasses::DummyLayout;
+
+TEST(bwWidget, style_classes)
+{
+  bwPushButton button("Button");
+
+  EXPECT_TRUE(button.getStyleClasses().empty());
+
+  button.addStyleClass("primary").addStyleClass("big").addStyleClass("primary");
+  EXPECT_EQ(button.getStyleClasses().size(), 2u);
+  EXPECT_TRUE(button.hasStyleClass(bwAtom("primary")));
+  EXPECT_TRUE(button.hasStyleClass(bwAtom("big")));
+  EXPECT_FALSE(button.hasStyleClass(bwAtom("small")));
+
+  button.removeStyleClass("primary").removeStyleClass("small");
+  EXPECT_EQ(button.getStyleClasses().size(), 1u);
+  EXPECT_FALSE(button.hasStyleClass(bwAtom("primary")));
+  EXPECT_TRUE(button.hasStyleClass(bwAtom("big")));
+}
+
+TEST(bwWidget, style_id)
+{
+  bwPushButton button("Button");
+
+  EXPECT_EQ(button.getStyleID(), bwAtom());
+  button.setStyleID("apply");
+  EXPECT_EQ(button.getStyleID(), bwAtom("apply"));
+  EXPECT_EQ(button.getStyleID().str(), "apply");
+}
+
+TEST(bwWidget, parent_widget_skips_layout_nodes)
+{
+  ScreenGraph screen_graph(std::make_unique<ContainerNode>());
+  auto& root_node = static_cast<ContainerNode&>(screen_graph.Root());
+  Builder::setWidget(root_node, std::make_unique<bwPanel>(root_node, "Panel"));
+
+  Builder builder(screen_graph);
+  LayoutNode& layout_node = builder.addLayout<DummyLayout>();
+  auto& label = Builder::emplaceWidget<bwLabel>(layout_node, "Label");
+  bwLabel unparented_label("Label");
+
+  EXPECT_EQ(label.getParentWidget(), root_node.Widget());
+  EXPECT_EQ(root_node.Widget()->getParentWidget(), nullptr);
+  EXPECT_EQ(unparented_label.getParentWidget(), nullptr);
+}
@@ -0,0 +1,151 @@
+/**
+ * Measure the cost of sending an event through deep chains of nested containers, with and
+ * without event listeners registered on each node. Also counts heap allocations made while
+ * registering listeners and dispatching, which are expected to be zero.
+ *
+ * Not run as part of the unit tests, timings depend too much on the machine.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include "bwContainerWidget.h"
+#include "bwEvent.h"
+#include "bwLayoutInterface.h"
+#include "screen_graph/Builder.h"
+#include "screen_graph/EventHandler.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+
+static unsigned long allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+  allocation_count++;
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace {
+
+constexpr int ITERATIONS = 100000;
+
+class FullLayout : public bwLayoutInterface {
+ public:
+  auto getRectangle() -> bwRectanglePixel override
+  {
+    return {0, 100, 0, 100};
+  }
+};
+
+/** Container covering the whole area, with a handler that doesn't do anything. */
+class ChainContainer : public bwContainerWidget {
+ public:
+  ChainContainer(const ContainerNode& node) : bwContainerWidget(node)
+  {
+    rectangle = {0, 100, 0, 100};
+  }
+
+  auto getTypeIdentifier() const -> bwAtom override
+  {
+    static const bwAtom identifier("ChainContainer");
+    return identifier;
+  }
+  void draw(bwStyle&) override
+  {
+  }
+  auto createHandler() -> std::unique_ptr<EventHandler> override
+  {
+    return std::make_unique<EventHandler>();
+  }
+};
+
+struct Result {
+  double ns_per_dispatch;
+  unsigned long registration_allocations;
+  unsigned long dispatch_allocations;
+};
+
+/**
+ * \param listeners_per_node: Number of listeners for the dispatched event type added to each
+ *                            node. The same number of listeners for another type is added too.
+ */
+auto measure(int depth, int listeners_per_node) -> Result
+{
+  ScreenGraph screen_graph(std::make_unique<LayoutNode>());
+  Builder::setLayout(screen_graph.Root(), std::make_unique<FullLayout>());
+
+  std::vector<ContainerNode*> chain;
+  Builder builder(screen_graph.Root());
+  for (int i = 0; i < depth; i++) {
+    chain.push_back(&builder.addContainer<ChainContainer>(std::make_unique<FullLayout>()));
+  }
+
+  long call_count = 0;
+
+  const unsigned long allocations_before_registration = allocation_count;
+  for (ContainerNode* node : chain) {
+    for (int i = 0; i < listeners_per_node; i++) {
+      node->eventHandler()->addEventListener(EventHandler::MOUSE_MOVE,
+                                             [&call_count](Node&, bwEvent&) { call_count++; });
+      node->eventHandler()->addEventListener(EventHandler::MOUSE_WHEEL,
+                                             [&call_count](Node&, bwEvent&) { call_count--; });
+    }
+  }
+  const unsigned long registration_allocations = allocation_count -
+                                                 allocations_before_registration;
+
+  /* Hover the innermost node, so following movements bubble through the whole chain. */
+  screen_graph.event_dispatcher.dispatchMouseMovement(bwEvent({50, 50}));
+
+  const unsigned long allocations_before_dispatch = allocation_count;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++) {
+    screen_graph.event_dispatcher.dispatchMouseMovement(bwEvent({50, float(50 + (i % 2))}));
+  }
+  const std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - start;
+  const unsigned long dispatch_allocations = allocation_count - allocations_before_dispatch;
+
+  if (call_count != long(ITERATIONS) * depth * listeners_per_node) {
+    std::cout << "Unexpected listener call count\n";
+  }
+
+  return {std::chrono::duration<double, std::nano>(duration).count() / ITERATIONS,
+          registration_allocations,
+          dispatch_allocations};
+}
+
+}  // namespace
+
+int main()
+{
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "depth  listeners/node  ns/dispatch  allocs (register)  allocs (dispatch)\n";
+
+  for (int depth : {8, 32, 128}) {
+    for (int listeners_per_node : {0, 1, 4}) {
+      const Result result = measure(depth, listeners_per_node);
+      std::cout << std::setw(5) << depth << std::setw(16) << listeners_per_node << std::setw(13)
+                << result.ns_per_dispatch << std::setw(19) << result.registration_allocations
+                << std::setw(19) << result.dispatch_allocations << "\n";
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,312 @@
+/**
+ * Headless replay of input event recordings (see \ref bwEventRecording), reporting the time
+ * spent on event dispatching, layout and drawing for each frame.
+ *
+ * Usage: `benchmark_bwidgets_event_replay [recording-file]`
+ *
+ * The demo writes recordings with `bWidgetsDemo --record <file>`. Since the demo stage needs
+ * OpenGL and fonts, the replay runs on a headless stand-in with similar content: panels with
+ * buttons, checkboxes, number sliders and text boxes in a scroll view, laid out with the demo's
+ * layout code and drawn with a paint engine that doesn't do anything. Without a file, a
+ * synthetic recording is generated: hovering across a panel, dragging a number slider, dragging
+ * the scroll bar and scrolling with the mouse wheel.
+ *
+ * Not run as part of the unit tests, timings depend too much on the machine.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "bwEventRecording.h"
+#include "bwPaintEngine.h"
+#include "bwPainter.h"
+#include "bwStyleManager.h"
+#include "builtin_widgets.h"
+#include "screen_graph/Builder.h"
+#include "screen_graph/Drawer.h"
+#include "screen_graph/Iterators.h"
+
+#include "Layout.h"
+
+using namespace bWidgets;
+using namespace bWidgetsDemo;
+
+namespace {
+
+constexpr int STAGE_WIDTH = 800;
+constexpr int STAGE_HEIGHT = 600;
+constexpr int PANEL_COUNT = 12;
+constexpr int PANEL_HEADER_HEIGHT = 24;
+/** Mouse movements per frame in the synthetic recording, e.g. a 1000 Hz mouse at 120 Hz. */
+constexpr int MOVES_PER_FRAME = 8;
+
+class NullPaintEngine : public bwPaintEngine {
+ public:
+  void setupViewport(const bwRectanglePixel&, const bwColor&) override
+  {
+  }
+  void enableMask(const bwRectanglePixel&) override
+  {
+  }
+  void drawPolygon(const bwPainter&, const bwPolygon&) override
+  {
+  }
+  void drawText(const bwPainter&,
+                const std::string&,
+                const bwRectanglePixel&,
+                const TextAlignment) override
+  {
+  }
+  void drawIcon(const bwPainter&, const bwIconInterface&, const bwRectanglePixel&) override
+  {
+  }
+};
+
+/** Headless stand-in for the demo stage. */
+class HeadlessStage {
+ public:
+  HeadlessStage() : screen_graph(createScreenGraph()), event_queue(screen_graph.event_dispatcher)
+  {
+    style = bwStyleManager::createStyleFromTypeID(bwStyle::TypeID::CLASSIC);
+    event_queue.resize_handler = [this](int new_width, int new_height) {
+      width = new_width;
+      height = new_height;
+    };
+
+    bwScreenGraph::Builder builder(screen_graph);
+    for (int i = 0; i < PANEL_COUNT; i++) {
+      builder.buildContainer<bwPanel>(
+          [](bwScreenGraph::Builder& builder) {
+            builder.buildLayout<ColumnLayout>(
+                [](bwScreenGraph::Builder& builder) {
+                  builder.addWidget<bwPushButton>("Translate");
+                  builder.addWidget<bwPushButton>("Rotate");
+                  builder.addWidget<bwPushButton>("Scale");
+                },
+                true);
+            builder.buildLayout<RowLayout>([](bwScreenGraph::Builder& builder) {
+              builder.addWidget<bwCheckbox>("Make Awesome");
+              builder.addWidget<bwCheckbox>("Wireframes");
+            });
+            builder.addWidget<bwNumberSlider>().setMinMax(0.0f, 100.0f).setValue(50.0f);
+            builder.addWidget<bwTextBox>().setText("Some Text...");
+          },
+          std::make_unique<PanelLayout>(),
+          "Panel " + std::to_string(i),
+          PANEL_HEADER_HEIGHT);
+    }
+  }
+
+  void layout()
+  {
+    const bwRectangle<float> stage_rect{0.0f, float(width), 0.0f, float(height)};
+    resolveScreenGraphNodeLayout(screen_graph.Root(), stage_rect, 1.0f);
+  }
+
+  void draw()
+  {
+    bwScreenGraph::Drawer::draw(screen_graph, *style);
+  }
+
+  /** Rectangle of the first widget of type \a _WidgetType, after layout. */
+  template<typename _WidgetType> auto findWidgetRect() -> bwRectanglePixel
+  {
+    for (bwScreenGraph::Node& node : screen_graph) {
+      if (node.Widget() && widget_is<_WidgetType>(*node.Widget())) {
+        return node.Rectangle();
+      }
+    }
+    return {};
+  }
+
+  bwScreenGraph::ScreenGraph screen_graph;
+  bwEventQueue event_queue;
+  std::unique_ptr<bwStyle> style;
+  int width{STAGE_WIDTH}, height{STAGE_HEIGHT};
+
+ private:
+  static auto createScreenGraph() -> bwScreenGraph::ScreenGraph
+  {
+    auto container = std::make_unique<bwScreenGraph::ContainerNode>();
+    auto layout = std::make_unique<ScrollViewLayout>();
+    auto scroll_view = std::make_unique<bwScrollView>(*container, STAGE_WIDTH, STAGE_HEIGHT);
+
+    layout->padding = 7;
+    layout->item_margin = 5;
+    bwScreenGraph::Builder::setLayout(*container, std::move(layout));
+    bwScreenGraph::Builder::setWidget(*container, std::move(scroll_view));
+
+    return bwScreenGraph::ScreenGraph(std::move(container));
+  }
+};
+
+/**
+ * Write the events straight to the recorder, so they are stored exactly like the demo stores
+ * them (without dispatching them).
+ */
+auto createSyntheticRecording(HeadlessStage& stage) -> std::string
+{
+  using EventType = bwEventQueue::EventType;
+  std::stringstream stream;
+  bwEventRecorder recorder(stream);
+
+  auto moveFrames = [&recorder](bwPoint from, bwPoint to, int frame_count) {
+    const int move_count = frame_count * MOVES_PER_FRAME;
+    for (int i = 1; i <= move_count; i++) {
+      const float fac = float(i) / move_count;
+      recorder.recordEvent(
+          {EventType::MOUSE_MOVE,
+           {from.x + (to.x - from.x) * fac, from.y + (to.y - from.y) * fac}});
+      if ((i % MOVES_PER_FRAME) == 0) {
+        recorder.recordFlush();
+      }
+    }
+  };
+  auto pressOrRelease = [&recorder](EventType type, bwPoint location) {
+    recorder.recordEvent({type, location, bwMouseButtonEvent::Button::LEFT});
+    recorder.recordFlush();
+  };
+
+  stage.layout();
+  const bwRectanglePixel panel_rect = stage.findWidgetRect<bwPanel>();
+  const bwRectanglePixel slider_rect = stage.findWidgetRect<bwNumberSlider>();
+  const bwPoint slider_center{float(slider_rect.centerX()), float(slider_rect.centerY())};
+  const bwPoint scrollbar_top{STAGE_WIDTH - 8.0f, STAGE_HEIGHT - 30.0f};
+
+  /* Hover across a panel, top to bottom. */
+  moveFrames({float(panel_rect.centerX()), float(panel_rect.ymax)},
+             {float(panel_rect.centerX()), float(panel_rect.ymin)},
+             120);
+
+  /* Drag a number slider. */
+  moveFrames({float(panel_rect.centerX()), float(panel_rect.ymin)}, slider_center, 10);
+  const bwPoint slider_right{slider_center.x + 200, slider_center.y};
+  const bwPoint slider_left{slider_center.x - 200, slider_center.y};
+  pressOrRelease(EventType::MOUSE_BUTTON_PRESS, slider_center);
+  moveFrames(slider_center, slider_right, 60);
+  moveFrames(slider_right, slider_left, 60);
+  pressOrRelease(EventType::MOUSE_BUTTON_RELEASE, slider_left);
+
+  /* Drag the scroll bar down. */
+  moveFrames(slider_left, scrollbar_top, 10);
+  pressOrRelease(EventType::MOUSE_BUTTON_PRESS, scrollbar_top);
+  moveFrames(scrollbar_top, {scrollbar_top.x, 30}, 120);
+  pressOrRelease(EventType::MOUSE_BUTTON_RELEASE, {scrollbar_top.x, 30});
+
+  /* Scroll back up with the mouse wheel. */
+  moveFrames({scrollbar_top.x, 30}, {STAGE_WIDTH / 2.0f, STAGE_HEIGHT / 2.0f}, 10);
+  for (int i = 0; i < 60; i++) {
+    recorder.recordEvent({EventType::MOUSE_WHEEL,
+                          {STAGE_WIDTH / 2.0f, STAGE_HEIGHT / 2.0f},
+                          bwMouseButtonEvent::Button::WHEEL,
+                          bwMouseWheelEvent::Direction::UP});
+    recorder.recordFlush();
+  }
+
+  return stream.str();
+}
+
+struct FrameTimings {
+  double dispatch, layout, draw;
+};
+
+auto microsecondsSince(std::chrono::steady_clock::time_point start) -> double
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  bwPainter::s_paint_engine = std::make_unique<NullPaintEngine>();
+  HeadlessStage stage;
+
+  std::string recording_data;
+  if (argc > 1) {
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+      std::cout << "Error: Could not open '" << argv[1] << "'\n";
+      return 1;
+    }
+    recording_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  else {
+    recording_data = createSyntheticRecording(stage);
+  }
+
+  std::istringstream stream(recording_data);
+  const std::optional<bwEventRecording> recording = bwEventRecording::read(stream);
+  if (!recording) {
+    std::cout << "Error: Invalid event recording\n";
+    return 1;
+  }
+
+  std::cout << "Replaying " << recording->frames.size() << " frames ("
+            << recording_data.size() << " bytes)\n\n";
+  std::cout << "frame  events  dispatch (us)  layout (us)  draw (us)\n";
+  std::cout << std::fixed << std::setprecision(1);
+
+  std::vector<FrameTimings> timings;
+  /* Animations run on the recorded time, so they behave the same on every replay. */
+  const bwAnimator::Clock::time_point replay_start = bwAnimator::Clock::now();
+  /* The demo skips drawing frames in which nothing changed, this always draws. */
+  unsigned int redraw_count = 0;
+  for (size_t i = 0; i < recording->frames.size(); i++) {
+    const bwEventRecording::Frame& frame = recording->frames[i];
+    FrameTimings frame_timings;
+
+    auto start = std::chrono::steady_clock::now();
+    stage.screen_graph.animator.advanceTo(replay_start + frame.flush_time);
+    bwEventRecording::replayFrame(frame, stage.event_queue);
+    frame_timings.dispatch = microsecondsSince(start);
+    if (stage.screen_graph.needsRedraw()) {
+      redraw_count++;
+    }
+
+    start = std::chrono::steady_clock::now();
+    stage.layout();
+    frame_timings.layout = microsecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    stage.draw();
+    frame_timings.draw = microsecondsSince(start);
+
+    timings.push_back(frame_timings);
+    std::cout << std::setw(5) << i << std::setw(8) << frame.events.size() << std::setw(15)
+              << frame_timings.dispatch << std::setw(13) << frame_timings.layout << std::setw(11)
+              << frame_timings.draw << "\n";
+  }
+
+  if (timings.empty()) {
+    return 0;
+  }
+
+  auto printSummary = [&timings](const char* name, double FrameTimings::*member) {
+    double total = 0.0, max = 0.0;
+    for (const FrameTimings& frame_timings : timings) {
+      total += frame_timings.*member;
+      max = std::max(max, frame_timings.*member);
+    }
+    std::cout << std::setw(10) << name << ": " << std::setw(10) << (total / timings.size())
+              << " us average, " << std::setw(10) << max << " us max\n";
+  };
+
+  std::cout << "\n";
+  printSummary("Dispatch", &FrameTimings::dispatch);
+  printSummary("Layout", &FrameTimings::layout);
+  printSummary("Draw", &FrameTimings::draw);
+
+  const bwEventQueue::Statistics& statistics = stage.event_queue.getStatistics();
+  std::cout << "\nEvents: " << statistics.totalRawCount() << " recorded, "
+            << statistics.totalDispatchedCount() << " dispatched after coalescing\n";
+  std::cout << "Frames that changed anything: " << redraw_count << " of " << timings.size()
+            << "\n";
+
+  return 0;
+}
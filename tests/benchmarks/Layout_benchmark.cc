@@ -0,0 +1,127 @@
+/**
+ * Measure how the demo layout calculation scales with the number of children in rows and
+ * columns. Prints the time per full layout calculation, which should grow linearly with the
+ * child count (constant time per child).
+ *
+ * Not run as part of the unit tests, timings depend too much on the machine.
+ */
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+#include "builtin_widgets.h"
+#include "screen_graph/Builder.h"
+#include "screen_graph/Iterators.h"
+#include "screen_graph/ScreenGraph.h"
+
+#include "Layout.h"
+
+using namespace bWidgets;
+using namespace bWidgetsDemo;
+
+namespace {
+
+constexpr int ITEM_WIDTH = 30;
+constexpr int STAGE_HEIGHT = 600;
+constexpr int ITERATIONS = 20;
+
+struct Scenario {
+  const char* name;
+  /** Add \a child_count children to the builder's active layout. */
+  std::function<void(bwScreenGraph::Builder&, int child_count)> build;
+  bool is_row;
+};
+
+auto createScreenGraph(int width) -> bwScreenGraph::ScreenGraph
+{
+  auto container = std::make_unique<bwScreenGraph::ContainerNode>();
+  auto layout = std::make_unique<ScrollViewLayout>();
+  auto scroll_view = std::make_unique<bwScrollView>(*container, width, STAGE_HEIGHT);
+
+  layout->padding = 7;
+  layout->item_margin = 5;
+  bwScreenGraph::Builder::setLayout(*container, std::move(layout));
+  bwScreenGraph::Builder::setWidget(*container, std::move(scroll_view));
+
+  return bwScreenGraph::ScreenGraph(std::move(container));
+}
+
+void addButtons(bwScreenGraph::Builder& builder, int child_count, int visible_count)
+{
+  for (int i = 0; i < child_count; i++) {
+    builder.addWidget<bwPushButton>("Button").hide(i >= visible_count);
+  }
+}
+
+/**
+ * \return The average time in microseconds for a full layout calculation.
+ */
+auto measure(const Scenario& scenario, int child_count) -> double
+{
+  /* Make rows wide enough for all children, so the layout isn't degenerate. */
+  const int width = scenario.is_row ? (child_count * (ITEM_WIDTH + 5)) : 400;
+  bwScreenGraph::ScreenGraph screen_graph = createScreenGraph(width);
+  bwScreenGraph::Builder builder(screen_graph);
+  const bwRectangle<float> stage_rect{0.0f, float(width), 0.0f, float(STAGE_HEIGHT)};
+
+  if (scenario.is_row) {
+    builder.addLayout<RowLayout>(true);
+  }
+  else {
+    builder.addLayout<ColumnLayout>(true);
+  }
+  scenario.build(builder, child_count);
+
+  std::chrono::nanoseconds total{0};
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    /* Force a full recalculation. */
+    for (bwScreenGraph::Node& node : screen_graph) {
+      if (bwLayoutInterface* layout = node.Layout()) {
+        layout->markDirty();
+      }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    resolveScreenGraphNodeLayout(screen_graph.Root(), stage_rect, 1.0f);
+    total += std::chrono::steady_clock::now() - start;
+  }
+
+  return std::chrono::duration<double, std::micro>(total).count() / ITERATIONS;
+}
+
+}  // namespace
+
+int main()
+{
+  const Scenario scenarios[] = {
+      {"Row, all visible",
+       [](bwScreenGraph::Builder& builder, int count) { addButtons(builder, count, count); },
+       true},
+      {"Row, trailing half hidden",
+       [](bwScreenGraph::Builder& builder, int count) { addButtons(builder, count, count / 2); },
+       true},
+      {"Column, all visible",
+       [](bwScreenGraph::Builder& builder, int count) { addButtons(builder, count, count); },
+       false},
+      {"Column, trailing half hidden",
+       [](bwScreenGraph::Builder& builder, int count) { addButtons(builder, count, count / 2); },
+       false},
+  };
+  const int child_counts[] = {1250, 2500, 5000, 10000};
+
+  std::cout << std::fixed << std::setprecision(3);
+
+  for (const Scenario& scenario : scenarios) {
+    std::cout << scenario.name << ":\n";
+    for (int child_count : child_counts) {
+      const double time = measure(scenario, child_count);
+      std::cout << "  " << std::setw(6) << child_count << " children: " << std::setw(10) << time
+                << " us (" << (time * 1000.0 / child_count) << " ns per child)\n";
+    }
+  }
+
+  return 0;
+}
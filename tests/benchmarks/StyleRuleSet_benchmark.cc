@@ -0,0 +1,124 @@
+/**
+ * Resolve style sheet values from a \ref bWidgetsDemo::StyleRuleSet with hundreds to thousands of
+ * rules. Prints the time per lookup for each size, once with atoms kept by the caller (how
+ * widgets do it) and once interning the names for each lookup.
+ *
+ * Rules are bucketed by their subject, so lookups should take about the same time whatever the
+ * number of rules.
+ *
+ * Not run as part of the unit tests, timings depend too much on the machine.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bwColor.h"
+
+#include "StyleRuleSet.h"
+#include "StyleSelector.h"
+
+using namespace bWidgets;
+using namespace bWidgetsDemo;
+
+namespace {
+
+constexpr int LOOKUP_COUNT = 200000;
+const char* PROPERTY_NAMES[] = {"color",
+                                "background-color",
+                                "border-color",
+                                "decoration-color",
+                                "border-radius",
+                                "shade-top"};
+constexpr int PROPERTY_COUNT = std::size(PROPERTY_NAMES);
+
+struct Lookup {
+  int type_index;
+  int property_index;
+};
+
+/** For each type, a rule setting all properties, and a `:hover` rule setting the background. */
+void fillRuleSet(StyleRuleSet& rule_set, const std::vector<bwAtom>& type_atoms)
+{
+  for (const bwAtom type : type_atoms) {
+    StyleSelector selector;
+    selector.addCompound({type, {}, {}, std::nullopt});
+    bwStyleProperties& declarations = rule_set.addRule(std::move(selector));
+    for (const char* property_name : PROPERTY_NAMES) {
+      declarations.addColor(property_name).setValue(bwColor(0.5f));
+    }
+
+    StyleSelector hover_selector;
+    hover_selector.addCompound({type, {}, {}, bwWidget::State::HIGHLIGHTED});
+    rule_set.addRule(std::move(hover_selector))
+        .addColor("background-color")
+        .setValue(bwColor(0.6f));
+  }
+}
+
+template<typename LookupFunc>
+auto measure(const std::vector<Lookup>& lookups, LookupFunc lookup_func) -> double
+{
+  int found_count = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (const Lookup& lookup : lookups) {
+    found_count += lookup_func(lookup) ? 1 : 0;
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  if (found_count != int(lookups.size())) {
+    std::cerr << "Lookup failed\n";
+  }
+  return std::chrono::duration<double, std::nano>(duration).count() / lookups.size();
+}
+
+}  // namespace
+
+int main()
+{
+  std::cout << std::fixed << std::setprecision(1);
+
+  for (int type_count : {100, 500, 2000}) {
+    StyleRuleSet rule_set;
+    std::vector<std::string> type_names;
+    std::vector<bwAtom> type_atoms;
+    std::vector<bwAtom> property_atoms;
+
+    for (int i = 0; i < type_count; i++) {
+      type_names.push_back("bwWidget" + std::to_string(i));
+      type_atoms.emplace_back(type_names.back());
+    }
+    for (const char* property_name : PROPERTY_NAMES) {
+      property_atoms.emplace_back(property_name);
+    }
+    fillRuleSet(rule_set, type_atoms);
+
+    std::mt19937 random(1);
+    std::vector<Lookup> lookups(LOOKUP_COUNT);
+    for (Lookup& lookup : lookups) {
+      lookup = {int(random() % type_count), int(random() % PROPERTY_COUNT)};
+    }
+
+    const double atom_time = measure(lookups, [&](const Lookup& lookup) {
+      return rule_set.resolveProperty(type_atoms[lookup.type_index],
+                                      property_atoms[lookup.property_index],
+                                      bwWidget::State::HIGHLIGHTED);
+    });
+    const double string_time = measure(lookups, [&](const Lookup& lookup) {
+      return rule_set.resolveProperty(bwAtom(type_names[lookup.type_index]),
+                                      bwAtom(PROPERTY_NAMES[lookup.property_index]),
+                                      bwWidget::State::HIGHLIGHTED);
+    });
+
+    std::cout << std::setw(5) << (type_count * 2) << " rules: " << std::setw(6) << atom_time
+              << " ns per lookup with atoms, " << std::setw(6) << string_time
+              << " ns interning the names\n";
+  }
+
+  return 0;
+}
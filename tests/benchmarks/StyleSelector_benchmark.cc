@@ -0,0 +1,310 @@
+/**
+ * Polish a screen-graph of nested panels with style sheets of hundreds to thousands of rules,
+ * using classes, IDs and descendant/child selectors. Compares matching every rule against every
+ * widget with the \ref bWidgetsDemo::CompiledStyleTable, which only checks the rules indexed for
+ * the widget, rejects most ancestor selectors with the \ref bWidgetsDemo::AncestorFilter and
+ * caches resolved values. Prints the time per widget for each.
+ *
+ * Not run as part of the unit tests, timings depend too much on the machine.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bwColor.h"
+#include "bwLayoutInterface.h"
+#include "builtin_widgets.h"
+#include "screen_graph/Builder.h"
+#include "screen_graph/Iterators.h"
+#include "screen_graph/ScreenGraph.h"
+
+#include "CompiledStyleTable.h"
+#include "StyleRuleSet.h"
+#include "StyleSelector.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using namespace bWidgetsDemo;
+
+namespace {
+
+constexpr int SECTION_COUNT = 50;
+constexpr int GROUPS_PER_SECTION = 10;
+constexpr int WIDGETS_PER_GROUP = 20;
+constexpr int ITERATIONS = 3;
+
+class DummyLayout : public bwLayoutInterface {
+ public:
+  auto getRectangle() -> bwRectanglePixel override
+  {
+    return {};
+  }
+};
+
+/** Sections (panels) containing groups (panels) containing buttons, checkboxes and labels. */
+auto createScreenGraph() -> std::unique_ptr<ScreenGraph>
+{
+  auto screen_graph = std::make_unique<ScreenGraph>(std::make_unique<LayoutNode>());
+  Builder::setLayout(static_cast<LayoutNode&>(screen_graph->Root()),
+                     std::make_unique<DummyLayout>());
+  Builder builder(*screen_graph);
+
+  for (int section = 0; section < SECTION_COUNT; section++) {
+    ContainerNode& section_node = builder.buildContainer<bwPanel>(
+        [section](Builder& builder) {
+          for (int group = 0; group < GROUPS_PER_SECTION; group++) {
+            ContainerNode& group_node = builder.buildContainer<bwPanel>(
+                [group](Builder& builder) {
+                  for (int i = 0; i < WIDGETS_PER_GROUP; i++) {
+                    bwWidget* widget;
+                    switch (i % 3) {
+                      case 0:
+                        widget = &builder.addWidget<bwPushButton>("Button");
+                        break;
+                      case 1:
+                        widget = &builder.addWidget<bwCheckbox>("Checkbox");
+                        break;
+                      default:
+                        widget = &builder.addWidget<bwLabel>("Label");
+                        break;
+                    }
+                    widget->addStyleClass("item" + std::to_string(i % 5));
+                    if (i == 0) {
+                      widget->setStyleID("first" + std::to_string(group));
+                    }
+                    widget->setState(bwWidget::State(i % int(bwWidget::State::STATE_TOT)));
+                  }
+                },
+                std::make_unique<DummyLayout>(),
+                "Group");
+            group_node.Widget()->addStyleClass("group");
+          }
+        },
+        std::make_unique<DummyLayout>(),
+        "Section");
+    section_node.Widget()->addStyleClass("section" + std::to_string(section));
+  }
+
+  return screen_graph;
+}
+
+auto addRule(StyleRuleSet& rule_set, std::vector<CompoundSelector> compounds_right_to_left)
+    -> bwStyleProperties&
+{
+  StyleSelector selector;
+  for (CompoundSelector& compound : compounds_right_to_left) {
+    selector.addCompound(std::move(compound));
+  }
+  return rule_set.addRule(std::move(selector));
+}
+
+auto compound(const char* type, std::vector<std::string> classes = {}) -> CompoundSelector
+{
+  CompoundSelector compound;
+  compound.type = bwAtom(type);
+  for (const std::string& class_name : classes) {
+    compound.classes.emplace_back(class_name);
+  }
+  return compound;
+}
+
+/**
+ * Base rules for each type, then a mix of class, ID and descendant rules. Most refer to
+ * sections, groups or items that don't exist, like rules for other parts of an application.
+ */
+auto createRuleSet(int rule_count) -> std::unique_ptr<StyleRuleSet>
+{
+  auto rule_set = std::make_unique<StyleRuleSet>();
+  const char* type_names[] = {"bwPushButton", "bwCheckbox", "bwLabel", "bwPanel"};
+
+  for (const char* type_name : type_names) {
+    bwStyleProperties& declarations = addRule(*rule_set, {compound(type_name)});
+    declarations.addColor("background-color").setValue(bwColor(0.5f));
+    declarations.addColor("color").setValue(bwColor(0.1f));
+    CompoundSelector hover = compound(type_name);
+    hover.state = bwWidget::State::HIGHLIGHTED;
+    addRule(*rule_set, {hover}).addColor("background-color").setValue(bwColor(0.6f));
+  }
+
+  for (int i = 0; i < rule_count; i++) {
+    const float value = float(i % 100) / 100.0f;
+    const std::string section_class = "section" + std::to_string(i % (SECTION_COUNT * 4));
+    const std::string item_class = "item" + std::to_string(i % 40);
+    const char* type_name = type_names[i % 3];
+
+    switch (i % 5) {
+      case 0: /* bwPushButton.item3 */
+        addRule(*rule_set, {compound(type_name, {item_class})})
+            .addColor("border-color")
+            .setValue(bwColor(value));
+        break;
+      case 1: { /* #first3 */
+        CompoundSelector id_compound;
+        id_compound.id = bwAtom("first" + std::to_string(i % 40));
+        addRule(*rule_set, {id_compound}).addColor("color").setValue(bwColor(value));
+        break;
+      }
+      case 2: /* .section3 bwCheckbox */
+        addRule(*rule_set, {compound(type_name), compound("", {section_class})})
+            .addColor("background-color")
+            .setValue(bwColor(value));
+        break;
+      case 3: /* .section3 .group .item2 */
+        addRule(
+            *rule_set,
+            {compound("", {item_class}), compound("", {"group"}), compound("", {section_class})})
+            .addColor("color")
+            .setValue(bwColor(value));
+        break;
+      case 4: { /* .section3 > bwPanel.group > bwLabel:hover */
+        CompoundSelector subject = compound(type_name);
+        subject.state = bwWidget::State::HIGHLIGHTED;
+        StyleSelector selector;
+        selector.addCompound(std::move(subject));
+        selector.addCompound(compound("bwPanel", {"group"}), StyleSelector::Combinator::CHILD);
+        selector.addCompound(compound("", {section_class}), StyleSelector::Combinator::CHILD);
+        rule_set->addRule(std::move(selector))
+            .addColor("border-color")
+            .setValue(bwColor(value));
+        break;
+      }
+    }
+  }
+
+  return rule_set;
+}
+
+/** The straightforward way: check every rule, the last matching one in cascade order declaring
+ * a property wins. */
+void polishByMatching(const std::vector<const StyleRule*>& rules_in_cascade_order,
+                      bwWidget& widget)
+{
+  std::vector<const StyleRule*> matching_rules;
+  for (const StyleRule* rule : rules_in_cascade_order) {
+    if (rule->selector.matches(widget)) {
+      matching_rules.push_back(rule);
+    }
+  }
+
+  for (auto& property : widget.style_properties) {
+    const bwStyleProperty* value = nullptr;
+    for (auto iter = matching_rules.rbegin(); !value && (iter != matching_rules.rend()); ++iter) {
+      value = (*iter)->declarations.lookup(property.getIdentifier());
+    }
+
+    if (value) {
+      property.setValue(*value);
+    }
+    else {
+      property.setValueToDefault();
+    }
+  }
+}
+
+/**
+ * \return The average time in nanoseconds per widget.
+ */
+auto measure(const std::vector<bwWidget*>& widgets, std::function<void(bwWidget&)> polish_func)
+    -> double
+{
+  std::chrono::nanoseconds total{0};
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    for (bwWidget* widget : widgets) {
+      polish_func(*widget);
+    }
+    total += std::chrono::steady_clock::now() - start;
+  }
+
+  return std::chrono::duration<double, std::nano>(total).count() / (ITERATIONS * widgets.size());
+}
+
+/** In drawing order, parents before their children. */
+auto collectWidgets(ScreenGraph& screen_graph) -> std::vector<bwWidget*>
+{
+  std::vector<bwWidget*> widgets;
+  for (Node& node : screen_graph.Root()) {
+    if (bwWidget* widget = node.Widget()) {
+      widgets.push_back(widget);
+    }
+  }
+  return widgets;
+}
+
+struct StyleValues {
+  bwColor background;
+  bwColor text;
+  bwColor border;
+};
+
+auto getStyleValues(const std::vector<bwWidget*>& widgets) -> std::vector<StyleValues>
+{
+  std::vector<StyleValues> values;
+  for (const bwWidget* widget : widgets) {
+    if (const auto* button = widget_cast<bwAbstractButton>(*widget)) {
+      values.push_back({button->base_style.backgroundColor(),
+                        button->base_style.textColor(),
+                        button->base_style.borderColor()});
+    }
+  }
+  return values;
+}
+
+auto valuesMatch(const std::vector<StyleValues>& a, const std::vector<StyleValues>& b) -> bool
+{
+  /* bwColor has no operator!=, it would compare the float pointers it converts to. */
+  return std::equal(
+      a.begin(), a.end(), b.begin(), b.end(), [](const StyleValues& a, const StyleValues& b) {
+        return (a.background == b.background) && (a.text == b.text) && (a.border == b.border);
+      });
+}
+
+}  // namespace
+
+int main()
+{
+  const std::unique_ptr<ScreenGraph> screen_graph = createScreenGraph();
+  const std::vector<bwWidget*> widgets = collectWidgets(*screen_graph);
+
+  std::cout << widgets.size() << " widgets\n";
+  std::cout << std::fixed << std::setprecision(1);
+
+  for (int rule_count : {100, 1000, 5000}) {
+    const std::unique_ptr<StyleRuleSet> rule_set = createRuleSet(rule_count);
+    std::vector<const StyleRule*> rules_in_cascade_order;
+    for (const auto& rule : rule_set->getRules()) {
+      rules_in_cascade_order.push_back(rule.get());
+    }
+    std::stable_sort(
+        rules_in_cascade_order.begin(),
+        rules_in_cascade_order.end(),
+        [](const StyleRule* a, const StyleRule* b) { return a->cascadesBefore(*b); });
+
+    const double matching_time = measure(widgets, [&rules_in_cascade_order](bwWidget& widget) {
+      polishByMatching(rules_in_cascade_order, widget);
+    });
+    const std::vector<StyleValues> matching_values = getStyleValues(widgets);
+
+    CompiledStyleTable compiled_table(*rule_set);
+    AncestorFilter ancestor_filter;
+    const double compiled_time = measure(widgets, [&](bwWidget& widget) {
+      ancestor_filter.prepareFor(widget);
+      compiled_table.polish(widget, ancestor_filter);
+    });
+    const std::vector<StyleValues> compiled_values = getStyleValues(widgets);
+
+    std::cout << std::setw(5) << rule_count << " rules: " << std::setw(9) << matching_time
+              << " ns per widget matching all rules, " << std::setw(6) << compiled_time
+              << " ns with the compiled style table, results "
+              << (valuesMatch(matching_values, compiled_values) ? "match" : "DIFFER") << "\n";
+  }
+
+  return 0;
+}
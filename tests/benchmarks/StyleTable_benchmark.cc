@@ -0,0 +1,222 @@
+/**
+ * Compare polishing widgets with style sheet values: matching all rules of the style sheet
+ * against each widget and resolving its properties from the matching ones, against applying the
+ * values precomputed in a \ref bWidgetsDemo::CompiledStyleTable. Prints the time per widget for
+ * each.
+ *
+ * The rules are built directly, rather than parsed from CSS, so the demo's CSS parser isn't
+ * needed. See StyleSelector_benchmark.cc for selectors with classes and ancestors.
+ *
+ * Not run as part of the unit tests, timings depend too much on the machine.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bwColor.h"
+#include "builtin_widgets.h"
+#include "screen_graph/Node.h"
+
+#include "CompiledStyleTable.h"
+#include "StyleRuleSet.h"
+#include "StyleSelector.h"
+
+using namespace bWidgets;
+using namespace bWidgetsDemo;
+
+namespace {
+
+constexpr int WIDGET_COUNT = 10000;
+constexpr int ITERATIONS = 50;
+/** Rules for types that don't exist, so the tree has a realistic size. */
+constexpr int UNUSED_RULE_COUNT = 200;
+
+/** Rule for `type_name` or `type_name:state`, to fill the declarations of. */
+auto addRule(StyleRuleSet& rule_set,
+             std::string_view type_name,
+             std::optional<bwWidget::State> state = std::nullopt) -> bwStyleProperties&
+{
+  StyleSelector selector;
+  selector.addCompound({bwAtom(type_name), {}, {}, state});
+  return rule_set.addRule(std::move(selector));
+}
+
+/** Like the shipped themes: all base style properties for NORMAL, some overridden on hover and
+ * press. */
+auto createRuleSet() -> std::unique_ptr<StyleRuleSet>
+{
+  auto rule_set = std::make_unique<StyleRuleSet>();
+  const char* type_names[] = {
+      "bwCheckbox", "bwPushButton", "bwLabel", "bwTextBox", "bwPanel", "bwScrollView"};
+
+  for (const char* type_name : type_names) {
+    bwStyleProperties& normal = addRule(*rule_set, type_name);
+    normal.addColor("color").setValue(bwColor(0.1f));
+    normal.addColor("background-color").setValue(bwColor(0.5f));
+    normal.addColor("border-color").setValue(bwColor(0.3f));
+    normal.addColor("decoration-color").setValue(bwColor(1.0f));
+    normal.addFloat("border-radius").setValue(3.0f);
+
+    addRule(*rule_set, type_name, bwWidget::State::HIGHLIGHTED)
+        .addColor("background-color")
+        .setValue(bwColor(0.6f));
+
+    bwStyleProperties& sunken = addRule(*rule_set, type_name, bwWidget::State::SUNKEN);
+    sunken.addColor("background-color").setValue(bwColor(0.2f));
+    sunken.addColor("color").setValue(bwColor(0.9f));
+  }
+
+  for (int i = 0; i < UNUSED_RULE_COUNT; i++) {
+    addRule(*rule_set, "UnusedType" + std::to_string(i))
+        .addColor("background-color")
+        .setValue(bwColor(0.0f));
+  }
+
+  return rule_set;
+}
+
+/** The straightforward way: check every rule, the last matching one in cascade order declaring
+ * a property wins. */
+void polishByMatching(const std::vector<const StyleRule*>& rules_in_cascade_order,
+                      bwWidget& widget)
+{
+  std::vector<const StyleRule*> matching_rules;
+  for (const StyleRule* rule : rules_in_cascade_order) {
+    if (rule->selector.matches(widget)) {
+      matching_rules.push_back(rule);
+    }
+  }
+
+  for (auto& property : widget.style_properties) {
+    const bwStyleProperty* value = nullptr;
+    for (auto iter = matching_rules.rbegin(); !value && (iter != matching_rules.rend()); ++iter) {
+      value = (*iter)->declarations.lookup(property.getIdentifier());
+    }
+
+    if (value) {
+      property.setValue(*value);
+    }
+    else {
+      property.setValueToDefault();
+    }
+  }
+}
+
+/**
+ * \return The average time in nanoseconds per widget.
+ */
+auto measure(std::vector<bwWidget*>& widgets, std::function<void(bwWidget&)> polish_func)
+    -> double
+{
+  std::chrono::nanoseconds total{0};
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    for (bwWidget* widget : widgets) {
+      polish_func(*widget);
+    }
+    total += std::chrono::steady_clock::now() - start;
+  }
+
+  return std::chrono::duration<double, std::nano>(total).count() / (ITERATIONS * widgets.size());
+}
+
+struct WidgetSet {
+  /* Containers need a node, keep them alive with their widgets. */
+  std::vector<std::unique_ptr<bwScreenGraph::ContainerNode>> container_nodes;
+  std::vector<std::unique_ptr<bwWidget>> widgets;
+  std::vector<bwWidget*> widget_ptrs;
+
+  WidgetSet()
+  {
+    for (int i = 0; i < WIDGET_COUNT; i++) {
+      switch (i % 6) {
+        case 0:
+          widgets.push_back(std::make_unique<bwCheckbox>());
+          break;
+        case 1:
+          widgets.push_back(std::make_unique<bwPushButton>("Button"));
+          break;
+        case 2:
+          widgets.push_back(std::make_unique<bwLabel>("Label"));
+          break;
+        case 3:
+          widgets.push_back(std::make_unique<bwTextBox>());
+          break;
+        case 4:
+          container_nodes.push_back(std::make_unique<bwScreenGraph::ContainerNode>());
+          widgets.push_back(std::make_unique<bwPanel>(*container_nodes.back(), "Panel"));
+          break;
+        case 5:
+          container_nodes.push_back(std::make_unique<bwScreenGraph::ContainerNode>());
+          widgets.push_back(std::make_unique<bwScrollView>(*container_nodes.back()));
+          break;
+      }
+      widgets.back()->setState(bwWidget::State(i % int(bwWidget::State::STATE_TOT)));
+      widget_ptrs.push_back(widgets.back().get());
+    }
+  }
+};
+
+auto resultsMatch(const WidgetSet& a, const WidgetSet& b) -> bool
+{
+  for (size_t i = 0; i < a.widgets.size(); i++) {
+    const bwAbstractButton* button_a = widget_cast<bwAbstractButton>(*a.widgets[i]);
+    const bwAbstractButton* button_b = widget_cast<bwAbstractButton>(*b.widgets[i]);
+    if (!button_a) {
+      continue;
+    }
+    /* bwColor has no operator!=, it would compare the float pointers it converts to. */
+    if (!(button_a->base_style.backgroundColor() == button_b->base_style.backgroundColor()) ||
+        !(button_a->base_style.textColor() == button_b->base_style.textColor()) ||
+        !(button_a->base_style.borderColor() == button_b->base_style.borderColor())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main()
+{
+  const std::unique_ptr<StyleRuleSet> rule_set = createRuleSet();
+  std::vector<const StyleRule*> rules_in_cascade_order;
+  for (const auto& rule : rule_set->getRules()) {
+    rules_in_cascade_order.push_back(rule.get());
+  }
+  std::stable_sort(rules_in_cascade_order.begin(),
+                   rules_in_cascade_order.end(),
+                   [](const StyleRule* a, const StyleRule* b) { return a->cascadesBefore(*b); });
+
+  CompiledStyleTable compiled_table(*rule_set);
+  AncestorFilter ancestor_filter;
+  WidgetSet by_matching_widgets;
+  WidgetSet compiled_widgets;
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "Match all rules:      " << std::setw(9)
+            << measure(by_matching_widgets.widget_ptrs,
+                       [&rules_in_cascade_order](bwWidget& widget) {
+                         polishByMatching(rules_in_cascade_order, widget);
+                       })
+            << " ns per widget\n";
+  std::cout << "Compiled style table: " << std::setw(9)
+            << measure(compiled_widgets.widget_ptrs,
+                       [&](bwWidget& widget) {
+                         ancestor_filter.prepareFor(widget);
+                         compiled_table.polish(widget, ancestor_filter);
+                       })
+            << " ns per widget\n";
+  const bool results_match = resultsMatch(by_matching_widgets, compiled_widgets);
+  std::cout << "Results match: " << (results_match ? "yes" : "NO") << "\n";
+
+  return 0;
+}
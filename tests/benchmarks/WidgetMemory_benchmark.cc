@@ -0,0 +1,108 @@
+/**
+ * Measure the memory used by widgets: their own size, plus everything they allocate on
+ * construction (mostly their style properties). Prints the bytes and heap allocations per widget
+ * for each widget type.
+ *
+ * Counts by replacing the global `operator new`/`operator delete`, so the numbers don't include
+ * the allocator's own bookkeeping.
+ */
+
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "builtin_widgets.h"
+#include "screen_graph/Node.h"
+
+using namespace bWidgets;
+
+namespace {
+
+constexpr int WIDGET_COUNT = 100000;
+
+std::size_t allocated_bytes = 0;
+std::size_t allocation_count = 0;
+
+}  // namespace
+
+auto operator new(std::size_t size) -> void*
+{
+  /* Store the size in front of the block, to know it when freeing. */
+  auto* block = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+  if (!block) {
+    throw std::bad_alloc();
+  }
+  *block = size;
+  allocated_bytes += size;
+  allocation_count++;
+  return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* pointer) noexcept
+{
+  if (!pointer) {
+    return;
+  }
+  auto* block = reinterpret_cast<std::size_t*>(static_cast<char*>(pointer) -
+                                               sizeof(std::max_align_t));
+  allocated_bytes -= *block;
+  std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  operator delete(pointer);
+}
+
+namespace {
+
+struct Measurement {
+  double bytes_per_widget;
+  double allocations_per_widget;
+};
+
+auto measure(const std::function<std::unique_ptr<bwWidget>()>& create_widget) -> Measurement
+{
+  std::vector<std::unique_ptr<bwWidget>> widgets;
+  widgets.reserve(WIDGET_COUNT);
+
+  const std::size_t bytes_before = allocated_bytes;
+  const std::size_t allocations_before = allocation_count;
+  for (int i = 0; i < WIDGET_COUNT; i++) {
+    widgets.push_back(create_widget());
+  }
+
+  return {double(allocated_bytes - bytes_before) / WIDGET_COUNT,
+          double(allocation_count - allocations_before) / WIDGET_COUNT};
+}
+
+void print(const char* name, const Measurement& measurement)
+{
+  std::cout << std::setw(16) << name << std::setw(10) << measurement.bytes_per_widget
+            << " bytes" << std::setw(8) << measurement.allocations_per_widget
+            << " allocations per widget\n";
+}
+
+}  // namespace
+
+int main()
+{
+  bwScreenGraph::ContainerNode node;
+
+  std::cout << std::fixed << std::setprecision(1);
+  print("bwCheckbox", measure([]() { return std::make_unique<bwCheckbox>(); }));
+  print("bwLabel", measure([]() { return std::make_unique<bwLabel>("Label"); }));
+  print("bwNumberSlider", measure([]() { return std::make_unique<bwNumberSlider>(); }));
+  print("bwPanel", measure([&node]() { return std::make_unique<bwPanel>(node, "Panel"); }));
+  print("bwPushButton", measure([]() { return std::make_unique<bwPushButton>("Button"); }));
+  print("bwRadioButton", measure([]() { return std::make_unique<bwRadioButton>("Radio"); }));
+  print("bwScrollBar", measure([]() { return std::make_unique<bwScrollBar>(); }));
+  print("bwScrollView", measure([&node]() { return std::make_unique<bwScrollView>(node); }));
+  print("bwTextBox", measure([]() { return std::make_unique<bwTextBox>(); }));
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * Compare the cost of finding the type specific code for a widget: the chain of
+ * `widget_cast<>()` (`dynamic_cast`) calls styles used to do, against \ref widget_is() and a
+ * \ref bwWidgetTypeMap lookup. Prints the time per widget for each.
+ *
+ * Not run as part of the unit tests, timings depend too much on the machine.
+ */
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "builtin_widgets.h"
+#include "screen_graph/Node.h"
+
+using namespace bWidgets;
+
+namespace {
+
+constexpr int WIDGET_COUNT = 100000;
+constexpr int ITERATIONS = 50;
+
+/** The order of checks bwStyleClassic used, most derived types first. */
+auto findWithDynamicCast(bwWidget& widget) -> int
+{
+  if (widget_cast<bwCheckbox>(widget)) {
+    return 1;
+  }
+  else if (widget_cast<bwNumberSlider>(widget)) {
+    return 2;
+  }
+  else if (widget_cast<bwPushButton>(widget)) {
+    return 3;
+  }
+  else if (widget_cast<bwRadioButton>(widget)) {
+    return 4;
+  }
+  else if (widget_cast<bwScrollBar>(widget)) {
+    return 5;
+  }
+  else if (widget_cast<bwTextBox>(widget)) {
+    return 6;
+  }
+  else if (widget_cast<bwPanel>(widget)) {
+    return 7;
+  }
+  else if (widget_cast<bwScrollView>(widget)) {
+    return 8;
+  }
+  return 0;
+}
+
+auto findWithWidgetIs(bwWidget& widget) -> int
+{
+  if (widget_is<bwCheckbox>(widget)) {
+    return 1;
+  }
+  else if (widget_is<bwNumberSlider>(widget)) {
+    return 2;
+  }
+  else if (widget_is<bwPushButton>(widget)) {
+    return 3;
+  }
+  else if (widget_is<bwRadioButton>(widget)) {
+    return 4;
+  }
+  else if (widget_is<bwScrollBar>(widget)) {
+    return 5;
+  }
+  else if (widget_is<bwTextBox>(widget)) {
+    return 6;
+  }
+  else if (widget_is<bwPanel>(widget)) {
+    return 7;
+  }
+  else if (widget_is<bwScrollView>(widget)) {
+    return 8;
+  }
+  return 0;
+}
+
+auto createTypeMap() -> bwWidgetTypeMap<int>
+{
+  bwWidgetTypeMap<int> map;
+  map.add<bwCheckbox>(1);
+  map.add<bwNumberSlider>(2);
+  map.add<bwPushButton>(3);
+  map.add<bwRadioButton>(4);
+  map.add<bwScrollBar>(5);
+  map.add<bwTextBox>(6);
+  map.add<bwPanel>(7);
+  map.add<bwScrollView>(8);
+  return map;
+}
+
+/**
+ * \return The average time in nanoseconds per widget.
+ */
+auto measure(std::vector<bwWidget*>& widgets, std::function<int(bwWidget&)> find_func) -> double
+{
+  std::chrono::nanoseconds total{0};
+  /* Use the result, so the compiler can't optimize the calls away. */
+  long checksum = 0;
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    for (bwWidget* widget : widgets) {
+      checksum += find_func(*widget);
+    }
+    total += std::chrono::steady_clock::now() - start;
+  }
+
+  if (checksum == 0) {
+    std::cout << "Unexpected checksum\n";
+  }
+
+  return std::chrono::duration<double, std::nano>(total).count() / (ITERATIONS * widgets.size());
+}
+
+}  // namespace
+
+int main()
+{
+  /* Containers need a node, keep them alive with their widgets. */
+  std::vector<std::unique_ptr<bwScreenGraph::ContainerNode>> container_nodes;
+  std::vector<std::unique_ptr<bwWidget>> widgets;
+
+  for (int i = 0; i < WIDGET_COUNT; i++) {
+    /* Mix of types, with types late in the check-chain (the worst case for it) included. */
+    switch (i % 6) {
+      case 0:
+        widgets.push_back(std::make_unique<bwCheckbox>());
+        break;
+      case 1:
+        widgets.push_back(std::make_unique<bwPushButton>("Button"));
+        break;
+      case 2:
+        widgets.push_back(std::make_unique<bwLabel>("Label"));
+        break;
+      case 3:
+        widgets.push_back(std::make_unique<bwTextBox>());
+        break;
+      case 4:
+        container_nodes.push_back(std::make_unique<bwScreenGraph::ContainerNode>());
+        widgets.push_back(std::make_unique<bwPanel>(*container_nodes.back(), "Panel"));
+        break;
+      case 5:
+        container_nodes.push_back(std::make_unique<bwScreenGraph::ContainerNode>());
+        widgets.push_back(std::make_unique<bwScrollView>(*container_nodes.back()));
+        break;
+    }
+  }
+
+  std::vector<bwWidget*> widget_ptrs;
+  for (auto& widget : widgets) {
+    widget_ptrs.push_back(widget.get());
+  }
+
+  const bwWidgetTypeMap<int> type_map = createTypeMap();
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "widget_cast<>() chain: " << std::setw(8)
+            << measure(widget_ptrs, findWithDynamicCast) << " ns per widget\n";
+  std::cout << "widget_is<>() chain:   " << std::setw(8) << measure(widget_ptrs, findWithWidgetIs)
+            << " ns per widget\n";
+  std::cout << "bwWidgetTypeMap:       " << std::setw(8)
+            << measure(widget_ptrs,
+                       [&type_map](bwWidget& widget) {
+                         const int* value = type_map.lookup(widget.getType());
+                         return value ? *value : 0;
+                       })
+            << " ns per widget\n";
+
+  return 0;
+}
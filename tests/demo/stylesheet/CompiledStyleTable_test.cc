@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "TestUtilClasses.h"
+
+#include "bwColor.h"
+#include "bwLabel.h"
+#include "bwPanel.h"
+#include "bwPushButton.h"
+
+#include "screen_graph/Builder.h"
+#include "screen_graph/Iterators.h"
+#include "screen_graph/ScreenGraph.h"
+
+#include "CompiledStyleTable.h"
+#include "StyleRuleSet.h"
+#include "StyleSelector.h"
+
+using namespace bWidgets;
+using namespace bWidgets::bwScreenGraph;
+using namespace bWidgetsDemo;
+using TestUtilClasses::DummyLayout;
+
+auto compound(const char* type, std::vector<std::string> classes = {}) -> CompoundSelector
+{
+  CompoundSelector compound;
+  compound.type = bwAtom(type);
+  for (const std::string& class_name : classes) {
+    compound.classes.emplace_back(class_name);
+  }
+  return compound;
+}
+
+auto idCompound(const char* id) -> CompoundSelector
+{
+  CompoundSelector compound;
+  compound.id = bwAtom(id);
+  return compound;
+}
+
+/**
+ * A toolbar panel containing a group panel, and a sidebar panel, each with some labels and
+ * buttons. Polished with a style sheet covering specificity, source order, child and descendant
+ * combinators and states of ancestors, once by matching every rule against every widget and once
+ * with the \ref CompiledStyleTable. Both must give the same values.
+ */
+class CompiledStyleTableTest : public ::testing::Test {
+ protected:
+  ScreenGraph screen_graph;
+  StyleRuleSet rule_set;
+
+  bwPanel* toolbar;
+  bwPanel* sidebar;
+  bwLabel* toolbar_label;
+  bwLabel* group_label;
+  bwPushButton* ok_button;
+  bwPushButton* plain_button;
+  bwPushButton* ab_button;
+  bwPushButton* ba_button;
+  bwPushButton* a_button;
+  bwPushButton* sidebar_button;
+
+  CompiledStyleTableTest() : screen_graph(std::make_unique<LayoutNode>())
+  {
+    buildScreenGraph();
+    buildRuleSet();
+  }
+
+  void buildScreenGraph()
+  {
+    Builder::setLayout(static_cast<LayoutNode&>(screen_graph.Root()),
+                       std::make_unique<DummyLayout>());
+    Builder builder(screen_graph);
+
+    ContainerNode& toolbar_node = builder.buildContainer<bwPanel>(
+        [this](Builder& builder) {
+          toolbar_label = &builder.addWidget<bwLabel>("Toolbar");
+          ok_button = &builder.addWidget<bwPushButton>("OK");
+          ok_button->addStyleClass("primary");
+          ok_button->setStyleID("ok");
+          plain_button = &builder.addWidget<bwPushButton>("Plain");
+
+          ContainerNode& group_node = builder.buildContainer<bwPanel>(
+              [this](Builder& builder) {
+                group_label = &builder.addWidget<bwLabel>("Group");
+                ab_button = &builder.addWidget<bwPushButton>("AB");
+                ab_button->addStyleClass("a");
+                ab_button->addStyleClass("b");
+                ba_button = &builder.addWidget<bwPushButton>("BA");
+                ba_button->addStyleClass("b");
+                ba_button->addStyleClass("a");
+                a_button = &builder.addWidget<bwPushButton>("A");
+                a_button->addStyleClass("a");
+              },
+              std::make_unique<DummyLayout>(),
+              "Group");
+          group_node.Widget()->addStyleClass("group");
+        },
+        std::make_unique<DummyLayout>(),
+        "Toolbar");
+    toolbar = static_cast<bwPanel*>(toolbar_node.Widget());
+    toolbar->addStyleClass("toolbar");
+    toolbar->setStyleID("main");
+
+    ContainerNode& sidebar_node = builder.buildContainer<bwPanel>(
+        [this](Builder& builder) {
+          sidebar_button = &builder.addWidget<bwPushButton>("Sidebar");
+        },
+        std::make_unique<DummyLayout>(),
+        "Sidebar");
+    sidebar = static_cast<bwPanel*>(sidebar_node.Widget());
+    sidebar->addStyleClass("sidebar");
+    sidebar->setState(bwWidget::State::HIGHLIGHTED);
+  }
+
+  auto addRule(std::vector<CompoundSelector> compounds_right_to_left,
+               StyleSelector::Combinator combinator = StyleSelector::Combinator::DESCENDANT)
+      -> bwStyleProperties&
+  {
+    StyleSelector selector;
+    for (CompoundSelector& compound : compounds_right_to_left) {
+      selector.addCompound(std::move(compound), combinator);
+    }
+    return rule_set.addRule(std::move(selector));
+  }
+
+  void buildRuleSet()
+  {
+    /* bwPushButton */
+    bwStyleProperties& button = addRule({compound("bwPushButton")});
+    button.addColor("background-color").setValue(bwColor(0.1f));
+    button.addColor("border-color").setValue(bwColor(0.1f));
+    /* #ok, comes first but is more specific than the next one. */
+    addRule({idCompound("ok")}).addColor("background-color").setValue(bwColor(0.3f));
+    /* bwPushButton.primary */
+    addRule({compound("bwPushButton", {"primary"})})
+        .addColor("background-color")
+        .setValue(bwColor(0.2f));
+    /* .a and .b, same specificity, so the one coming last wins. */
+    addRule({compound("", {"a"})}).addColor("background-color").setValue(bwColor(0.4f));
+    addRule({compound("", {"b"})}).addColor("background-color").setValue(bwColor(0.5f));
+    /* .toolbar bwLabel */
+    addRule({compound("bwLabel"), compound("", {"toolbar"})})
+        .addColor("color")
+        .setValue(bwColor(0.6f));
+    /* .toolbar > bwLabel */
+    addRule({compound("bwLabel"), compound("", {"toolbar"})}, StyleSelector::Combinator::CHILD)
+        .addColor("color")
+        .setValue(bwColor(0.7f));
+    /* bwPanel:hover bwPushButton */
+    CompoundSelector hovered_panel = compound("bwPanel");
+    hovered_panel.state = bwWidget::State::HIGHLIGHTED;
+    addRule({compound("bwPushButton"), hovered_panel})
+        .addColor("border-color")
+        .setValue(bwColor(0.8f));
+    /* #main > bwPushButton */
+    addRule({compound("bwPushButton"), idCompound("main")}, StyleSelector::Combinator::CHILD)
+        .addColor("color")
+        .setValue(bwColor(0.85f));
+    /* .missing bwPushButton, no ancestor has the class. */
+    addRule({compound("bwPushButton"), compound("", {"missing"})})
+        .addColor("color")
+        .setValue(bwColor(0.9f));
+  }
+
+  /** In drawing order, parents before their children. */
+  auto collectWidgets() -> std::vector<bwWidget*>
+  {
+    std::vector<bwWidget*> widgets;
+    for (Node& node : screen_graph.Root()) {
+      if (bwWidget* widget = node.Widget()) {
+        widgets.push_back(widget);
+      }
+    }
+    return widgets;
+  }
+
+  /** The straightforward way: the last matching rule in cascade order declaring a property
+   * wins. */
+  void polishByMatching()
+  {
+    std::vector<const StyleRule*> rules;
+    for (const auto& rule : rule_set.getRules()) {
+      rules.push_back(rule.get());
+    }
+    std::stable_sort(rules.begin(), rules.end(), [](const StyleRule* a, const StyleRule* b) {
+      return a->cascadesBefore(*b);
+    });
+
+    for (bwWidget* widget : collectWidgets()) {
+      for (auto& property : widget->style_properties) {
+        const bwStyleProperty* value = nullptr;
+        for (auto iter = rules.rbegin(); !value && (iter != rules.rend()); ++iter) {
+          if ((*iter)->selector.matches(*widget)) {
+            value = (*iter)->declarations.lookup(property.getIdentifier());
+          }
+        }
+
+        if (value) {
+          property.setValue(*value);
+        }
+        else {
+          property.setValueToDefault();
+        }
+      }
+    }
+  }
+
+  void polishCompiled(CompiledStyleTable& compiled_table)
+  {
+    AncestorFilter ancestor_filter;
+    for (bwWidget* widget : collectWidgets()) {
+      ancestor_filter.prepareFor(*widget);
+      compiled_table.polish(*widget, ancestor_filter);
+    }
+  }
+
+  /** The color properties of all widgets. Resets them, so the next polish has to set them. */
+  auto takeColors() -> std::vector<bwColor>
+  {
+    std::vector<bwColor> colors;
+    for (bwWidget* widget : collectWidgets()) {
+      for (auto& property : widget->style_properties) {
+        if (property.getType() == bwStyleProperty::Type::COLOR) {
+          colors.push_back(property.getValue<bwColor>());
+          property.setValue(bwColor(1.0f, 0.0f, 1.0f));
+        }
+      }
+    }
+    return colors;
+  }
+
+  void expectSameAsMatching(CompiledStyleTable& compiled_table)
+  {
+    polishByMatching();
+    const std::vector<bwColor> expected = takeColors();
+    polishCompiled(compiled_table);
+    const std::vector<bwColor> colors = takeColors();
+
+    ASSERT_EQ(colors.size(), expected.size());
+    for (std::size_t i = 0; i < colors.size(); i++) {
+      EXPECT_TRUE(colors[i] == expected[i]) << "Color property " << i;
+    }
+  }
+
+  static auto color(const bwWidget& widget, const char* property_name) -> bwColor
+  {
+    return widget.style_properties.lookup(property_name)->getValue<bwColor>();
+  }
+};
+
+TEST_F(CompiledStyleTableTest, matches_naive_polishing)
+{
+  CompiledStyleTable compiled_table(rule_set);
+
+  expectSameAsMatching(compiled_table);
+  /* Again, with the values cached now. */
+  expectSameAsMatching(compiled_table);
+}
+
+TEST_F(CompiledStyleTableTest, matches_naive_polishing_after_state_change)
+{
+  CompiledStyleTable compiled_table(rule_set);
+
+  expectSameAsMatching(compiled_table);
+  toolbar->setState(bwWidget::State::HIGHLIGHTED);
+  sidebar->setState(bwWidget::State::NORMAL);
+  expectSameAsMatching(compiled_table);
+}
+
+TEST_F(CompiledStyleTableTest, specificity_and_source_order)
+{
+  CompiledStyleTable compiled_table(rule_set);
+  polishCompiled(compiled_table);
+
+  EXPECT_TRUE(color(*ok_button, "background-color") == bwColor(0.3f));
+  EXPECT_TRUE(color(*plain_button, "background-color") == bwColor(0.1f));
+  EXPECT_TRUE(color(*a_button, "background-color") == bwColor(0.4f));
+  /* The order the classes were added in doesn't matter, the rule coming last does. */
+  EXPECT_TRUE(color(*ab_button, "background-color") == bwColor(0.5f));
+  EXPECT_TRUE(color(*ba_button, "background-color") == bwColor(0.5f));
+}
+
+TEST_F(CompiledStyleTableTest, child_and_descendant_combinators)
+{
+  CompiledStyleTable compiled_table(rule_set);
+  polishCompiled(compiled_table);
+
+  EXPECT_TRUE(color(*toolbar_label, "color") == bwColor(0.7f));
+  EXPECT_TRUE(color(*group_label, "color") == bwColor(0.6f));
+  EXPECT_TRUE(color(*plain_button, "color") == bwColor(0.85f));
+  EXPECT_FALSE(color(*a_button, "color") == bwColor(0.85f));
+  EXPECT_FALSE(color(*sidebar_button, "color") == bwColor(0.85f));
+}
+
+TEST_F(CompiledStyleTableTest, ancestor_state)
+{
+  CompiledStyleTable compiled_table(rule_set);
+  polishCompiled(compiled_table);
+
+  EXPECT_TRUE(color(*sidebar_button, "border-color") == bwColor(0.8f));
+  EXPECT_TRUE(color(*plain_button, "border-color") == bwColor(0.1f));
+
+  sidebar->setState(bwWidget::State::NORMAL);
+  polishCompiled(compiled_table);
+  EXPECT_TRUE(color(*sidebar_button, "border-color") == bwColor(0.1f));
+}
+
+TEST_F(CompiledStyleTableTest, ancestor_filter_rejection)
+{
+  StyleSelector missing_selector;
+  missing_selector.addCompound(compound("bwPushButton"));
+  missing_selector.addCompound(compound("", {"missing"}));
+  StyleSelector toolbar_selector;
+  toolbar_selector.addCompound(compound("bwPushButton"));
+  toolbar_selector.addCompound(compound("", {"group"}));
+  toolbar_selector.addCompound(compound("", {"toolbar"}));
+
+  AncestorFilter ancestor_filter;
+  ancestor_filter.prepareFor(*a_button);
+  EXPECT_FALSE(ancestor_filter.mayMatch(missing_selector));
+  EXPECT_TRUE(ancestor_filter.mayMatch(toolbar_selector));
+
+  ancestor_filter.prepareFor(*sidebar_button);
+  EXPECT_FALSE(ancestor_filter.mayMatch(missing_selector));
+  EXPECT_FALSE(ancestor_filter.mayMatch(toolbar_selector));
+}